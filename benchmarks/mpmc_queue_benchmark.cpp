@@ -0,0 +1,154 @@
+// 多生产者多消费者队列的吞吐量基准：比较互斥锁保护的queue与mpmc_queue
+//
+// 用法：mpmc_queue_benchmark [最大线程数] [每个生产者的元素数]
+// 生产者和消费者各占一半线程；batched一栏的双方都用try_push_n/try_pop_n每次搬运一批
+#include <sjkxq_stl/mpmc_queue.hpp>
+#include <sjkxq_stl/queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t queue_capacity = 1024;
+constexpr std::size_t batch_size     = 32;
+
+// 互斥锁加std::deque的基线，容量与mpmc_queue相同
+class locked_queue
+{
+public:
+  bool try_push(long value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() == queue_capacity) {
+      return false;
+    }
+    queue_.push(value);
+    return true;
+  }
+
+  bool try_pop(long& value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+private:
+  std::mutex              mutex_;
+  sjkxq_stl::queue<long> queue_;
+};
+
+// pairs个生产者各写入items个元素，pairs个消费者取完全部元素，返回耗时（秒）
+template <typename Queue, typename Produce, typename Consume>
+double run(unsigned pairs, long items, Produce produce, Consume consume)
+{
+  Queue                    q;
+  std::atomic<long>        remaining{static_cast<long>(pairs) * items};
+  std::vector<std::thread> workers;
+  auto                     start = std::chrono::steady_clock::now();
+  for (unsigned t = 0; t < pairs; ++t) {
+    workers.emplace_back([&q, &produce, items]() { produce(q, items); });
+    workers.emplace_back([&q, &consume, &remaining]() { consume(q, remaining); });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct bounded_mpmc : sjkxq_stl::mpmc_queue<long> {
+  bounded_mpmc() : sjkxq_stl::mpmc_queue<long>(queue_capacity) {}
+};
+
+template <typename Queue>
+void produce_single(Queue& q, long items)
+{
+  for (long i = 0; i < items;) {
+    if (q.try_push(i)) {
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename Queue>
+void consume_single(Queue& q, std::atomic<long>& remaining)
+{
+  long value;
+  while (remaining.load(std::memory_order_relaxed) > 0) {
+    if (q.try_pop(value)) {
+      remaining.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void produce_batched(bounded_mpmc& q, long items)
+{
+  long values[batch_size];
+  for (long i = 0; i < items;) {
+    const std::size_t n = static_cast<std::size_t>(std::min<long>(batch_size, items - i));
+    for (std::size_t k = 0; k < n; ++k) {
+      values[k] = i + static_cast<long>(k);
+    }
+    const std::size_t pushed = q.try_push_n(values, n);
+    if (pushed == 0) {
+      std::this_thread::yield();
+    }
+    i += static_cast<long>(pushed);
+  }
+}
+
+void consume_batched(bounded_mpmc& q, std::atomic<long>& remaining)
+{
+  long values[batch_size];
+  while (remaining.load(std::memory_order_relaxed) > 0) {
+    const std::size_t popped = q.try_pop_n(values, batch_size);
+    if (popped > 0) {
+      remaining.fetch_sub(static_cast<long>(popped), std::memory_order_relaxed);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// 每秒通过队列的元素数（百万）
+double mops(unsigned pairs, long items, double seconds)
+{
+  return static_cast<double>(pairs) * items / seconds / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const unsigned hardware    = std::thread::hardware_concurrency();
+  const unsigned max_threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : (hardware > 0 ? hardware : 4);
+  const long     items       = argc > 2 ? std::atol(argv[2]) : 1000000;
+
+  std::printf("%8s %16s %16s %16s\n", "threads", "locked", "mpmc", "mpmc batched");
+  for (unsigned threads = 2; threads <= std::max(max_threads, 2u); threads *= 2) {
+    const unsigned pairs = threads / 2;
+    std::printf("%8u %16.1f %16.1f %16.1f\n", threads,
+                mops(pairs, items, run<locked_queue>(pairs, items, produce_single<locked_queue>,
+                                                     consume_single<locked_queue>)),
+                mops(pairs, items, run<bounded_mpmc>(pairs, items, produce_single<bounded_mpmc>,
+                                                     consume_single<bounded_mpmc>)),
+                mops(pairs, items, run<bounded_mpmc>(pairs, items, produce_batched, consume_batched)));
+  }
+  std::printf("(million elements through the queue per second)\n");
+  return 0;
+}
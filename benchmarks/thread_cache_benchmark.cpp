@@ -0,0 +1,133 @@
+// 节点分配的多线程扩展性基准：比较std::allocator与thread_cache_allocator
+//
+// 用法：thread_cache_benchmark [最大线程数] [每个线程的轮数]
+// local   每个线程反复构造并清空自己的list，分配和释放在同一线程
+// handoff 线程两两配对，生产者构造list交给消费者析构，节点总在另一个线程释放
+#include <sjkxq_stl/list.hpp>
+#include <sjkxq_stl/thread_cache_allocator.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr int nodes_per_list = 256;
+
+template <typename Allocator>
+using bench_list = sjkxq_stl::list<long, Allocator>;
+
+// 在threads个线程上同时运行body(线程编号)，返回耗时（秒）
+template <typename Body>
+double run_threads(unsigned threads, Body body)
+{
+  std::vector<std::thread> workers;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back(body, t);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Allocator>
+double local_churn(unsigned threads, int rounds)
+{
+  return run_threads(threads, [rounds](unsigned) {
+    bench_list<Allocator> lst;
+    for (int r = 0; r < rounds; ++r) {
+      for (int i = 0; i < nodes_per_list; ++i) {
+        lst.push_back(i);
+      }
+      lst.clear();
+    }
+  });
+}
+
+// 单槽交接通道：生产者放入一个list，消费者取走
+template <typename Allocator>
+struct channel
+{
+  std::mutex              mutex;
+  std::condition_variable cv;
+  bench_list<Allocator>   slot;
+  bool                    full = false;
+  bool                    done = false;
+};
+
+template <typename Allocator>
+double handoff(unsigned threads, int rounds)
+{
+  const unsigned pairs = threads / 2 > 0 ? threads / 2 : 1;
+  std::vector<channel<Allocator>> channels(pairs);
+  return run_threads(pairs * 2, [&channels, rounds](unsigned t) {
+    channel<Allocator>& ch = channels[t / 2];
+    if (t % 2 == 0) {
+      for (int r = 0; r < rounds; ++r) {
+        bench_list<Allocator> lst;
+        for (int i = 0; i < nodes_per_list; ++i) {
+          lst.push_back(i);
+        }
+        std::unique_lock<std::mutex> lock(ch.mutex);
+        ch.cv.wait(lock, [&ch]() { return !ch.full; });
+        ch.slot = std::move(lst);
+        ch.full = true;
+        ch.cv.notify_all();
+      }
+      std::lock_guard<std::mutex> lock(ch.mutex);
+      ch.done = true;
+      ch.cv.notify_all();
+    } else {
+      for (;;) {
+        bench_list<Allocator> lst;
+        {
+          std::unique_lock<std::mutex> lock(ch.mutex);
+          ch.cv.wait(lock, [&ch]() { return ch.full || ch.done; });
+          if (!ch.full) {
+            return;
+          }
+          lst     = std::move(ch.slot);
+          ch.full = false;
+          ch.cv.notify_all();
+        }
+        // 离开作用域时在消费者线程上释放全部节点
+      }
+    }
+  });
+}
+
+// 每秒完成的节点分配+释放次数（百万）
+double mops(unsigned threads, int rounds, double seconds)
+{
+  return static_cast<double>(threads) * rounds * nodes_per_list / seconds / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const unsigned hardware   = std::thread::hardware_concurrency();
+  const unsigned max_threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : (hardware > 0 ? hardware : 4);
+  const int      rounds      = argc > 2 ? std::atoi(argv[2]) : 20000;
+
+  using std_alloc    = std::allocator<long>;
+  using cached_alloc = sjkxq_stl::thread_cache_allocator<long>;
+
+  std::printf("%8s %16s %16s %16s %16s\n", "threads", "local std", "local cached", "handoff std", "handoff cached");
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    const unsigned paired = threads < 2 ? 2 : threads;
+    std::printf("%8u %16.1f %16.1f %16.1f %16.1f\n", threads,
+                mops(threads, rounds, local_churn<std_alloc>(threads, rounds)),
+                mops(threads, rounds, local_churn<cached_alloc>(threads, rounds)),
+                mops(paired / 2, rounds, handoff<std_alloc>(paired, rounds)),
+                mops(paired / 2, rounds, handoff<cached_alloc>(paired, rounds)));
+  }
+  std::printf("(million node allocate+free per second)\n");
+  return 0;
+}
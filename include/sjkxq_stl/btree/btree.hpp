@@ -0,0 +1,1153 @@
+#ifndef SJKXQ_STL_BTREE_HPP
+#define SJKXQ_STL_BTREE_HPP
+
+#include "../common.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief B树核心
+ *
+ * 每个节点连续存放多个有序元素，节点大小约为256字节（4条缓存行），
+ * 节点内用二分查找定位，树高通常只有3~4层。叶子节点不保存子节点指针，
+ * 平均每个元素的额外开销远小于红黑树的三个指针。
+ *
+ * Policy 描述元素类型以及如何从元素中取出键，btree_map 和 btree_set 共用此核心，键唯一。
+ * 元素直接存放在节点中，插入和删除会在节点内或节点间移动元素，
+ * 因此任何插入和删除都可能使其他元素的迭代器、指针和引用失效。
+ * 元素存放在 Policy::slot_type 中，搬迁时经由 Policy::mutable_element 移动（btree_map 的键不是const），
+ * 搬迁不会复制元素；搬迁中途无法回滚，元素的移动构造抛出异常时调用 std::terminate。
+ */
+template <typename Policy, typename Compare, typename Allocator>
+class btree
+{
+public:
+  // 类型定义
+  using key_type        = typename Policy::key_type;
+  using value_type      = typename Policy::value_type;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare     = Compare;
+  using allocator_type  = Allocator;
+  using reference       = value_type&;
+  using const_reference = const value_type&;
+  using pointer         = value_type*;
+  using const_pointer   = const value_type*;
+
+private:
+  using slot_type      = typename Policy::slot_type;
+  using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+  using slot_traits    = std::allocator_traits<slot_allocator>;
+
+  static constexpr size_type target_node_size = 256;
+  static constexpr size_type node_header_size = sizeof(void*) + 4;  // 父指针、位置、数量、叶子标记
+
+  // 每个节点的元素数：按目标节点大小计算，至少3个（分裂时两侧都不为空），至多255个（数量用一个字节保存）
+  static constexpr size_type node_slots = std::min<size_type>(
+      255, std::max<size_type>(3, (target_node_size - node_header_size) / sizeof(slot_type)));
+
+  // 非根节点的最少元素数，删除后低于此值时与兄弟节点合并或借用元素
+  static constexpr int min_node_values = static_cast<int>(node_slots / 2);
+
+  struct node {
+    node*        parent;    // 根节点为空
+    std::uint8_t position;  // 在父节点子节点数组中的下标
+    std::uint8_t count;     // 元素数量
+    bool         leaf;
+    alignas(slot_type) unsigned char storage[node_slots * sizeof(slot_type)];
+  };
+
+  // 内部节点在叶子节点之后追加 count + 1 个子节点指针
+  struct internal_node : node {
+    node* children[node_slots + 1];
+  };
+
+  using leaf_allocator     = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+  using leaf_traits        = std::allocator_traits<leaf_allocator>;
+  using internal_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<internal_node>;
+  using internal_traits    = std::allocator_traits<internal_allocator>;
+
+  static slot_type* slot(node* n, int i) noexcept
+  {
+    return std::launder(reinterpret_cast<slot_type*>(n->storage)) + i;
+  }
+
+  static value_type* element(node* n, int i) noexcept { return std::addressof(Policy::element(*slot(n, i))); }
+
+  static const key_type& key(node* n, int i) noexcept { return Policy::key(*element(n, i)); }
+
+  static node* child(node* n, int i) noexcept { return static_cast<internal_node*>(n)->children[i]; }
+
+  static void set_child(node* n, int i, node* c) noexcept
+  {
+    static_cast<internal_node*>(n)->children[i] = c;
+    c->parent                                   = n;
+    c->position                                 = static_cast<std::uint8_t>(i);
+  }
+
+  // 迭代器：指向（节点，节点内下标），end()为最右叶子节点的末尾
+  template <bool Const>
+  class basic_iterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = typename btree::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer   = std::conditional_t<Const || Policy::constant_values, const value_type*, value_type*>;
+    using reference = std::conditional_t<Const || Policy::constant_values, const value_type&, value_type&>;
+
+    basic_iterator() noexcept : node_(nullptr), position_(0) {}
+
+    // 允许 iterator 隐式转换为 const_iterator
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    basic_iterator(const basic_iterator<false>& other) noexcept
+        : node_(other.node_), position_(other.position_)
+    {
+    }
+
+    reference operator*() const { return *element(node_, position_); }
+    pointer   operator->() const { return element(node_, position_); }
+
+    // 叶子节点内前进只需递增下标，只有跨节点时才走慢路径
+    basic_iterator& operator++()
+    {
+      if (node_->leaf && ++position_ < node_->count) {
+        return *this;
+      }
+      increment_slow();
+      return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+      basic_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    basic_iterator& operator--()
+    {
+      if (node_->leaf && --position_ >= 0) {
+        return *this;
+      }
+      decrement_slow();
+      return *this;
+    }
+
+    basic_iterator operator--(int)
+    {
+      basic_iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+    {
+      return lhs.node_ == rhs.node_ && lhs.position_ == rhs.position_;
+    }
+
+    friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend class btree;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(node* n, int position) noexcept : node_(n), position_(position) {}
+
+    void increment_slow() noexcept
+    {
+      if (node_->leaf) {
+        // 已越过叶子节点末尾，向上找到第一个还有后续元素的祖先
+        node* save_node     = node_;
+        int   save_position = position_;
+        while (position_ == node_->count && node_->parent) {
+          position_ = node_->position;
+          node_     = node_->parent;
+        }
+        if (position_ == node_->count) {
+          node_     = save_node;  // 越过最后一个元素，停在end()
+          position_ = save_position;
+        }
+      } else {
+        // 内部节点的后继是右侧子树的最小元素
+        node_ = child(node_, position_ + 1);
+        while (!node_->leaf) {
+          node_ = child(node_, 0);
+        }
+        position_ = 0;
+      }
+    }
+
+    void decrement_slow() noexcept
+    {
+      if (node_->leaf) {
+        node* save_node     = node_;
+        int   save_position = position_;
+        while (position_ < 0 && node_->parent) {
+          position_ = node_->position - 1;
+          node_     = node_->parent;
+        }
+        if (position_ < 0) {
+          node_     = save_node;
+          position_ = save_position;
+        }
+      } else {
+        // 内部节点的前驱是左侧子树的最大元素
+        node_ = child(node_, position_);
+        while (!node_->leaf) {
+          node_ = child(node_, node_->count);
+        }
+        position_ = node_->count - 1;
+      }
+    }
+
+    node* node_;
+    int   position_;
+  };
+
+public:
+  using iterator               = basic_iterator<false>;
+  using const_iterator         = basic_iterator<true>;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+  // 基本成员变量
+  node*          root_;
+  node*          leftmost_;   // 最左叶子节点，begin()所在
+  node*          rightmost_;  // 最右叶子节点，end()所在
+  size_type      size_;
+  Compare        comp_;
+  slot_allocator alloc_;
+
+  // 在栈上用分配器构造的临时元素，用于emplace时先取得键；插入时从可变形式移出，不复制键
+  class value_holder
+  {
+  public:
+    template <typename... Args>
+    explicit value_holder(slot_allocator& alloc, Args&&... args) : alloc_(alloc)
+    {
+      slot_traits::construct(alloc_, std::addressof(get()), std::forward<Args>(args)...);
+    }
+
+    value_holder(const value_holder&)            = delete;
+    value_holder& operator=(const value_holder&) = delete;
+
+    ~value_holder() { slot_traits::destroy(alloc_, std::addressof(get())); }
+
+    value_type& get() noexcept { return Policy::element(slot_); }
+
+    auto&& release() noexcept { return std::move(Policy::mutable_element(slot_)); }
+
+  private:
+    slot_allocator& alloc_;
+    slot_type       slot_;
+  };
+
+  node* allocate_node(bool leaf)
+  {
+    node* n;
+    if (leaf) {
+      leaf_allocator a(alloc_);
+      n = ::new (static_cast<void*>(leaf_traits::allocate(a, 1))) node;
+    } else {
+      internal_allocator a(alloc_);
+      n = ::new (static_cast<void*>(internal_traits::allocate(a, 1))) internal_node;
+    }
+    n->parent   = nullptr;
+    n->position = 0;
+    n->count    = 0;
+    n->leaf     = leaf;
+    return n;
+  }
+
+  void deallocate_node(node* n) noexcept
+  {
+    if (n->leaf) {
+      leaf_allocator a(alloc_);
+      leaf_traits::deallocate(a, n, 1);
+    } else {
+      internal_allocator a(alloc_);
+      internal_traits::deallocate(a, static_cast<internal_node*>(n), 1);
+    }
+  }
+
+  // 销毁以n为根的子树中的所有元素和节点
+  void destroy_subtree(node* n) noexcept
+  {
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+      for (int i = 0; i < n->count; ++i) {
+        slot_traits::destroy(alloc_, element(n, i));
+      }
+    }
+    if (!n->leaf) {
+      for (int i = 0; i <= n->count; ++i) {
+        destroy_subtree(child(n, i));
+      }
+    }
+    deallocate_node(n);
+  }
+
+  // 移动构造dst处的元素并销毁src处的元素，经由可变形式移动，键不会被复制
+  void transfer(slot_type* dst, slot_type* src) noexcept
+  {
+    slot_traits::construct(alloc_,
+                           std::addressof(Policy::mutable_element(*dst)),
+                           std::move(Policy::mutable_element(*src)));
+    slot_traits::destroy(alloc_, std::addressof(Policy::mutable_element(*src)));
+  }
+
+  // 把src开始的count个元素搬到dst，区间可以重叠；搬迁后源位置视为未构造
+  void relocate(slot_type* dst, slot_type* src, int count) noexcept
+  {
+    if (count <= 0 || dst == src) {
+      return;
+    }
+    if constexpr (is_trivially_relocatable<value_type>::value) {
+      std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(slot_type));
+    } else if (dst < src) {
+      for (int i = 0; i < count; ++i) {
+        transfer(dst + i, src + i);
+      }
+    } else {
+      for (int i = count - 1; i >= 0; --i) {
+        transfer(dst + i, src + i);
+      }
+    }
+  }
+
+  // 节点内第一个不小于k的下标
+  template <typename K>
+  int lower_bound_in_node(node* n, const K& k) const
+  {
+    int lo = 0;
+    int hi = n->count;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (comp_(key(n, mid), k)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  // 节点内第一个大于k的下标
+  template <typename K>
+  int upper_bound_in_node(node* n, const K& k) const
+  {
+    int lo = 0;
+    int hi = n->count;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (comp_(k, key(n, mid))) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo;
+  }
+
+  // 叶子节点中下标等于count的位置不是有效元素，沿父节点上溯到真正的下一个元素
+  iterator internal_end(iterator it) const noexcept
+  {
+    while (it.node_ && it.position_ == it.node_->count) {
+      it.position_ = it.node_->position;
+      it.node_     = it.node_->parent;
+    }
+    return it.node_ ? it : end_iterator();
+  }
+
+  iterator begin_iterator() const noexcept { return iterator(leftmost_, 0); }
+
+  iterator end_iterator() const noexcept { return iterator(rightmost_, rightmost_ ? rightmost_->count : 0); }
+
+  template <typename K>
+  iterator lower_bound_iterator(const K& k) const
+  {
+    if (!root_) {
+      return end_iterator();
+    }
+    node* n = root_;
+    for (;;) {
+      int i = lower_bound_in_node(n, k);
+      if (n->leaf) {
+        return internal_end(iterator(n, i));
+      }
+      n = child(n, i);
+    }
+  }
+
+  template <typename K>
+  iterator upper_bound_iterator(const K& k) const
+  {
+    if (!root_) {
+      return end_iterator();
+    }
+    node* n = root_;
+    for (;;) {
+      int i = upper_bound_in_node(n, k);
+      if (n->leaf) {
+        return internal_end(iterator(n, i));
+      }
+      n = child(n, i);
+    }
+  }
+
+  // 键唯一，在内部节点命中时即可返回
+  template <typename K>
+  iterator find_iterator(const K& k) const
+  {
+    node* n = root_;
+    while (n) {
+      int i = lower_bound_in_node(n, k);
+      if (i < n->count && !comp_(k, key(n, i))) {
+        return iterator(n, i);
+      }
+      if (n->leaf) {
+        break;
+      }
+      n = child(n, i);
+    }
+    return end_iterator();
+  }
+
+  // 查找键k的插入位置：键已存在时返回{该元素, false}，否则返回{插入位置, true}
+  std::pair<iterator, bool> find_insert_position(const key_type& k) const
+  {
+    if (!root_) {
+      return {end_iterator(), true};
+    }
+    node* n = root_;
+    for (;;) {
+      int i = lower_bound_in_node(n, k);
+      if (i < n->count && !comp_(k, key(n, i))) {
+        return {iterator(n, i), false};
+      }
+      if (n->leaf) {
+        return {iterator(n, i), true};
+      }
+      n = child(n, i);
+    }
+  }
+
+  // 带提示的插入位置：提示正确时只需与相邻元素比较一两次
+  std::pair<iterator, bool> find_hint_insert_position(const_iterator hint, const key_type& k) const
+  {
+    iterator pos(hint.node_, hint.position_);
+    if (pos == end_iterator()) {
+      if (size_ == 0 || comp_(Policy::key(*std::prev(pos)), k)) {
+        return {pos, true};
+      }
+    } else if (comp_(k, Policy::key(*pos))) {
+      if (pos == begin_iterator() || comp_(Policy::key(*std::prev(pos)), k)) {
+        return {pos, true};
+      }
+    } else if (comp_(Policy::key(*pos), k)) {
+      iterator next = std::next(pos);
+      if (next == end_iterator() || comp_(k, Policy::key(*next))) {
+        return {next, true};
+      }
+    } else {
+      return {pos, false};
+    }
+    return find_insert_position(k);
+  }
+
+  // 在内部节点n的下标i处插入分隔元素（从src搬入），并把right作为第i + 1个子节点
+  void insert_separator(node* n, int i, slot_type* src, node* right) noexcept
+  {
+    relocate(slot(n, i + 1), slot(n, i), n->count - i);
+    relocate(slot(n, i), src, 1);
+    for (int j = n->count; j > i; --j) {
+      set_child(n, j + 1, child(n, j));
+    }
+    set_child(n, i + 1, right);
+    ++n->count;
+  }
+
+  // 分裂已满的节点n，新元素将插入n的insert_position处；n保留左半部分，右半部分放入新的兄弟节点
+  void split(node* n, int insert_position)
+  {
+    // 先分配新节点，失败时树保持不变
+    node* right = allocate_node(n->leaf);
+    if (!n->parent) {
+      node* new_root;
+      try {
+        new_root = allocate_node(false);
+      } catch (...) {
+        deallocate_node(right);
+        throw;
+      }
+      set_child(new_root, 0, n);
+      root_ = new_root;
+    } else if (n->parent->count == node_slots) {
+      try {
+        split(n->parent, n->position);
+      } catch (...) {
+        deallocate_node(right);
+        throw;
+      }
+    }
+
+    // 顺序追加时左侧尽量保留满节点，顺序前插时右侧尽量保留满节点，否则对半分
+    int left_count;
+    if (insert_position == static_cast<int>(node_slots)) {
+      left_count = static_cast<int>(node_slots) - 2;
+    } else if (insert_position == 0) {
+      left_count = 1;
+    } else {
+      left_count = static_cast<int>(node_slots) / 2;
+    }
+
+    const int right_count = n->count - left_count - 1;
+    relocate(slot(right, 0), slot(n, left_count + 1), right_count);
+    right->count = static_cast<std::uint8_t>(right_count);
+    if (!n->leaf) {
+      for (int i = 0; i <= right_count; ++i) {
+        set_child(right, i, child(n, left_count + 1 + i));
+      }
+    }
+    n->count = static_cast<std::uint8_t>(left_count);
+    insert_separator(n->parent, n->position, slot(n, left_count), right);
+
+    if (n == rightmost_) {
+      rightmost_ = right;
+    }
+  }
+
+  // 在pos处用args构造新元素，pos必须是find_insert_position/find_hint_insert_position给出的位置
+  template <typename... Args>
+  iterator insert_at(iterator pos, Args&&... args)
+  {
+    if (!root_) {
+      root_ = leftmost_ = rightmost_ = allocate_node(true);
+      pos                            = iterator(root_, 0);
+    } else if (!pos.node_->leaf) {
+      // 内部元素之前的位置就是其左侧子树最大元素之后
+      --pos;
+      ++pos.position_;
+    }
+
+    node* n = pos.node_;
+    int   i = pos.position_;
+    if (n->count == node_slots) {
+      split(n, i);
+      if (i > n->count) {
+        i -= n->count + 1;
+        n = child(n->parent, n->position + 1);
+      }
+    }
+
+    relocate(slot(n, i + 1), slot(n, i), n->count - i);
+    try {
+      slot_traits::construct(alloc_, element(n, i), std::forward<Args>(args)...);
+    } catch (...) {
+      relocate(slot(n, i), slot(n, i + 1), n->count - i);
+      if (size_ == 0) {
+        deallocate_node(root_);
+        root_ = leftmost_ = rightmost_ = nullptr;
+      }
+      throw;
+    }
+    ++n->count;
+    ++size_;
+    return iterator(n, i);
+  }
+
+  // 把左兄弟left、父节点中的分隔元素和right合并到left中，释放right
+  void merge_nodes(node* left, node* right) noexcept
+  {
+    node* p = left->parent;
+    int   i = left->position;
+
+    relocate(slot(left, left->count), slot(p, i), 1);
+    relocate(slot(left, left->count + 1), slot(right, 0), right->count);
+    if (!left->leaf) {
+      for (int j = 0; j <= right->count; ++j) {
+        set_child(left, left->count + 1 + j, child(right, j));
+      }
+    }
+    left->count += 1 + right->count;
+
+    relocate(slot(p, i), slot(p, i + 1), p->count - i - 1);
+    for (int j = i + 1; j < p->count; ++j) {
+      set_child(p, j, child(p, j + 1));
+    }
+    --p->count;
+
+    if (rightmost_ == right) {
+      rightmost_ = left;
+    }
+    deallocate_node(right);
+  }
+
+  // 经由父节点把right开头的to_move个元素移给左兄弟left
+  void rebalance_right_to_left(node* left, int to_move, node* right) noexcept
+  {
+    node* p = left->parent;
+    int   i = left->position;
+
+    relocate(slot(left, left->count), slot(p, i), 1);
+    relocate(slot(left, left->count + 1), slot(right, 0), to_move - 1);
+    relocate(slot(p, i), slot(right, to_move - 1), 1);
+    relocate(slot(right, 0), slot(right, to_move), right->count - to_move);
+    if (!left->leaf) {
+      for (int j = 0; j < to_move; ++j) {
+        set_child(left, left->count + 1 + j, child(right, j));
+      }
+      for (int j = 0; j <= right->count - to_move; ++j) {
+        set_child(right, j, child(right, j + to_move));
+      }
+    }
+    left->count += to_move;
+    right->count -= to_move;
+  }
+
+  // 经由父节点把left末尾的to_move个元素移给右兄弟right
+  void rebalance_left_to_right(node* left, int to_move, node* right) noexcept
+  {
+    node* p = left->parent;
+    int   i = left->position;
+
+    relocate(slot(right, to_move), slot(right, 0), right->count);
+    relocate(slot(right, to_move - 1), slot(p, i), 1);
+    relocate(slot(right, 0), slot(left, left->count - to_move + 1), to_move - 1);
+    relocate(slot(p, i), slot(left, left->count - to_move), 1);
+    if (!left->leaf) {
+      for (int j = right->count; j >= 0; --j) {
+        set_child(right, j + to_move, child(right, j));
+      }
+      for (int j = 0; j < to_move; ++j) {
+        set_child(right, j, child(left, left->count - to_move + 1 + j));
+      }
+    }
+    left->count -= to_move;
+    right->count += to_move;
+  }
+
+  // it所在节点元素过少：能合并就与兄弟合并（返回true，父节点可能随之变少），否则从兄弟借元素
+  // it始终跟踪同一个逻辑位置
+  bool try_merge_or_rebalance(iterator& it) noexcept
+  {
+    node* n = it.node_;
+    node* p = n->parent;
+
+    if (n->position > 0) {
+      node* left = child(p, n->position - 1);
+      if (1 + left->count + n->count <= static_cast<int>(node_slots)) {
+        it.position_ += 1 + left->count;
+        merge_nodes(left, n);
+        it.node_ = left;
+        return true;
+      }
+    }
+    if (n->position < p->count) {
+      node* right = child(p, n->position + 1);
+      if (1 + n->count + right->count <= static_cast<int>(node_slots)) {
+        merge_nodes(n, right);
+        return true;
+      }
+      // 删除的是节点的第一个元素时不向右借，照顾从前往后依次删除的常见用法
+      if (right->count > min_node_values && (n->count == 0 || it.position_ > 0)) {
+        int to_move = std::min((right->count - n->count) / 2, right->count - 1);
+        rebalance_right_to_left(n, to_move, right);
+        return false;
+      }
+    }
+    if (n->position > 0) {
+      // 删除的是节点的最后一个元素时不向左借，照顾从后往前依次删除的常见用法
+      node* left = child(p, n->position - 1);
+      if (left->count > min_node_values && (n->count == 0 || it.position_ < n->count)) {
+        int to_move = std::min((left->count - n->count) / 2, left->count - 1);
+        rebalance_left_to_right(left, to_move, n);
+        it.position_ += to_move;
+        return false;
+      }
+    }
+    return false;
+  }
+
+  // 根节点为空时降低树高，整棵树为空时释放根节点
+  void try_shrink() noexcept
+  {
+    if (root_->count > 0) {
+      return;
+    }
+    node* old_root = root_;
+    if (old_root->leaf) {
+      root_ = leftmost_ = rightmost_ = nullptr;
+    } else {
+      root_         = child(old_root, 0);
+      root_->parent = nullptr;
+    }
+    deallocate_node(old_root);
+  }
+
+  // 删除后自下而上修复元素过少的节点，返回删除位置之后的元素
+  iterator rebalance_after_erase(iterator it) noexcept
+  {
+    iterator res   = it;
+    bool     first = true;
+    for (;;) {
+      if (it.node_ == root_) {
+        try_shrink();
+        if (!root_) {
+          return end_iterator();
+        }
+        break;
+      }
+      if (it.node_->count >= min_node_values) {
+        break;
+      }
+      bool merged = try_merge_or_rebalance(it);
+      // 只有叶子层的调整会移动res指向的元素
+      if (first) {
+        res   = it;
+        first = false;
+      }
+      if (!merged) {
+        break;
+      }
+      it.position_ = it.node_->position;
+      it.node_     = it.node_->parent;
+    }
+
+    if (res.position_ == res.node_->count) {
+      res.position_ = res.node_->count - 1;
+      ++res;
+    }
+    return res;
+  }
+
+  void reset() noexcept
+  {
+    root_ = leftmost_ = rightmost_ = nullptr;
+    size_                          = 0;
+  }
+
+  // 交换除分配器以外的全部状态
+  void swap_storage(btree& other) noexcept
+  {
+    std::swap(root_, other.root_);
+    std::swap(leftmost_, other.leftmost_);
+    std::swap(rightmost_, other.rightmost_);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+  }
+
+  // 按顺序逐个追加，每次都落在最右叶子节点末尾，不需要比较
+  template <typename InputIt>
+  void append_sorted(InputIt first, InputIt last)
+  {
+    try {
+      for (; first != last; ++first) {
+        insert_at(end_iterator(), *first);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+protected:
+  // 键不存在时才用args构造元素
+  template <typename... Args>
+  std::pair<iterator, bool> insert_unique(const key_type& k, Args&&... args)
+  {
+    auto pos = find_insert_position(k);
+    if (!pos.second) {
+      return {pos.first, false};
+    }
+    return {insert_at(pos.first, std::forward<Args>(args)...), true};
+  }
+
+  template <typename... Args>
+  iterator insert_hint_unique(const_iterator hint, const key_type& k, Args&&... args)
+  {
+    auto pos = find_hint_insert_position(hint, k);
+    if (!pos.second) {
+      return pos.first;
+    }
+    return insert_at(pos.first, std::forward<Args>(args)...);
+  }
+
+public:
+  // 构造函数
+  btree() : btree(Compare()) {}
+
+  explicit btree(const Compare& comp, const Allocator& alloc = Allocator())
+      : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), comp_(comp), alloc_(alloc)
+  {
+  }
+
+  explicit btree(const Allocator& alloc) : btree(Compare(), alloc) {}
+
+  template <typename InputIt>
+  btree(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : btree(comp, alloc)
+  {
+    insert(first, last);
+  }
+
+  template <typename InputIt>
+  btree(InputIt first, InputIt last, const Allocator& alloc) : btree(first, last, Compare(), alloc)
+  {
+  }
+
+  btree(std::initializer_list<value_type> init,
+        const Compare&                    comp  = Compare(),
+        const Allocator&                  alloc = Allocator())
+      : btree(init.begin(), init.end(), comp, alloc)
+  {
+  }
+
+  btree(std::initializer_list<value_type> init, const Allocator& alloc)
+      : btree(init.begin(), init.end(), Compare(), alloc)
+  {
+  }
+
+  // 复制构造：源树已经有序，逐个追加到末尾即可
+  btree(const btree& other)
+      : btree(other, slot_traits::select_on_container_copy_construction(other.alloc_))
+  {
+  }
+
+  btree(const btree& other, const Allocator& alloc) : btree(other.comp_, alloc)
+  {
+    append_sorted(other.begin(), other.end());
+  }
+
+  btree(btree&& other) noexcept
+      : root_(other.root_), leftmost_(other.leftmost_), rightmost_(other.rightmost_),
+        size_(other.size_), comp_(std::move(other.comp_)), alloc_(std::move(other.alloc_))
+  {
+    other.reset();
+  }
+
+  // 分配器不相等时节点不能直接接管，只能逐个移动元素
+  btree(btree&& other, const Allocator& alloc) : btree(other.comp_, alloc)
+  {
+    if (alloc_ == other.alloc_) {
+      swap_storage(other);
+    } else {
+      append_sorted(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+      other.clear();
+    }
+  }
+
+  // 临时对象使用赋值后本对象应持有的分配器；交换后由它带着原来的分配器释放原有内容
+  btree& operator=(const btree& other)
+  {
+    if (this != &other) {
+      btree tmp(other, slot_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : alloc_);
+      swap_storage(tmp);
+      if constexpr (slot_traits::propagate_on_container_copy_assignment::value) {
+        std::swap(alloc_, tmp.alloc_);
+      }
+    }
+    return *this;
+  }
+
+  btree& operator=(btree&& other) noexcept(
+      slot_traits::propagate_on_container_move_assignment::value || slot_traits::is_always_equal::value)
+  {
+    if (this != &other) {
+      if (allocator_can_steal(alloc_, other.alloc_)) {
+        btree tmp(std::move(other));
+        swap_storage(tmp);
+        if constexpr (slot_traits::propagate_on_container_move_assignment::value) {
+          std::swap(alloc_, tmp.alloc_);
+        }
+      } else {
+        btree tmp(std::move(other), alloc_);
+        swap_storage(tmp);
+      }
+    }
+    return *this;
+  }
+
+  btree& operator=(std::initializer_list<value_type> ilist)
+  {
+    clear();
+    insert(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  // 析构函数
+  ~btree() { clear(); }
+
+  allocator_type get_allocator() const noexcept { return allocator_type(alloc_); }
+
+  // 迭代器操作
+  iterator begin() noexcept { return begin_iterator(); }
+
+  const_iterator begin() const noexcept { return begin_iterator(); }
+
+  const_iterator cbegin() const noexcept { return begin_iterator(); }
+
+  iterator end() noexcept { return end_iterator(); }
+
+  const_iterator end() const noexcept { return end_iterator(); }
+
+  const_iterator cend() const noexcept { return end_iterator(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // 基本容量操作
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept { return slot_traits::max_size(alloc_); }
+
+  // 元素操作
+  void clear() noexcept
+  {
+    if (root_) {
+      destroy_subtree(root_);
+    }
+    reset();
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value)
+  {
+    return insert_unique(Policy::key(value), value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value)
+  {
+    return insert_unique(Policy::key(value), std::move(value));
+  }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  {
+    return insert_hint_unique(hint, Policy::key(value), value);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value)
+  {
+    return insert_hint_unique(hint, Policy::key(value), std::move(value));
+  }
+
+  // 以end()为提示逐个插入，输入已有序时每次插入只需一次比较
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      emplace_hint(cend(), *first);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  // 元素要先构造出来才能取得键，键已存在时临时元素被丢弃
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    value_holder tmp(alloc_, std::forward<Args>(args)...);
+    return insert_unique(Policy::key(tmp.get()), tmp.release());
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args)
+  {
+    value_holder tmp(alloc_, std::forward<Args>(args)...);
+    return insert_hint_unique(hint, Policy::key(tmp.get()), tmp.release());
+  }
+
+  // 删除会移动其他元素，返回指向原下一个元素的迭代器
+  iterator erase(const_iterator pos)
+  {
+    iterator it(pos.node_, pos.position_);
+    bool     internal_delete = !it.node_->leaf;
+
+    slot_traits::destroy(alloc_, element(it.node_, it.position_));
+    if (internal_delete) {
+      // 内部节点的元素用前驱（左侧子树的最大元素，必在叶子节点）填补，再从叶子中删掉前驱
+      iterator internal = it;
+      --it;
+      relocate(slot(internal.node_, internal.position_), slot(it.node_, it.position_), 1);
+    }
+    relocate(slot(it.node_, it.position_), slot(it.node_, it.position_ + 1), it.node_->count - it.position_ - 1);
+    --it.node_->count;
+    --size_;
+
+    iterator res = rebalance_after_erase(it);
+    if (internal_delete) {
+      ++res;  // res指向填补进来的前驱，再前进一步才是原下一个元素
+    }
+    return res;
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  // 删除会使last失效，所以按个数删除
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    if (first == cbegin() && last == cend()) {
+      clear();
+      return end();
+    }
+    size_type count = static_cast<size_type>(std::distance(first, last));
+    iterator  it(first.node_, first.position_);
+    for (; count > 0; --count) {
+      it = erase(it);
+    }
+    return it;
+  }
+
+  size_type erase(const key_type& key)
+  {
+    iterator it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    erase(it);
+    return 1;
+  }
+
+  void swap(btree& other) noexcept
+  {
+    swap_storage(other);
+    swap_allocator(alloc_, other.alloc_);
+  }
+
+  // 查找（模板重载为异构查找，只在比较器声明is_transparent时启用）
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  size_type count(const K& x) const
+  {
+    return contains(x) ? 1 : 0;
+  }
+
+  iterator find(const key_type& key) { return find_iterator(key); }
+
+  const_iterator find(const key_type& key) const { return find_iterator(key); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator find(const K& x)
+  {
+    return find_iterator(x);
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  const_iterator find(const K& x) const
+  {
+    return find_iterator(x);
+  }
+
+  bool contains(const key_type& key) const { return find_iterator(key) != end_iterator(); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  bool contains(const K& x) const
+  {
+    return find_iterator(x) != end_iterator();
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key)
+  {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+  {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& x)
+  {
+    return {lower_bound(x), upper_bound(x)};
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K& x) const
+  {
+    return {lower_bound(x), upper_bound(x)};
+  }
+
+  iterator lower_bound(const key_type& key) { return lower_bound_iterator(key); }
+
+  const_iterator lower_bound(const key_type& key) const { return lower_bound_iterator(key); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator lower_bound(const K& x)
+  {
+    return lower_bound_iterator(x);
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  const_iterator lower_bound(const K& x) const
+  {
+    return lower_bound_iterator(x);
+  }
+
+  iterator upper_bound(const key_type& key) { return upper_bound_iterator(key); }
+
+  const_iterator upper_bound(const key_type& key) const { return upper_bound_iterator(key); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator upper_bound(const K& x)
+  {
+    return upper_bound_iterator(x);
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  const_iterator upper_bound(const K& x) const
+  {
+    return upper_bound_iterator(x);
+  }
+
+  // 观察器
+  key_compare key_comp() const { return comp_; }
+
+  // 比较运算符：按顺序逐个比较元素
+  friend bool operator==(const btree& lhs, const btree& rhs)
+  {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  friend bool operator!=(const btree& lhs, const btree& rhs) { return !(lhs == rhs); }
+
+  friend bool operator<(const btree& lhs, const btree& rhs)
+  {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend bool operator<=(const btree& lhs, const btree& rhs) { return !(rhs < lhs); }
+
+  friend bool operator>(const btree& lhs, const btree& rhs) { return rhs < lhs; }
+
+  friend bool operator>=(const btree& lhs, const btree& rhs) { return !(lhs < rhs); }
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_BTREE_HPP
@@ -0,0 +1,204 @@
+#ifndef SJKXQ_STL_BTREE_MAP_HPP
+#define SJKXQ_STL_BTREE_MAP_HPP
+
+#include "common.hpp"
+#include "btree/btree.hpp"
+#include <functional>
+#include <memory>
+#include <tuple>
+
+namespace sjkxq_stl
+{
+
+// btree_map的元素是键值对，键取自first
+template <typename Key, typename T>
+struct btree_map_policy {
+  using key_type           = Key;
+  using value_type         = std::pair<const Key, T>;
+  using mutable_value_type = std::pair<Key, T>;
+
+  // 节点中的元素槽：对外是pair<const Key, T>，节点内搬迁时经由pair<Key, T>移动键，
+  // 否则const键每次移动都会被复制
+  union slot_type {
+    value_type         value;
+    mutable_value_type mutable_value;
+
+    slot_type() {}
+    ~slot_type() {}
+  };
+
+  // 可以通过迭代器修改值（键本身是const）
+  static constexpr bool constant_values = false;
+
+  static const key_type& key(const value_type& value) noexcept { return value.first; }
+
+  static value_type& element(slot_type& slot) noexcept { return slot.value; }
+
+  static mutable_value_type& mutable_element(slot_type& slot) noexcept { return slot.mutable_value; }
+};
+
+/**
+ * @brief 基于B树的有序映射
+ *
+ * 接口与map一致，但每个节点连续存放多个元素，内存占用更少，顺序遍历和范围查询更快。
+ * 代价是插入和删除会移动元素：任何修改都可能使其他元素的迭代器、指针和引用失效。
+ */
+template <typename Key,
+          typename T,
+          typename Compare   = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map : public btree<btree_map_policy<Key, T>, Compare, Allocator>
+{
+  using base = btree<btree_map_policy<Key, T>, Compare, Allocator>;
+
+public:
+  using mapped_type = T;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::key_type;
+  using typename base::value_type;
+
+  // 值比较器
+  class value_compare
+  {
+  protected:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+
+  public:
+    bool operator()(const value_type& lhs, const value_type& rhs) const
+    {
+      return comp(lhs.first, rhs.first);
+    }
+    friend class btree_map;
+  };
+
+  using base::base;
+  using base::insert;
+
+  btree_map() = default;
+
+  btree_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    base::operator=(ilist);
+    return *this;
+  }
+
+  // 元素访问
+  T& at(const Key& key)
+  {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("btree_map::at: key not found");
+    }
+    return it->second;
+  }
+
+  const T& at(const Key& key) const
+  {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("btree_map::at: key not found");
+    }
+    return it->second;
+  }
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+  // 可转换为value_type的参数，如 std::pair<Key, T>
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+  std::pair<iterator, bool> insert(P&& value)
+  {
+    return this->emplace(std::forward<P>(value));
+  }
+
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+  iterator insert(const_iterator hint, P&& value)
+  {
+    return this->emplace_hint(hint, std::forward<P>(value));
+  }
+
+  // 键不存在时才构造值，键已存在时参数不会被移动
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+  {
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(key),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+  {
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(std::move(key)),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, const Key& key, Args&&... args)
+  {
+    return this->insert_hint_unique(hint,
+                                    key,
+                                    std::piecewise_construct,
+                                    std::forward_as_tuple(key),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, Key&& key, Args&&... args)
+  {
+    return this->insert_hint_unique(hint,
+                                    key,
+                                    std::piecewise_construct,
+                                    std::forward_as_tuple(std::move(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+  {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+  {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  // 观察器
+  value_compare value_comp() const { return value_compare(this->key_comp()); }
+};
+
+// 特化的swap函数
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(btree_map<Key, T, Compare, Alloc>& lhs,
+          btree_map<Key, T, Compare, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+  lhs.swap(rhs);
+}
+
+// 容器只保存指向节点的指针，根节点不引用容器本身，可以按字节搬迁
+template <typename Key, typename T, typename Compare, typename Alloc>
+struct is_trivially_relocatable<btree_map<Key, T, Compare, Alloc>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<Compare>::value
+                                 && is_trivially_relocatable<Alloc>::value> {
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_BTREE_MAP_HPP
@@ -0,0 +1,83 @@
+#ifndef SJKXQ_STL_BTREE_SET_HPP
+#define SJKXQ_STL_BTREE_SET_HPP
+
+#include "common.hpp"
+#include "btree/btree.hpp"
+#include <functional>
+#include <memory>
+
+namespace sjkxq_stl
+{
+
+// btree_set的元素本身就是键
+template <typename Key>
+struct btree_set_policy {
+  using key_type   = Key;
+  using value_type = Key;
+
+  // 修改元素会破坏树的有序性，迭代器只读
+  static constexpr bool constant_values = true;
+
+  // 元素本身就可以移动，槽里只有一个成员
+  union slot_type {
+    value_type value;
+
+    slot_type() {}
+    ~slot_type() {}
+  };
+
+  static const key_type& key(const value_type& value) noexcept { return value; }
+
+  static value_type& element(slot_type& slot) noexcept { return slot.value; }
+
+  static value_type& mutable_element(slot_type& slot) noexcept { return slot.value; }
+};
+
+/**
+ * @brief 基于B树的有序集合
+ *
+ * 接口与set一致，但每个节点连续存放多个元素，内存占用更少，顺序遍历和范围查询更快。
+ * 代价是插入和删除会移动元素：任何修改都可能使其他元素的迭代器、指针和引用失效。
+ */
+template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+class btree_set : public btree<btree_set_policy<Key>, Compare, Allocator>
+{
+  using base = btree<btree_set_policy<Key>, Compare, Allocator>;
+
+public:
+  using value_compare = Compare;
+  using typename base::value_type;
+
+  using base::base;
+
+  btree_set() = default;
+
+  btree_set& operator=(std::initializer_list<value_type> ilist)
+  {
+    base::operator=(ilist);
+    return *this;
+  }
+
+  // 观察器
+  value_compare value_comp() const { return this->key_comp(); }
+};
+
+// 特化的swap函数
+template <typename Key, typename Compare, typename Alloc>
+void swap(btree_set<Key, Compare, Alloc>& lhs,
+          btree_set<Key, Compare, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+  lhs.swap(rhs);
+}
+
+// 容器只保存指向节点的指针，根节点不引用容器本身，可以按字节搬迁
+template <typename Key, typename Compare, typename Alloc>
+struct is_trivially_relocatable<btree_set<Key, Compare, Alloc>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<Compare>::value
+                                 && is_trivially_relocatable<Alloc>::value> {
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_BTREE_SET_HPP
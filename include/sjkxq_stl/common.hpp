@@ -2,9 +2,24 @@
 #define SJKXQ_STL_COMMON_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+// SIMD实现的编译期选择，由各个使用SIMD的组件共用：
+// 定义 SJKXQ_STL_PORTABLE 时所有组件都使用可移植实现；
+// 否则按编译目标定义 SJKXQ_STL_HAVE_AVX2、SJKXQ_STL_HAVE_SSE2，组件依次选用
+#if !defined(SJKXQ_STL_PORTABLE)
+#if defined(__AVX2__)
+#define SJKXQ_STL_HAVE_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SJKXQ_STL_HAVE_SSE2 1
+#endif
+#endif
+
 namespace sjkxq_stl
 {
 
@@ -31,6 +46,12 @@ struct bidirectional_iterator_tag : public forward_iterator_tag {
 struct random_access_iterator_tag : public bidirectional_iterator_tag {
 };
 
+// 构造有序容器时声明输入已经按比较器严格递增（有序且无重复），容器据此跳过排序和去重
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
 // 迭代器特性
 template <typename Iterator>
 struct iterator_traits {
@@ -60,6 +81,90 @@ struct iterator_traits<const T*> {
   using iterator_category = random_access_iterator_tag;
 };
 
+// 可平凡搬迁特性
+// 为true时，对象可以按字节复制到新地址继续使用，且复制后源对象不需要再析构。
+// 默认只对可平凡复制的类型成立；持有资源但不依赖自身地址的类型（如只保存一个指针的句柄类）
+// 可以特化此模板主动声明，容器在扩容和移动元素时会改用memcpy/memmove
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// std::allocator是无状态的，但部分标准库实现为它提供了非平凡的复制构造函数
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type {
+};
+
+// std::pair的两个成员都可以按字节搬迁时，pair本身也可以
+template <typename T1, typename T2>
+struct is_trivially_relocatable<std::pair<T1, T2>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<std::remove_const_t<T1>>::value
+                                 && is_trivially_relocatable<std::remove_const_t<T2>>::value> {
+};
+
+// std::unique_ptr只保存指针和删除器，不引用自身地址
+template <typename T, typename Deleter>
+struct is_trivially_relocatable<std::unique_ptr<T, Deleter>> : is_trivially_relocatable<Deleter> {
+};
+
+// 分配器传播
+// 容器复制赋值、移动赋值和交换时按propagate_on_container_*决定是否带上对方的分配器，
+// 不传播的分配器（如pmr::polymorphic_allocator）保持容器构造时的值
+template <typename Alloc>
+void copy_assign_allocator(Alloc& dst, const Alloc& src)
+{
+  if constexpr (std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value) {
+    dst = src;
+  }
+}
+
+template <typename Alloc>
+void move_assign_allocator(Alloc& dst, Alloc& src) noexcept
+{
+  if constexpr (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) {
+    dst = std::move(src);
+  }
+}
+
+template <typename Alloc>
+void swap_allocator(Alloc& a, Alloc& b) noexcept
+{
+  if constexpr (std::allocator_traits<Alloc>::propagate_on_container_swap::value) {
+    std::swap(a, b);
+  }
+}
+
+// 移动赋值后dst能否接管src分配的内存：分配器随之传播或总是相等时成立，否则要求两者相等。
+// 不成立时容器只能逐个移动元素
+template <typename Alloc>
+bool allocator_can_steal(const Alloc& dst, const Alloc& src) noexcept
+{
+  if constexpr (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value
+                || std::allocator_traits<Alloc>::is_always_equal::value) {
+    return true;
+  } else {
+    return dst == src;
+  }
+}
+
+// 统计最低位连续0的个数，mask不能为0
+inline unsigned count_trailing_zeros(std::uint32_t mask) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+  unsigned n = 0;
+  while (!(mask & 1u)) {
+    mask >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
 // 交换函数
 template <typename T>
 void swap(T& a, T& b) noexcept(std::is_nothrow_move_constructible<T>::value
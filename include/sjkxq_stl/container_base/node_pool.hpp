@@ -0,0 +1,283 @@
+#ifndef SJKXQ_STL_NODE_POOL_HPP
+#define SJKXQ_STL_NODE_POOL_HPP
+
+#include "../common.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace sjkxq_stl {
+
+/*
+ * 节点内存池
+ *
+ * 从分配器一次申请一大块内存（slab），再从中逐个切出节点；释放的节点挂到侵入式空闲链表上，
+ * 下次分配优先复用。slab只在release()或析构时整体归还，代价与slab数量成正比，与节点数量无关。
+ * 节点较多时slab大小成倍增长，单个slab不超过约64KB。
+ *
+ * slab带有引用计数，节点可以离开分配它的池而不必移动：
+ *   share(other)   本池引用other的全部slab，之后other的节点可以直接转入本池，由本池释放和复用；
+ *   retain(p)      节点p离开容器（如提取出的节点句柄）时单独持有它所在的slab，之后用release_slab归还。
+ * 池只在最后一个引用消失时把slab还给分配器，因此共享过的slab可能比单个池活得更久。
+ * 共享要求两个池的分配器相等。
+ *
+ * 调用release()前，使用者必须已经析构了池中所有的节点对象。
+ */
+template <typename Node, typename Allocator>
+class node_pool {
+private:
+    struct slab_header {
+        std::atomic<std::size_t> refs;   // 引用本slab的池和节点句柄的数量
+        std::size_t count;               // 本slab包含的槽位数（含头部）
+    };
+
+    // 槽位：空闲时存放空闲链表指针，第一个槽位存放slab头部，其余时候存放节点
+    union slot {
+        slot* next;
+        slab_header header;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+    using slot_traits = std::allocator_traits<slot_allocator>;
+    using slab_array_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot*>;
+    using slab_array_traits = std::allocator_traits<slab_array_allocator>;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    static constexpr std::size_t min_slab_slots = 16;
+    static constexpr std::size_t max_slab_slots =
+        sizeof(slot) * min_slab_slots < 65536 ? 65536 / sizeof(slot) : min_slab_slots;
+
+    slot_allocator alloc_;
+    slot* free_list_;       // 已释放、可复用的节点
+    slot* cursor_;          // 当前slab中下一个未使用的槽位
+    slot* slab_end_;        // 当前slab的末尾
+    slot** slabs_;          // 本池引用的所有slab，按地址升序排列
+    std::size_t slab_count_;
+    std::size_t slab_capacity_;
+    std::size_t next_slab_slots_;
+
+    // 保证slab数组还能再放下extra个slab
+    void reserve_slabs(std::size_t extra) {
+        if (slab_count_ + extra <= slab_capacity_) {
+            return;
+        }
+        std::size_t capacity = std::max(slab_count_ + extra, slab_capacity_ * 2);
+        slab_array_allocator a(alloc_);
+        slot** slabs = slab_array_traits::allocate(a, capacity);
+        std::copy(slabs_, slabs_ + slab_count_, slabs);
+        deallocate_slab_array();
+        slabs_ = slabs;
+        slab_capacity_ = capacity;
+    }
+
+    void deallocate_slab_array() noexcept {
+        if (slabs_) {
+            slab_array_allocator a(alloc_);
+            slab_array_traits::deallocate(a, slabs_, slab_capacity_);
+            slabs_ = nullptr;
+            slab_capacity_ = 0;
+        }
+    }
+
+    // 把s插入有序的slab数组，调用前已经预留好位置
+    void insert_slab(slot* s) noexcept {
+        slot** pos = std::upper_bound(slabs_, slabs_ + slab_count_, s, std::less<slot*>());
+        std::move_backward(pos, slabs_ + slab_count_, slabs_ + slab_count_ + 1);
+        *pos = s;
+        ++slab_count_;
+    }
+
+    void add_slab() {
+        reserve_slabs(1);
+        std::size_t count = next_slab_slots_;
+        slot* s = slot_traits::allocate(alloc_, count);
+        ::new (static_cast<void*>(&s->header)) slab_header{{1}, count};
+        insert_slab(s);
+        cursor_ = s + 1;
+        slab_end_ = s + count;
+        if (next_slab_slots_ < max_slab_slots) {
+            next_slab_slots_ *= 2;
+        }
+    }
+
+    static void drop_slab(slot_allocator& alloc, slot* s) noexcept {
+        if (s->header.refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            slot_traits::deallocate(alloc, s, s->header.count);
+        }
+    }
+
+public:
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using slab_ref = slot*;   // 对单个slab的引用，由retain取得、release_slab归还
+
+    explicit node_pool(const Allocator& a = Allocator())
+        : alloc_(a)
+        , free_list_(nullptr)
+        , cursor_(nullptr)
+        , slab_end_(nullptr)
+        , slabs_(nullptr)
+        , slab_count_(0)
+        , slab_capacity_(0)
+        , next_slab_slots_(min_slab_slots) {}
+
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    node_pool(node_pool&& other) noexcept
+        : alloc_(std::move(other.alloc_))
+        , free_list_(other.free_list_)
+        , cursor_(other.cursor_)
+        , slab_end_(other.slab_end_)
+        , slabs_(other.slabs_)
+        , slab_count_(other.slab_count_)
+        , slab_capacity_(other.slab_capacity_)
+        , next_slab_slots_(other.next_slab_slots_) {
+        other.free_list_ = nullptr;
+        other.cursor_ = nullptr;
+        other.slab_end_ = nullptr;
+        other.slabs_ = nullptr;
+        other.slab_count_ = 0;
+        other.slab_capacity_ = 0;
+        other.next_slab_slots_ = min_slab_slots;
+    }
+
+    node_pool& operator=(node_pool&& other) noexcept {
+        if (this != &other) {
+            release();
+            deallocate_slab_array();
+            move_assign_allocator(alloc_, other.alloc_);
+            swap_slabs(other);
+        }
+        return *this;
+    }
+
+    ~node_pool() {
+        release();
+        deallocate_slab_array();
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(alloc_);
+    }
+
+    // 分配一个节点的原始内存
+    Node* allocate() {
+        slot* s = free_list_;
+        if (s) {
+            free_list_ = s->next;
+        } else {
+            if (cursor_ == slab_end_) {
+                add_slab();
+            }
+            s = cursor_++;
+        }
+        return reinterpret_cast<Node*>(s->storage);
+    }
+
+    // 归还一个节点的内存（节点对象应已析构），节点可以来自共享给本池的slab
+    void deallocate(Node* p) noexcept {
+        slot* s = reinterpret_cast<slot*>(p);
+        s->next = free_list_;
+        free_list_ = s;
+    }
+
+    // 分配并构造节点，构造失败时内存回到空闲链表
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        Node* p = allocate();
+        try {
+            node_allocator na(alloc_);
+            node_traits::construct(na, p, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+        return p;
+    }
+
+    // 析构并回收节点
+    void destroy(Node* p) noexcept {
+        node_allocator na(alloc_);
+        node_traits::destroy(na, p);
+        deallocate(p);
+    }
+
+    // 引用other的全部slab，之后other中的节点可以直接交给本池；两个池的分配器必须相等。
+    // 失败时本池不变
+    void share(const node_pool& other) {
+        if (this == &other || other.slab_count_ == 0) {
+            return;
+        }
+        reserve_slabs(other.slab_count_);
+        for (std::size_t i = 0; i < other.slab_count_; ++i) {
+            slot* s = other.slabs_[i];
+            if (!std::binary_search(slabs_, slabs_ + slab_count_, s, std::less<slot*>())) {
+                s->header.refs.fetch_add(1, std::memory_order_relaxed);
+                insert_slab(s);
+            }
+        }
+    }
+
+    // 节点p（必须由本池或共享给本池的slab分配）离开池时，单独持有它所在的slab
+    slab_ref retain(Node* p) const noexcept {
+        slot* target = reinterpret_cast<slot*>(p);
+        slot** pos = std::upper_bound(slabs_, slabs_ + slab_count_, target, std::less<slot*>());
+        slot* s = *(pos - 1);
+        s->header.refs.fetch_add(1, std::memory_order_relaxed);
+        return s;
+    }
+
+    // 归还retain取得的引用；alloc必须与分配该slab的分配器相等
+    template <typename Alloc>
+    static void release_slab(slab_ref s, const Alloc& alloc) noexcept {
+        slot_allocator a(alloc);
+        drop_slab(a, s);
+    }
+
+    // 放弃对所有slab的引用，没有其他引用的slab归还给分配器
+    void release() noexcept {
+        for (std::size_t i = 0; i < slab_count_; ++i) {
+            drop_slab(alloc_, slabs_[i]);
+        }
+        slab_count_ = 0;
+        free_list_ = nullptr;
+        cursor_ = nullptr;
+        slab_end_ = nullptr;
+        next_slab_slots_ = min_slab_slots;
+    }
+
+    // 容器复制赋值时按propagate_on_container_copy_assignment接受other的分配器；
+    // 已有的slab来自原来的分配器，先全部归还
+    void copy_allocator_from(const node_pool& other) {
+        release();
+        deallocate_slab_array();
+        copy_assign_allocator(alloc_, other.alloc_);
+    }
+
+    void swap(node_pool& other) noexcept {
+        swap_allocator(alloc_, other.alloc_);
+        swap_slabs(other);
+    }
+
+private:
+    // 交换除分配器以外的全部状态
+    void swap_slabs(node_pool& other) noexcept {
+        std::swap(free_list_, other.free_list_);
+        std::swap(cursor_, other.cursor_);
+        std::swap(slab_end_, other.slab_end_);
+        std::swap(slabs_, other.slabs_);
+        std::swap(slab_count_, other.slab_count_);
+        std::swap(slab_capacity_, other.slab_capacity_);
+        std::swap(next_slab_slots_, other.next_slab_slots_);
+    }
+};
+
+} // namespace sjkxq_stl
+
+#endif // SJKXQ_STL_NODE_POOL_HPP
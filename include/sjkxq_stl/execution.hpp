@@ -0,0 +1,99 @@
+#ifndef SJKXQ_STL_EXECUTION_HPP
+#define SJKXQ_STL_EXECUTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 并行执行策略
+ *
+ * 作为容器构造、assign、resize等操作的第一个参数，表示把元素的构造分块交给多个线程完成。
+ * 每个线程至少处理min_chunk_bytes字节的元素，数据量不够时退化为在当前线程上顺序执行。
+ * 并行构造时内存页面由各线程首次写入，在NUMA机器上会分布到各线程所在的节点。
+ */
+struct parallel_policy
+{
+  std::size_t threads         = 0;                     // 线程数上限，0表示使用std::thread::hardware_concurrency()
+  std::size_t min_chunk_bytes = std::size_t(2) << 20;  // 每个线程至少处理的字节数
+
+  // 处理count个大小为value_size的元素时分成的块数，至少为1
+  std::size_t chunk_count(std::size_t count, std::size_t value_size) const noexcept
+  {
+    std::size_t limit = threads;
+    if (limit == 0) {
+      limit = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::size_t grain = std::max<std::size_t>(1, min_chunk_bytes / std::max<std::size_t>(1, value_size));
+    return std::max<std::size_t>(1, std::min(limit, count / grain));
+  }
+};
+
+inline constexpr parallel_policy par{};
+
+/**
+ * @brief 把[0, count)分成连续的块，在多个线程上对每块调用fn(first, last)，全部完成后返回
+ *
+ * 第一块在当前线程上执行；创建线程失败时剩余的块也在当前线程上完成。
+ * fn失败时必须撤销自己在本块中已完成的工作；只要有块失败，就对成功的块调用undo(first, last)，
+ * 然后重新抛出第一个失败的块的异常。
+ */
+template <typename Fn, typename Undo>
+void parallel_for_chunks(const parallel_policy& policy, std::size_t count, std::size_t value_size, Fn&& fn,
+                         Undo&& undo)
+{
+  const std::size_t chunks = policy.chunk_count(count, value_size);
+  if (chunks <= 1) {
+    if (count > 0) {
+      fn(std::size_t(0), count);
+    }
+    return;
+  }
+
+  auto bound = [count, chunks](std::size_t k) { return count / chunks * k + std::min(k, count % chunks); };
+  std::vector<std::exception_ptr> errors(chunks);
+  auto run = [&](std::size_t k) noexcept {
+    try {
+      fn(bound(k), bound(k + 1));
+    } catch (...) {
+      errors[k] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(chunks - 1);
+  std::size_t k = 1;
+  try {
+    for (; k < chunks; ++k) {
+      workers.emplace_back(run, k);
+    }
+  } catch (...) {
+    // 创建线程失败（system_error或分配线程状态时的bad_alloc）时，剩余的块在当前线程执行
+  }
+  run(0);
+  for (std::size_t j = k; j < chunks; ++j) {
+    run(j);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  auto failed = std::find_if(errors.begin(), errors.end(), [](const std::exception_ptr& e) { return e != nullptr; });
+  if (failed != errors.end()) {
+    for (std::size_t j = 0; j < chunks; ++j) {
+      if (!errors[j]) {
+        undo(bound(j), bound(j + 1));
+      }
+    }
+    std::rethrow_exception(*failed);
+  }
+}
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_EXECUTION_HPP
@@ -0,0 +1,181 @@
+#ifndef SJKXQ_STL_FLAT_HASH_GROUP_HPP
+#define SJKXQ_STL_FLAT_HASH_GROUP_HPP
+
+#include "../common.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// 组匹配实现按 common.hpp 中的检测结果选择：
+// AVX2（一次32个槽位）、SSE2（一次16个槽位），否则使用可移植实现
+#if defined(SJKXQ_STL_HAVE_AVX2)
+#include <immintrin.h>
+#elif defined(SJKXQ_STL_HAVE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace sjkxq_stl
+{
+
+// 控制字节：每个槽位对应一个字节
+// 非负值（0~127）表示槽位已占用，保存的是哈希值的低7位（h2）；负值为特殊标记
+using flat_hash_ctrl_t = signed char;
+
+constexpr flat_hash_ctrl_t flat_hash_ctrl_empty    = -128;  // 空槽位，探测到此即可停止
+constexpr flat_hash_ctrl_t flat_hash_ctrl_deleted  = -2;    // 墓碑，元素已删除但探测需继续
+constexpr flat_hash_ctrl_t flat_hash_ctrl_sentinel = -1;    // 控制数组末尾的哨兵，供迭代器停止
+
+inline bool flat_hash_is_full(flat_hash_ctrl_t c) noexcept { return c >= 0; }
+
+// 组内匹配结果：第i位为1表示组内第i个槽位满足条件
+// 可以直接用于范围for循环，依次得到所有匹配槽位在组内的下标
+class flat_hash_bitmask
+{
+public:
+  class iterator
+  {
+  public:
+    explicit iterator(std::uint32_t mask) noexcept : mask_(mask) {}
+
+    unsigned operator*() const noexcept { return count_trailing_zeros(mask_); }
+
+    iterator& operator++() noexcept
+    {
+      mask_ &= mask_ - 1;  // 清除最低位的1
+      return *this;
+    }
+
+    bool operator!=(const iterator& other) const noexcept { return mask_ != other.mask_; }
+
+  private:
+    std::uint32_t mask_;
+  };
+
+  explicit flat_hash_bitmask(std::uint32_t mask) noexcept : mask_(mask) {}
+
+  explicit operator bool() const noexcept { return mask_ != 0; }
+
+  // 最低位匹配槽位的组内下标，调用前需确保存在匹配
+  unsigned lowest() const noexcept { return count_trailing_zeros(mask_); }
+
+  iterator begin() const noexcept { return iterator(mask_); }
+  iterator end() const noexcept { return iterator(0); }
+
+private:
+  std::uint32_t mask_;
+};
+
+// 可移植的组实现：一次读取16个控制字节，逐字节比较生成位掩码
+class flat_hash_group_portable
+{
+public:
+  static constexpr std::size_t width = 16;
+
+  explicit flat_hash_group_portable(const flat_hash_ctrl_t* ctrl) noexcept
+  {
+    for (std::size_t i = 0; i < width; ++i) {
+      ctrl_[i] = ctrl[i];
+    }
+  }
+
+  // 控制字节等于h2的槽位
+  flat_hash_bitmask match(flat_hash_ctrl_t h2) const noexcept
+  {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+    }
+    return flat_hash_bitmask(mask);
+  }
+
+  // 空槽位
+  flat_hash_bitmask match_empty() const noexcept { return match(flat_hash_ctrl_empty); }
+
+  // 空槽位或墓碑，即可以放入新元素的槽位
+  flat_hash_bitmask match_empty_or_deleted() const noexcept
+  {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl_[i] < flat_hash_ctrl_sentinel) << i;
+    }
+    return flat_hash_bitmask(mask);
+  }
+
+private:
+  flat_hash_ctrl_t ctrl_[width];
+};
+
+#if defined(SJKXQ_STL_HAVE_SSE2)
+// SSE2实现：一次比较16个控制字节，movemask把每个字节的比较结果压缩成一位
+class flat_hash_group_sse2
+{
+public:
+  static constexpr std::size_t width = 16;
+
+  explicit flat_hash_group_sse2(const flat_hash_ctrl_t* ctrl) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+  {
+  }
+
+  flat_hash_bitmask match(flat_hash_ctrl_t h2) const noexcept
+  {
+    return flat_hash_bitmask(static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+
+  flat_hash_bitmask match_empty() const noexcept { return match(flat_hash_ctrl_empty); }
+
+  // 空槽位和墓碑都小于哨兵，一次有符号比较即可
+  flat_hash_bitmask match_empty_or_deleted() const noexcept
+  {
+    return flat_hash_bitmask(static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(flat_hash_ctrl_sentinel), ctrl_))));
+  }
+
+private:
+  __m128i ctrl_;
+};
+#endif
+
+#if defined(SJKXQ_STL_HAVE_AVX2)
+// AVX2实现：一次比较32个控制字节
+class flat_hash_group_avx2
+{
+public:
+  static constexpr std::size_t width = 32;
+
+  explicit flat_hash_group_avx2(const flat_hash_ctrl_t* ctrl) noexcept
+      : ctrl_(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl)))
+  {
+  }
+
+  flat_hash_bitmask match(flat_hash_ctrl_t h2) const noexcept
+  {
+    return flat_hash_bitmask(static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), ctrl_))));
+  }
+
+  flat_hash_bitmask match_empty() const noexcept { return match(flat_hash_ctrl_empty); }
+
+  flat_hash_bitmask match_empty_or_deleted() const noexcept
+  {
+    return flat_hash_bitmask(static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(flat_hash_ctrl_sentinel), ctrl_))));
+  }
+
+private:
+  __m256i ctrl_;
+};
+#endif
+
+// 哈希表使用的组实现。组宽决定了表的最小容量和探测粒度，因此只能在编译期确定
+#if defined(SJKXQ_STL_HAVE_AVX2)
+using flat_hash_group = flat_hash_group_avx2;
+#elif defined(SJKXQ_STL_HAVE_SSE2)
+using flat_hash_group = flat_hash_group_sse2;
+#else
+using flat_hash_group = flat_hash_group_portable;
+#endif
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_FLAT_HASH_GROUP_HPP
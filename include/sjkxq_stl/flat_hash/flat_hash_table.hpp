@@ -0,0 +1,837 @@
+#ifndef SJKXQ_STL_FLAT_HASH_TABLE_HPP
+#define SJKXQ_STL_FLAT_HASH_TABLE_HPP
+
+#include "../common.hpp"
+#include "../hash_policy.hpp"
+#include "flat_hash_group.hpp"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 开放寻址哈希表核心（Swiss table 风格）
+ *
+ * 所有元素直接存放在一块连续的槽位数组中，另有一个等长的控制字节数组记录每个槽位的状态。
+ * 哈希值被拆成两部分：高位（h1）决定从哪个组开始探测，低7位（h2）存入控制字节。
+ * 查找时一次取出一组控制字节与h2批量比较，只有控制字节匹配的槽位才会调用key_equal，
+ * 遇到含空槽位的组即可确定元素不存在。
+ *
+ * 组按组宽对齐，容量始终是组宽的2的幂倍，探测序列按组做三角数步进，可以遍历全部组。
+ * 最大负载因子固定为7/8（墓碑计入负载）。
+ *
+ * Policy 描述元素类型以及如何从元素中取出键，set 和 map 共用此核心。
+ * 与基于节点的容器不同，rehash 会移动元素，因此任何插入都可能使引用和迭代器失效。
+ */
+template <typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+class flat_hash_table
+{
+public:
+  // 类型定义
+  using key_type        = typename Policy::key_type;
+  using value_type      = typename Policy::value_type;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher          = Hash;
+  using key_equal       = KeyEqual;
+  using allocator_type  = Allocator;
+  using reference       = value_type&;
+  using const_reference = const value_type&;
+  using pointer         = value_type*;
+  using const_pointer   = const value_type*;
+
+private:
+  using ctrl_t         = flat_hash_ctrl_t;
+  using group_type     = flat_hash_group;
+  using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+  using slot_traits    = std::allocator_traits<slot_allocator>;
+  using ctrl_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ctrl_t>;
+  using ctrl_traits    = std::allocator_traits<ctrl_allocator>;
+
+  static constexpr size_type group_width = group_type::width;
+
+  // 迭代器：同时指向控制字节和槽位，前进时跳过空槽位和墓碑，停在末尾的哨兵上
+  template <bool Const>
+  class basic_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = typename flat_hash_table::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer   = std::conditional_t<Const || Policy::constant_values, const value_type*, value_type*>;
+    using reference = std::conditional_t<Const || Policy::constant_values, const value_type&, value_type&>;
+
+    basic_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+
+    // 允许 iterator 隐式转换为 const_iterator
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    basic_iterator(const basic_iterator<false>& other) noexcept
+        : ctrl_(other.ctrl_), slot_(other.slot_)
+    {
+    }
+
+    reference operator*() const { return *slot_; }
+    pointer   operator->() const { return slot_; }
+
+    basic_iterator& operator++()
+    {
+      ++ctrl_;
+      ++slot_;
+      skip_empty();
+      return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+      basic_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+    {
+      return lhs.ctrl_ == rhs.ctrl_;
+    }
+
+    friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend class flat_hash_table;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(const ctrl_t* ctrl, value_type* slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+    void skip_empty() noexcept
+    {
+      while (*ctrl_ < flat_hash_ctrl_sentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    const ctrl_t* ctrl_;
+    value_type*   slot_;
+  };
+
+public:
+  using iterator       = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+private:
+  // 基本成员变量
+  ctrl_t*        ctrl_;      // 控制字节数组，长度为capacity_ + 1（末尾为哨兵）
+  value_type*    slots_;     // 槽位数组
+  size_type      capacity_;  // 槽位数量，0或组宽的2的幂倍
+  size_type      size_;      // 元素数量
+  size_type      deleted_;   // 墓碑数量
+  hasher         hash_function_;
+  key_equal      key_equal_;
+  slot_allocator alloc_;
+
+  static size_type max_load(size_type capacity) noexcept { return capacity - capacity / 8; }
+
+  // 不小于min_capacity且能容纳count个元素的最小容量，超过max_size()时抛出length_error
+  size_type capacity_for(size_type count, size_type min_capacity = 0) const
+  {
+    if (count > max_size() || min_capacity > max_size()) {
+      throw std::length_error("flat_hash_table: element count exceeds maximum size");
+    }
+    size_type capacity = group_width;
+    while (capacity < min_capacity || max_load(capacity) < count) {
+      if (capacity > max_size() / 2) {
+        throw std::length_error("flat_hash_table: element count exceeds maximum size");
+      }
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  static ctrl_t    h2(std::size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7f); }
+  static size_type h1(std::size_t hash) noexcept { return hash >> 7; }
+
+  std::size_t hash_of(const key_type& key) const { return hash_mix(hash_function_(key)); }
+
+  // 查找键所在的槽位下标，不存在时返回capacity_
+  size_type find_index(const key_type& key, std::size_t hash) const
+  {
+    if (capacity_ == 0) {
+      return capacity_;
+    }
+
+    const size_type group_mask = capacity_ / group_width - 1;
+    size_type       g          = h1(hash) & group_mask;
+    for (size_type step = 1;; ++step) {
+      const size_type base = g * group_width;
+      group_type      group(ctrl_ + base);
+      for (unsigned i : group.match(h2(hash))) {
+        if (key_equal_(Policy::key(slots_[base + i]), key)) {
+          return base + i;
+        }
+      }
+      if (group.match_empty()) {
+        return capacity_;
+      }
+      g = (g + step) & group_mask;
+    }
+  }
+
+  // 沿探测序列找到第一个空槽位或墓碑
+  size_type find_insert_index(std::size_t hash) const noexcept
+  {
+    return find_insert_index(ctrl_, capacity_, hash);
+  }
+
+  static size_type find_insert_index(const ctrl_t* ctrl, size_type capacity,
+                                     std::size_t hash) noexcept
+  {
+    const size_type group_mask = capacity / group_width - 1;
+    size_type       g          = h1(hash) & group_mask;
+    for (size_type step = 1;; ++step) {
+      const size_type base      = g * group_width;
+      auto            available = group_type(ctrl + base).match_empty_or_deleted();
+      if (available) {
+        return base + available.lowest();
+      }
+      g = (g + step) & group_mask;
+    }
+  }
+
+  // 为新元素找到槽位，必要时先扩容或清理墓碑
+  size_type prepare_insert(std::size_t hash)
+  {
+    if (size_ + deleted_ + 1 > max_load(capacity_)) {
+      if (capacity_ > 0 && size_ + 1 <= max_load(capacity_) / 2) {
+        // 负载主要来自墓碑，原容量重建即可回收
+        rehash_to(capacity_);
+      } else {
+        rehash_to(capacity_ == 0 ? group_width : capacity_ * 2);
+      }
+    }
+    return find_insert_index(hash);
+  }
+
+protected:
+  // 键不存在时用args在新槽位中构造元素
+  template <typename... Args>
+  std::pair<iterator, bool> insert_unique(const key_type& key, Args&&... args)
+  {
+    const std::size_t hash  = hash_of(key);
+    size_type         index = find_index(key, hash);
+    if (index != capacity_) {
+      return {iterator_at(index), false};
+    }
+
+    index = prepare_insert(hash);
+    slot_traits::construct(alloc_, slots_ + index, std::forward<Args>(args)...);
+    if (ctrl_[index] == flat_hash_ctrl_deleted) {
+      --deleted_;
+    }
+    ctrl_[index] = h2(hash);
+    ++size_;
+    return {iterator_at(index), true};
+  }
+
+private:
+  void erase_index(size_type index)
+  {
+    slot_traits::destroy(alloc_, slots_ + index);
+    --size_;
+
+    // 组内仍有空槽位说明从未有探测越过这个组，可以直接置空，否则必须留下墓碑
+    const size_type base = index & ~(group_width - 1);
+    if (group_type(ctrl_ + base).match_empty()) {
+      ctrl_[index] = flat_hash_ctrl_empty;
+    } else {
+      ctrl_[index] = flat_hash_ctrl_deleted;
+      ++deleted_;
+    }
+  }
+
+  iterator iterator_at(size_type index) noexcept { return iterator(ctrl_ + index, slots_ + index); }
+
+  const_iterator iterator_at(size_type index) const noexcept
+  {
+    return const_iterator(ctrl_ + index, slots_ + index);
+  }
+
+  // 分配容量为capacity的空表，不修改本对象
+  std::pair<ctrl_t*, value_type*> allocate_storage(size_type capacity)
+  {
+    ctrl_allocator ctrl_alloc(alloc_);
+    ctrl_t*        ctrl = ctrl_traits::allocate(ctrl_alloc, capacity + 1);
+    value_type*    slots;
+    try {
+      slots = slot_traits::allocate(alloc_, capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(ctrl_alloc, ctrl, capacity + 1);
+      throw;
+    }
+    std::memset(ctrl, static_cast<unsigned char>(flat_hash_ctrl_empty), capacity);
+    ctrl[capacity] = flat_hash_ctrl_sentinel;
+    return {ctrl, slots};
+  }
+
+  // 分配容量为capacity的空表作为本对象的表
+  void allocate_table(size_type capacity)
+  {
+    const auto storage = allocate_storage(capacity);
+    ctrl_              = storage.first;
+    slots_             = storage.second;
+    capacity_          = capacity;
+    deleted_           = 0;
+  }
+
+  void deallocate_table(ctrl_t* ctrl, value_type* slots, size_type capacity) noexcept
+  {
+    if (capacity > 0) {
+      ctrl_allocator ctrl_alloc(alloc_);
+      ctrl_traits::deallocate(ctrl_alloc, ctrl, capacity + 1);
+      slot_traits::deallocate(alloc_, slots, capacity);
+    }
+  }
+
+  void destroy_slots() noexcept
+  {
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+      for (size_type i = 0; i < capacity_; ++i) {
+        if (flat_hash_is_full(ctrl_[i])) {
+          slot_traits::destroy(alloc_, slots_ + i);
+        }
+      }
+    }
+  }
+
+  // 重建为新容量，所有元素按新的探测序列重新放置。
+  // 新表全部建好后才替换原表；哈希函数或元素的复制抛出异常时释放新表，原表保持不变
+  void rehash_to(size_type new_capacity)
+  {
+    const auto  storage   = allocate_storage(new_capacity);
+    ctrl_t*     new_ctrl  = storage.first;
+    value_type* new_slots = storage.second;
+
+    constexpr bool nothrow_hash =
+        noexcept(std::declval<const hasher&>()(std::declval<const key_type&>()));
+    if constexpr (is_trivially_relocatable<value_type>::value || nothrow_hash) {
+      // 一趟完成：按字节搬迁不改动原表；哈希函数不抛异常时，只有复制元素可能失败，原表同样完好
+      try {
+        for (size_type i = 0; i < capacity_; ++i) {
+          if (!flat_hash_is_full(ctrl_[i])) {
+            continue;
+          }
+          const std::size_t hash  = hash_of(Policy::key(slots_[i]));
+          const size_type   index = find_insert_index(new_ctrl, new_capacity, hash);
+          if constexpr (is_trivially_relocatable<value_type>::value) {
+            std::memcpy(static_cast<void*>(new_slots + index),
+                        static_cast<const void*>(slots_ + i),
+                        sizeof(value_type));
+          } else {
+            slot_traits::construct(alloc_, new_slots + index, std::move_if_noexcept(slots_[i]));
+          }
+          new_ctrl[index] = h2(hash);
+        }
+      } catch (...) {
+        // 按字节搬迁的元素仍归原表所有，只释放内存
+        if constexpr (!is_trivially_relocatable<value_type>::value) {
+          for (size_type j = 0; j < new_capacity; ++j) {
+            if (flat_hash_is_full(new_ctrl[j])) {
+              slot_traits::destroy(alloc_, new_slots + j);
+            }
+          }
+        }
+        deallocate_table(new_ctrl, new_slots, new_capacity);
+        throw;
+      }
+    } else {
+      // 哈希函数可能抛异常：先为所有元素选好新位置，全部成功后再移动元素，
+      // 否则已移入新表的元素无法放回原表
+      std::unique_ptr<size_type[]> targets;
+      try {
+        targets.reset(new size_type[capacity_]);
+        for (size_type i = 0; i < capacity_; ++i) {
+          if (flat_hash_is_full(ctrl_[i])) {
+            const std::size_t hash = hash_of(Policy::key(slots_[i]));
+            targets[i]             = find_insert_index(new_ctrl, new_capacity, hash);
+            new_ctrl[targets[i]]   = h2(hash);
+          }
+        }
+      } catch (...) {
+        deallocate_table(new_ctrl, new_slots, new_capacity);
+        throw;
+      }
+
+      size_type i = 0;
+      try {
+        for (; i < capacity_; ++i) {
+          if (flat_hash_is_full(ctrl_[i])) {
+            slot_traits::construct(alloc_, new_slots + targets[i],
+                                   std::move_if_noexcept(slots_[i]));
+          }
+        }
+      } catch (...) {
+        for (size_type j = 0; j < i; ++j) {
+          if (flat_hash_is_full(ctrl_[j])) {
+            slot_traits::destroy(alloc_, new_slots + targets[j]);
+          }
+        }
+        deallocate_table(new_ctrl, new_slots, new_capacity);
+        throw;
+      }
+    }
+
+    if constexpr (!is_trivially_relocatable<value_type>::value) {
+      destroy_slots();
+    }
+    deallocate_table(ctrl_, slots_, capacity_);
+    ctrl_     = new_ctrl;
+    slots_    = new_slots;
+    capacity_ = new_capacity;
+    deleted_  = 0;
+  }
+
+  // 本对象为空时按other的布局逐槽构造元素，哈希函数相同，无需重新哈希；other为右值时移动元素
+  template <typename Source>
+  void clone_slots(Source&& other)
+  {
+    if (other.size_ == 0) {
+      return;
+    }
+
+    allocate_table(other.capacity_);
+    size_type i = 0;
+    try {
+      for (; i < capacity_; ++i) {
+        if (flat_hash_is_full(other.ctrl_[i])) {
+          if constexpr (std::is_rvalue_reference<Source&&>::value) {
+            slot_traits::construct(alloc_, slots_ + i, std::move(other.slots_[i]));
+          } else {
+            slot_traits::construct(alloc_, slots_ + i, other.slots_[i]);
+          }
+        }
+        ctrl_[i] = other.ctrl_[i];
+      }
+    } catch (...) {
+      for (size_type j = 0; j < i; ++j) {
+        if (flat_hash_is_full(ctrl_[j])) {
+          slot_traits::destroy(alloc_, slots_ + j);
+        }
+      }
+      deallocate_table(ctrl_, slots_, capacity_);
+      ctrl_     = nullptr;
+      slots_    = nullptr;
+      capacity_ = 0;
+      throw;
+    }
+    size_    = other.size_;
+    deleted_ = other.deleted_;
+  }
+
+  // 交换除分配器以外的全部状态
+  void swap_storage(flat_hash_table& other) noexcept
+  {
+    using std::swap;
+    swap(ctrl_, other.ctrl_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+    swap(deleted_, other.deleted_);
+    swap(hash_function_, other.hash_function_);
+    swap(key_equal_, other.key_equal_);
+  }
+
+public:
+  // 构造函数
+  flat_hash_table()
+      : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), deleted_(0), hash_function_(),
+        key_equal_(), alloc_()
+  {
+  }
+
+  explicit flat_hash_table(size_type        bucket_count,
+                           const Hash&      hash  = Hash(),
+                           const KeyEqual&  equal = KeyEqual(),
+                           const Allocator& alloc = Allocator())
+      : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), deleted_(0), hash_function_(hash),
+        key_equal_(equal), alloc_(alloc)
+  {
+    rehash(bucket_count);
+  }
+
+  explicit flat_hash_table(const Allocator& alloc)
+      : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), deleted_(0), hash_function_(),
+        key_equal_(), alloc_(alloc)
+  {
+  }
+
+  template <typename InputIt>
+  flat_hash_table(InputIt          first,
+                  InputIt          last,
+                  size_type        bucket_count = 0,
+                  const Hash&      hash         = Hash(),
+                  const KeyEqual&  equal        = KeyEqual(),
+                  const Allocator& alloc        = Allocator())
+      : flat_hash_table(bucket_count, hash, equal, alloc)
+  {
+    insert(first, last);
+  }
+
+  flat_hash_table(std::initializer_list<value_type> init,
+                  size_type                         bucket_count = 0,
+                  const Hash&                       hash         = Hash(),
+                  const KeyEqual&                   equal        = KeyEqual(),
+                  const Allocator&                  alloc        = Allocator())
+      : flat_hash_table(bucket_count, hash, equal, alloc)
+  {
+    reserve(init.size());
+    insert(init.begin(), init.end());
+  }
+
+  // 复制构造：哈希函数相同，元素可以按原有布局逐槽复制，无需重新哈希
+  flat_hash_table(const flat_hash_table& other)
+      : flat_hash_table(other, slot_traits::select_on_container_copy_construction(other.alloc_))
+  {
+  }
+
+  flat_hash_table(const flat_hash_table& other, const Allocator& alloc)
+      : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), deleted_(0),
+        hash_function_(other.hash_function_), key_equal_(other.key_equal_), alloc_(alloc)
+  {
+    clone_slots(other);
+  }
+
+  flat_hash_table(flat_hash_table&& other) noexcept
+      : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_), size_(other.size_),
+        deleted_(other.deleted_), hash_function_(std::move(other.hash_function_)),
+        key_equal_(std::move(other.key_equal_)), alloc_(std::move(other.alloc_))
+  {
+    other.ctrl_     = nullptr;
+    other.slots_    = nullptr;
+    other.capacity_ = 0;
+    other.size_     = 0;
+    other.deleted_  = 0;
+  }
+
+  // 分配器不相等时槽数组不能直接接管，只能逐个移动元素
+  flat_hash_table(flat_hash_table&& other, const Allocator& alloc)
+      : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), deleted_(0),
+        hash_function_(other.hash_function_), key_equal_(other.key_equal_), alloc_(alloc)
+  {
+    if (alloc_ == other.alloc_) {
+      swap_storage(other);
+    } else {
+      clone_slots(std::move(other));
+      other.clear();
+    }
+  }
+
+  // 临时对象使用赋值后本对象应持有的分配器；交换后由它带着原来的分配器释放原有内容
+  flat_hash_table& operator=(const flat_hash_table& other)
+  {
+    if (this != &other) {
+      flat_hash_table tmp(other, slot_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : alloc_);
+      swap_storage(tmp);
+      if constexpr (slot_traits::propagate_on_container_copy_assignment::value) {
+        std::swap(alloc_, tmp.alloc_);
+      }
+    }
+    return *this;
+  }
+
+  flat_hash_table& operator=(flat_hash_table&& other) noexcept(
+      slot_traits::propagate_on_container_move_assignment::value || slot_traits::is_always_equal::value)
+  {
+    if (this != &other) {
+      if (allocator_can_steal(alloc_, other.alloc_)) {
+        flat_hash_table tmp(std::move(other));
+        swap_storage(tmp);
+        if constexpr (slot_traits::propagate_on_container_move_assignment::value) {
+          std::swap(alloc_, tmp.alloc_);
+        }
+      } else {
+        flat_hash_table tmp(std::move(other), alloc_);
+        swap_storage(tmp);
+      }
+    }
+    return *this;
+  }
+
+  flat_hash_table& operator=(std::initializer_list<value_type> ilist)
+  {
+    clear();
+    reserve(ilist.size());
+    insert(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  // 析构函数
+  ~flat_hash_table()
+  {
+    destroy_slots();
+    deallocate_table(ctrl_, slots_, capacity_);
+  }
+
+  allocator_type get_allocator() const noexcept { return allocator_type(alloc_); }
+
+  // 迭代器操作
+  iterator begin() noexcept
+  {
+    if (size_ == 0) {
+      return end();
+    }
+    iterator it(ctrl_, slots_);
+    it.skip_empty();
+    return it;
+  }
+
+  const_iterator begin() const noexcept { return cbegin(); }
+
+  const_iterator cbegin() const noexcept
+  {
+    if (size_ == 0) {
+      return cend();
+    }
+    const_iterator it(ctrl_, slots_);
+    it.skip_empty();
+    return it;
+  }
+
+  iterator end() noexcept { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+
+  const_iterator end() const noexcept { return cend(); }
+
+  const_iterator cend() const noexcept { return const_iterator(ctrl_ + capacity_, slots_ + capacity_); }
+
+  // 基本容量操作
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept
+  {
+    return std::min<size_type>(slot_traits::max_size(alloc_),
+                               std::numeric_limits<difference_type>::max() / sizeof(value_type));
+  }
+
+  // 槽位数量，对应链式哈希表的桶数量
+  size_type bucket_count() const noexcept { return capacity_; }
+
+  // 哈希策略
+  float load_factor() const noexcept
+  {
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f;
+  }
+
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  // 最大负载因子由探测算法决定，设置值会被忽略，仅为与unordered_set保持接口一致
+  void max_load_factor(float) noexcept {}
+
+  void rehash(size_type count)
+  {
+    if (count == 0 && size_ == 0) {
+      // 释放全部内存
+      destroy_slots();
+      deallocate_table(ctrl_, slots_, capacity_);
+      ctrl_     = nullptr;
+      slots_    = nullptr;
+      capacity_ = 0;
+      deleted_  = 0;
+      return;
+    }
+
+    size_type new_capacity = capacity_for(size_, count);
+    if (new_capacity != capacity_ || deleted_ > 0) {
+      rehash_to(new_capacity);
+    }
+  }
+
+  void reserve(size_type count)
+  {
+    if (count > max_load(capacity_)) {
+      rehash_to(capacity_for(count));
+    }
+  }
+
+  // 元素操作
+  std::pair<iterator, bool> insert(const value_type& value)
+  {
+    return insert_unique(Policy::key(value), value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value)
+  {
+    return insert_unique(Policy::key(value), std::move(value));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    value_type value(std::forward<Args>(args)...);
+    return insert_unique(Policy::key(value), std::move(value));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args&&... args)
+  {
+    // 元素位置完全由哈希值决定，hint没有意义
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  // 删除元素不会移动其他元素，返回指向下一个元素的迭代器
+  iterator erase(const_iterator pos)
+  {
+    const size_type index = pos.slot_ - slots_;
+    erase_index(index);
+    iterator next = iterator_at(index);
+    ++next;
+    return next;
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator(last.ctrl_, last.slot_);
+  }
+
+  size_type erase(const key_type& key)
+  {
+    const size_type index = find_index(key, hash_of(key));
+    if (index == capacity_) {
+      return 0;
+    }
+    erase_index(index);
+    return 1;
+  }
+
+  iterator find(const key_type& key)
+  {
+    const size_type index = find_index(key, hash_of(key));
+    return index == capacity_ ? end() : iterator_at(index);
+  }
+
+  const_iterator find(const key_type& key) const
+  {
+    const size_type index = find_index(key, hash_of(key));
+    return index == capacity_ ? cend() : iterator_at(index);
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key)
+  {
+    iterator it = find(key);
+    if (it == end()) {
+      return {it, it};
+    }
+    iterator next = it;
+    ++next;
+    return {it, next};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+  {
+    const_iterator it = find(key);
+    if (it == cend()) {
+      return {it, it};
+    }
+    const_iterator next = it;
+    ++next;
+    return {it, next};
+  }
+
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  bool contains(const key_type& key) const
+  {
+    return find_index(key, hash_of(key)) != capacity_;
+  }
+
+  // 清空元素但保留已分配的槽位
+  void clear() noexcept
+  {
+    if (capacity_ == 0) {
+      return;
+    }
+    destroy_slots();
+    std::memset(ctrl_, static_cast<unsigned char>(flat_hash_ctrl_empty), capacity_);
+    size_    = 0;
+    deleted_ = 0;
+  }
+
+  // 观察器
+  hasher hash_function() const { return hash_function_; }
+
+  key_equal key_eq() const { return key_equal_; }
+
+  // 合并操作：把other中本容器不存在的元素移动过来，重复的键保留在other中
+  void merge(flat_hash_table& other)
+  {
+    if (this == &other) {
+      return;
+    }
+
+    reserve(size_ + other.size_);
+    for (size_type i = 0; i < other.capacity_; ++i) {
+      if (!flat_hash_is_full(other.ctrl_[i])) {
+        continue;
+      }
+      value_type& value = other.slots_[i];
+      if (insert_unique(Policy::key(value), std::move(value)).second) {
+        other.erase_index(i);
+      }
+    }
+  }
+
+  // 辅助功能
+  void swap(flat_hash_table& other) noexcept
+  {
+    swap_storage(other);
+    swap_allocator(alloc_, other.alloc_);
+  }
+
+  // 比较运算符：元素集合相同即相等，与存放顺序无关
+  friend bool operator==(const flat_hash_table& lhs, const flat_hash_table& rhs)
+  {
+    if (lhs.size_ != rhs.size_) {
+      return false;
+    }
+    for (const auto& value : lhs) {
+      auto it = rhs.find(Policy::key(value));
+      if (it == rhs.end() || !Policy::mapped_equal(*it, value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend bool operator!=(const flat_hash_table& lhs, const flat_hash_table& rhs)
+  {
+    return !(lhs == rhs);
+  }
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_FLAT_HASH_TABLE_HPP
@@ -0,0 +1,152 @@
+#ifndef SJKXQ_STL_FLAT_HASH_MAP_HPP
+#define SJKXQ_STL_FLAT_HASH_MAP_HPP
+
+#include "flat_hash/flat_hash_table.hpp"
+#include <functional>
+#include <memory>
+#include <tuple>
+
+namespace sjkxq_stl
+{
+
+// map的元素是键值对，键取自first
+template <typename Key, typename T>
+struct flat_hash_map_policy {
+  using key_type   = Key;
+  using value_type = std::pair<const Key, T>;
+
+  // 可以通过迭代器修改值（键本身是const）
+  static constexpr bool constant_values = false;
+
+  static const key_type& key(const value_type& value) noexcept { return value.first; }
+
+  static bool mapped_equal(const value_type& lhs, const value_type& rhs)
+  {
+    return lhs.second == rhs.second;
+  }
+};
+
+/**
+ * @brief 基于开放寻址的哈希映射
+ *
+ * 与flat_hash_set共用同一个哈希表核心，键值对直接存放在连续的槽位数组中。
+ * 接口与unordered_map一致（不提供桶迭代器），插入可能使所有迭代器、指针和引用失效。
+ */
+template <typename Key,
+          typename T,
+          typename Hash      = std::hash<Key>,
+          typename KeyEqual  = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class flat_hash_map
+    : public flat_hash_table<flat_hash_map_policy<Key, T>, Hash, KeyEqual, Allocator>
+{
+  using base = flat_hash_table<flat_hash_map_policy<Key, T>, Hash, KeyEqual, Allocator>;
+
+public:
+  using mapped_type = T;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::key_type;
+  using typename base::value_type;
+
+  using base::base;
+  using base::insert;
+
+  flat_hash_map() = default;
+
+  flat_hash_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    base::operator=(ilist);
+    return *this;
+  }
+
+  // 元素访问
+  T& at(const Key& key)
+  {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("flat_hash_map::at: key not found");
+    }
+    return it->second;
+  }
+
+  const T& at(const Key& key) const
+  {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("flat_hash_map::at: key not found");
+    }
+    return it->second;
+  }
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+  // 可转换为value_type的参数，如 std::pair<Key, T>
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+  std::pair<iterator, bool> insert(P&& value)
+  {
+    return this->emplace(std::forward<P>(value));
+  }
+
+  // 键不存在时才构造值，键已存在时参数不会被移动
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+  {
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(key),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+  {
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(std::move(key)),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+  {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+  {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+};
+
+// 非成员函数
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& lhs,
+          flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+// 容器只保存指向槽位数组的指针，可以按字节搬迁
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+struct is_trivially_relocatable<flat_hash_map<Key, T, Hash, KeyEqual, Allocator>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<Hash>::value
+                                 && is_trivially_relocatable<KeyEqual>::value
+                                 && is_trivially_relocatable<Allocator>::value> {
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_FLAT_HASH_MAP_HPP
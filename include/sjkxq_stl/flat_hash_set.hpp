@@ -0,0 +1,72 @@
+#ifndef SJKXQ_STL_FLAT_HASH_SET_HPP
+#define SJKXQ_STL_FLAT_HASH_SET_HPP
+
+#include "flat_hash/flat_hash_table.hpp"
+#include <functional>
+#include <memory>
+
+namespace sjkxq_stl
+{
+
+// set的元素就是键本身
+template <typename Key>
+struct flat_hash_set_policy {
+  using key_type   = Key;
+  using value_type = Key;
+
+  // 键参与哈希，不允许通过迭代器修改
+  static constexpr bool constant_values = true;
+
+  static const key_type& key(const value_type& value) noexcept { return value; }
+
+  static bool mapped_equal(const value_type&, const value_type&) noexcept { return true; }
+};
+
+/**
+ * @brief 基于开放寻址的哈希集合
+ *
+ * 接口与unordered_set一致（不提供节点句柄和桶迭代器），但键直接存放在连续的槽位数组中，
+ * 查找不需要追踪指针，插入也不需要为每个元素单独分配内存。
+ * 代价是rehash会移动元素：插入可能使所有迭代器、指针和引用失效。
+ */
+template <typename Key,
+          typename Hash      = std::hash<Key>,
+          typename KeyEqual  = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_hash_set : public flat_hash_table<flat_hash_set_policy<Key>, Hash, KeyEqual, Allocator>
+{
+  using base = flat_hash_table<flat_hash_set_policy<Key>, Hash, KeyEqual, Allocator>;
+
+public:
+  using base::base;
+  using typename base::value_type;
+
+  flat_hash_set() = default;
+
+  flat_hash_set& operator=(std::initializer_list<value_type> ilist)
+  {
+    base::operator=(ilist);
+    return *this;
+  }
+};
+
+// 非成员函数
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void swap(flat_hash_set<Key, Hash, KeyEqual, Allocator>& lhs,
+          flat_hash_set<Key, Hash, KeyEqual, Allocator>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+// 容器只保存指向槽位数组的指针，可以按字节搬迁
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+struct is_trivially_relocatable<flat_hash_set<Key, Hash, KeyEqual, Allocator>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<Hash>::value
+                                 && is_trivially_relocatable<KeyEqual>::value
+                                 && is_trivially_relocatable<Allocator>::value> {
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_FLAT_HASH_SET_HPP
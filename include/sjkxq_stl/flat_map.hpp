@@ -0,0 +1,806 @@
+#ifndef SJKXQ_STL_FLAT_MAP_HPP
+#define SJKXQ_STL_FLAT_MAP_HPP
+
+#include "common.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 基于有序数组的映射
+ *
+ * 键和值分别存放在两个连续容器中（默认为sjkxq_stl::vector），下标相同的键和值构成一个元素，
+ * 键按比较器严格递增。查找只在键数组上做二分查找，键紧密排列，缓存和预取都很友好。
+ * 单个元素的插入和删除需要移动其后的所有元素，是O(n)的；
+ * 批量插入先对新元素排序，再与原有元素合并，总代价为O(n + m log m)。
+ * 任何插入和删除都可能使迭代器、指针和引用失效。
+ *
+ * 由于键和值不在同一个对象中，迭代器解引用得到的是 std::pair<const Key&, T&>，
+ * 而不是 std::pair<const Key, T>&。
+ */
+template <typename Key,
+          typename T,
+          typename Compare         = std::less<Key>,
+          typename KeyContainer    = vector<Key>,
+          typename MappedContainer = vector<T>>
+class flat_map
+{
+public:
+  // 类型定义
+  using key_type               = Key;
+  using mapped_type            = T;
+  using value_type             = std::pair<Key, T>;
+  using key_compare            = Compare;
+  using reference              = std::pair<const Key&, T&>;
+  using const_reference        = std::pair<const Key&, const T&>;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using key_container_type     = KeyContainer;
+  using mapped_container_type  = MappedContainer;
+
+  // 值比较器
+  class value_compare
+  {
+  protected:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+
+  public:
+    template <typename L, typename R>
+    bool operator()(const L& lhs, const R& rhs) const
+    {
+      return comp(lhs.first, rhs.first);
+    }
+    friend class flat_map;
+  };
+
+  // extract()的返回值
+  struct containers {
+    key_container_type    keys;
+    mapped_container_type values;
+  };
+
+private:
+  // 迭代器：同时指向键数组和值数组中的同一下标
+  template <bool Const>
+  class basic_iterator
+  {
+    using key_iterator    = typename KeyContainer::const_iterator;
+    using mapped_iterator = std::conditional_t<Const,
+                                               typename MappedContainer::const_iterator,
+                                               typename MappedContainer::iterator>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename flat_map::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::conditional_t<Const, const_reference, typename flat_map::reference>;
+
+    // operator->返回的代理对象，保存一个引用对
+    struct pointer {
+      reference ref;
+      const reference* operator->() const noexcept { return std::addressof(ref); }
+    };
+
+    basic_iterator() = default;
+
+    // 允许 iterator 隐式转换为 const_iterator
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    basic_iterator(const basic_iterator<false>& other) noexcept
+        : key_it_(other.key_it_), mapped_it_(other.mapped_it_)
+    {
+    }
+
+    reference operator*() const { return reference(*key_it_, *mapped_it_); }
+    pointer   operator->() const { return pointer{**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    basic_iterator& operator++()
+    {
+      ++key_it_;
+      ++mapped_it_;
+      return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+      basic_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    basic_iterator& operator--()
+    {
+      --key_it_;
+      --mapped_it_;
+      return *this;
+    }
+
+    basic_iterator operator--(int)
+    {
+      basic_iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    basic_iterator& operator+=(difference_type n)
+    {
+      key_it_ += n;
+      mapped_it_ += n;
+      return *this;
+    }
+
+    basic_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+
+    friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+
+    friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+
+    friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs)
+    {
+      return lhs.key_it_ - rhs.key_it_;
+    }
+
+    friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs)
+    {
+      return lhs.key_it_ == rhs.key_it_;
+    }
+
+    friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) { return !(lhs == rhs); }
+
+    friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs)
+    {
+      return lhs.key_it_ < rhs.key_it_;
+    }
+
+    friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs) { return rhs < lhs; }
+
+    friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs) { return !(rhs < lhs); }
+
+    friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs) { return !(lhs < rhs); }
+
+  private:
+    friend class flat_map;
+    friend class basic_iterator<!Const>;
+
+    basic_iterator(key_iterator key_it, mapped_iterator mapped_it) : key_it_(key_it), mapped_it_(mapped_it) {}
+
+    key_iterator    key_it_;
+    mapped_iterator mapped_it_;
+  };
+
+public:
+  using iterator               = basic_iterator<false>;
+  using const_iterator         = basic_iterator<true>;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+  key_container_type    keys_;
+  mapped_container_type values_;
+  Compare               comp_;
+
+  iterator iterator_at(size_type i) noexcept { return iterator(keys_.cbegin() + i, values_.begin() + i); }
+
+  const_iterator iterator_at(size_type i) const noexcept
+  {
+    return const_iterator(keys_.cbegin() + i, values_.cbegin() + i);
+  }
+
+  template <typename K>
+  size_type lower_index(const K& k) const
+  {
+    return static_cast<size_type>(std::lower_bound(keys_.begin(), keys_.end(), k, comp_) - keys_.begin());
+  }
+
+  template <typename K>
+  size_type upper_index(const K& k) const
+  {
+    return static_cast<size_type>(std::upper_bound(keys_.begin(), keys_.end(), k, comp_) - keys_.begin());
+  }
+
+  template <typename K>
+  size_type find_index(const K& k) const
+  {
+    size_type i = lower_index(k);
+    return (i != keys_.size() && !comp_(k, keys_[i])) ? i : keys_.size();
+  }
+
+  // 在下标i处插入键和值，值构造失败时撤销已插入的键
+  template <typename K, typename... Args>
+  iterator insert_at(size_type i, K&& key, Args&&... args)
+  {
+    keys_.emplace(keys_.begin() + i, std::forward<K>(key));
+    try {
+      values_.emplace(values_.begin() + i, std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.erase(keys_.begin() + i);
+      throw;
+    }
+    return iterator_at(i);
+  }
+
+  // 键不存在时才用args构造值
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args)
+  {
+    size_type i = lower_index(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+      return {iterator_at(i), false};
+    }
+    return {insert_at(i, std::forward<K>(key), std::forward<Args>(args)...), true};
+  }
+
+  // 提示正确时（hint的前一个键小于key且hint的键大于key）不需要二分查找
+  template <typename K, typename... Args>
+  iterator try_emplace_hint_impl(const_iterator hint, K&& key, Args&&... args)
+  {
+    size_type i = static_cast<size_type>(hint.key_it_ - keys_.cbegin());
+    if ((i == keys_.size() || comp_(key, keys_[i])) && (i == 0 || comp_(keys_[i - 1], key))) {
+      return insert_at(i, std::forward<K>(key), std::forward<Args>(args)...);
+    }
+    return try_emplace_impl(std::forward<K>(key), std::forward<Args>(args)...).first;
+  }
+
+  // 对下标[first, end)的元素按键稳定排序并去重，重复的键保留最先出现的一个
+  // 键和值分处两个容器，先对下标排序，再按下标顺序把元素移到新容器中
+  void sort_unique_from(size_type first)
+  {
+    const size_type n      = keys_.size() - first;
+    auto            strict = [this](const Key& lhs, const Key& rhs) { return comp_(lhs, rhs); };
+    if (std::adjacent_find(keys_.begin() + first, keys_.end(), std::not_fn(strict)) == keys_.end()) {
+      return;  // 已经严格递增
+    }
+
+    vector<size_type> order(n);
+    for (size_type i = 0; i < n; ++i) {
+      order[i] = first + i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_type lhs, size_type rhs) {
+      return comp_(keys_[lhs], keys_[rhs]);
+    });
+
+    key_container_type    keys;
+    mapped_container_type values;
+    keys.reserve(n);
+    values.reserve(n);
+    for (size_type i : order) {
+      if (keys.empty() || comp_(keys.back(), keys_[i])) {
+        keys.push_back(std::move(keys_[i]));
+        values.push_back(std::move(values_[i]));
+      }
+    }
+
+    keys_.erase(keys_.begin() + first, keys_.end());
+    values_.erase(values_.begin() + first, values_.end());
+    keys_.insert(keys_.end(), std::make_move_iterator(keys.begin()), std::make_move_iterator(keys.end()));
+    values_.insert(values_.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+  }
+
+  // [0, mid)与[mid, end)各自有序且无重复，合并为一个有序序列，与原有键重复的新元素被丢弃。
+  // 抛出异常时原有元素可能已被移走，只能清空（与std::flat_map相同）
+  void merge_from(size_type mid)
+  {
+    try {
+      merge_sorted_from(mid);
+    } catch (...) {
+      keys_.clear();
+      values_.clear();
+      throw;
+    }
+  }
+
+  void merge_sorted_from(size_type mid)
+  {
+    const size_type total = keys_.size();
+    if (mid == 0 || mid == total || comp_(keys_[mid - 1], keys_[mid])) {
+      return;  // 新元素都排在原有元素之后，不需要合并
+    }
+
+    key_container_type    keys;
+    mapped_container_type values;
+    keys.reserve(total);
+    values.reserve(total);
+    auto take = [&](size_type i) {
+      keys.push_back(std::move(keys_[i]));
+      values.push_back(std::move(values_[i]));
+    };
+
+    size_type i = 0;
+    size_type j = mid;
+    while (i < mid && j < total) {
+      if (comp_(keys_[j], keys_[i])) {
+        take(j++);
+      } else {
+        if (!comp_(keys_[i], keys_[j])) {
+          ++j;  // 键已存在，保留原有元素
+        }
+        take(i++);
+      }
+    }
+    for (; i < mid; ++i) {
+      take(i);
+    }
+    for (; j < total; ++j) {
+      take(j);
+    }
+
+    keys_   = std::move(keys);
+    values_ = std::move(values);
+  }
+
+  // 删除下标n之后的元素，键和值容器都截到n
+  void truncate(size_type n)
+  {
+    keys_.erase(keys_.begin() + std::min(n, keys_.size()), keys_.end());
+    values_.erase(values_.begin() + std::min(n, values_.size()), values_.end());
+  }
+
+  // 把[first, last)追加到末尾并按键排序去重；抛出异常时删除已追加的元素，原有元素不受影响
+  template <typename InputIt>
+  void append_sorted(InputIt first, InputIt last, bool sorted)
+  {
+    const size_type mid = keys_.size();
+    try {
+      append(first, last);
+      if (!sorted) {
+        sort_unique_from(mid);
+      }
+    } catch (...) {
+      truncate(mid);
+      throw;
+    }
+  }
+
+  template <typename InputIt>
+  void append(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      const auto& value = *first;
+      keys_.push_back(value.first);
+      try {
+        values_.push_back(value.second);
+      } catch (...) {
+        keys_.pop_back();
+        throw;
+      }
+    }
+  }
+
+public:
+  // 构造函数
+  flat_map() : keys_(), values_(), comp_() {}
+
+  explicit flat_map(const Compare& comp) : keys_(), values_(), comp_(comp) {}
+
+  // 接管未排序的键和值容器（长度必须相同），排序并去重
+  flat_map(key_container_type keys, mapped_container_type values, const Compare& comp = Compare())
+      : keys_(std::move(keys)), values_(std::move(values)), comp_(comp)
+  {
+    sort_unique_from(0);
+  }
+
+  // 接管已经按键有序且无重复的键和值容器
+  flat_map(sorted_unique_t,
+           key_container_type    keys,
+           mapped_container_type values,
+           const Compare&        comp = Compare())
+      : keys_(std::move(keys)), values_(std::move(values)), comp_(comp)
+  {
+  }
+
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  flat_map(InputIt first, InputIt last, const Compare& comp = Compare()) : flat_map(comp)
+  {
+    insert(first, last);
+  }
+
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  flat_map(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare()) : flat_map(comp)
+  {
+    append(first, last);
+  }
+
+  flat_map(std::initializer_list<value_type> init, const Compare& comp = Compare())
+      : flat_map(init.begin(), init.end(), comp)
+  {
+  }
+
+  flat_map(sorted_unique_t, std::initializer_list<value_type> init, const Compare& comp = Compare())
+      : flat_map(sorted_unique, init.begin(), init.end(), comp)
+  {
+  }
+
+  flat_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    clear();
+    insert(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  // 迭代器
+  iterator begin() noexcept { return iterator_at(0); }
+
+  const_iterator begin() const noexcept { return iterator_at(0); }
+
+  const_iterator cbegin() const noexcept { return iterator_at(0); }
+
+  iterator end() noexcept { return iterator_at(keys_.size()); }
+
+  const_iterator end() const noexcept { return iterator_at(keys_.size()); }
+
+  const_iterator cend() const noexcept { return iterator_at(keys_.size()); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+  const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+  // 容量
+  bool empty() const noexcept { return keys_.empty(); }
+
+  size_type size() const noexcept { return keys_.size(); }
+
+  size_type max_size() const noexcept { return std::min<size_type>(keys_.max_size(), values_.max_size()); }
+
+  // 预留空间，适合在批量插入前调用
+  void reserve(size_type new_cap)
+  {
+    keys_.reserve(new_cap);
+    values_.reserve(new_cap);
+  }
+
+  void shrink_to_fit()
+  {
+    keys_.shrink_to_fit();
+    values_.shrink_to_fit();
+  }
+
+  // 元素访问
+  T& at(const Key& key)
+  {
+    size_type i = find_index(key);
+    if (i == keys_.size()) {
+      throw out_of_range("flat_map::at: key not found");
+    }
+    return values_[i];
+  }
+
+  const T& at(const Key& key) const
+  {
+    size_type i = find_index(key);
+    if (i == keys_.size()) {
+      throw out_of_range("flat_map::at: key not found");
+    }
+    return values_[i];
+  }
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+  // 修改器
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    value_type value(std::forward<Args>(args)...);
+    return try_emplace_impl(std::move(value.first), std::move(value.second));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args)
+  {
+    value_type value(std::forward<Args>(args)...);
+    return try_emplace_hint_impl(hint, std::move(value.first), std::move(value.second));
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) { return try_emplace_impl(value.first, value.second); }
+
+  std::pair<iterator, bool> insert(value_type&& value)
+  {
+    return try_emplace_impl(std::move(value.first), std::move(value.second));
+  }
+
+  // 可转换为value_type的参数，如 std::pair<const Key, T>
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+  std::pair<iterator, bool> insert(P&& value)
+  {
+    return emplace(std::forward<P>(value));
+  }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  {
+    return try_emplace_hint_impl(hint, value.first, value.second);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value)
+  {
+    return try_emplace_hint_impl(hint, std::move(value.first), std::move(value.second));
+  }
+
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+  iterator insert(const_iterator hint, P&& value)
+  {
+    return emplace_hint(hint, std::forward<P>(value));
+  }
+
+  // 批量插入：新元素先追加到末尾并排序去重，再与原有元素合并，避免逐个插入时反复移动。
+  // 复制或比较新元素时抛出异常，容器保持原样；合并时抛出异常，容器被清空
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void insert(InputIt first, InputIt last)
+  {
+    const size_type mid = keys_.size();
+    append_sorted(first, last, false);
+    merge_from(mid);
+  }
+
+  // 批量插入已经按键有序且无重复的元素，只需合并
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void insert(sorted_unique_t, InputIt first, InputIt last)
+  {
+    const size_type mid = keys_.size();
+    append_sorted(first, last, true);
+    merge_from(mid);
+  }
+
+  void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  void insert(sorted_unique_t, std::initializer_list<value_type> ilist)
+  {
+    insert(sorted_unique, ilist.begin(), ilist.end());
+  }
+
+  // 键不存在时才构造值，键已存在时参数不会被移动
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+  {
+    return try_emplace_impl(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+  {
+    return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, const Key& key, Args&&... args)
+  {
+    return try_emplace_hint_impl(hint, key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, Key&& key, Args&&... args)
+  {
+    return try_emplace_hint_impl(hint, std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+  {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+  {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  // 取出底层容器，本容器变为空
+  containers extract() &&
+  {
+    containers result{std::move(keys_), std::move(values_)};
+    clear();
+    return result;
+  }
+
+  // 替换底层容器，keys必须已经有序且无重复，且与values长度相同
+  void replace(key_container_type&& keys, mapped_container_type&& values)
+  {
+    keys_   = std::move(keys);
+    values_ = std::move(values);
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    size_type i = static_cast<size_type>(pos.key_it_ - keys_.cbegin());
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+    return iterator_at(i);
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    size_type i = static_cast<size_type>(first.key_it_ - keys_.cbegin());
+    size_type j = static_cast<size_type>(last.key_it_ - keys_.cbegin());
+    keys_.erase(keys_.begin() + i, keys_.begin() + j);
+    values_.erase(values_.begin() + i, values_.begin() + j);
+    return iterator_at(i);
+  }
+
+  size_type erase(const key_type& key)
+  {
+    size_type i = find_index(key);
+    if (i == keys_.size()) {
+      return 0;
+    }
+    erase(iterator_at(i));
+    return 1;
+  }
+
+  void swap(flat_map& other) noexcept
+  {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+    std::swap(comp_, other.comp_);
+  }
+
+  void clear() noexcept
+  {
+    keys_.clear();
+    values_.clear();
+  }
+
+  // 观察器
+  key_compare key_comp() const { return comp_; }
+
+  value_compare value_comp() const { return value_compare(comp_); }
+
+  const key_container_type& keys() const noexcept { return keys_; }
+
+  const mapped_container_type& values() const noexcept { return values_; }
+
+  // 查找（模板重载为异构查找，只在比较器声明is_transparent时启用）
+  iterator find(const key_type& key) { return iterator_at(find_index(key)); }
+
+  const_iterator find(const key_type& key) const { return iterator_at(find_index(key)); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator find(const K& x)
+  {
+    return iterator_at(find_index(x));
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  const_iterator find(const K& x) const
+  {
+    return iterator_at(find_index(x));
+  }
+
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  size_type count(const K& x) const
+  {
+    return contains(x) ? 1 : 0;
+  }
+
+  bool contains(const key_type& key) const { return find_index(key) != keys_.size(); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  bool contains(const K& x) const
+  {
+    return find_index(x) != keys_.size();
+  }
+
+  iterator lower_bound(const key_type& key) { return iterator_at(lower_index(key)); }
+
+  const_iterator lower_bound(const key_type& key) const { return iterator_at(lower_index(key)); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator lower_bound(const K& x)
+  {
+    return iterator_at(lower_index(x));
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  const_iterator lower_bound(const K& x) const
+  {
+    return iterator_at(lower_index(x));
+  }
+
+  iterator upper_bound(const key_type& key) { return iterator_at(upper_index(key)); }
+
+  const_iterator upper_bound(const key_type& key) const { return iterator_at(upper_index(key)); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator upper_bound(const K& x)
+  {
+    return iterator_at(upper_index(x));
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  const_iterator upper_bound(const K& x) const
+  {
+    return iterator_at(upper_index(x));
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key)
+  {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+  {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& x)
+  {
+    return {lower_bound(x), upper_bound(x)};
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K& x) const
+  {
+    return {lower_bound(x), upper_bound(x)};
+  }
+
+  // 比较运算符
+  friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+  {
+    return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+  }
+
+  friend bool operator!=(const flat_map& lhs, const flat_map& rhs) { return !(lhs == rhs); }
+
+  friend bool operator<(const flat_map& lhs, const flat_map& rhs)
+  {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend bool operator<=(const flat_map& lhs, const flat_map& rhs) { return !(rhs < lhs); }
+
+  friend bool operator>(const flat_map& lhs, const flat_map& rhs) { return rhs < lhs; }
+
+  friend bool operator>=(const flat_map& lhs, const flat_map& rhs) { return !(lhs < rhs); }
+};
+
+// 特化的swap函数
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+void swap(flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+          flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+// 只包含两个底层容器和比较器，三者都可以按字节搬迁时整体也可以
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+struct is_trivially_relocatable<flat_map<Key, T, Compare, KeyContainer, MappedContainer>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<Compare>::value
+                                 && is_trivially_relocatable<KeyContainer>::value
+                                 && is_trivially_relocatable<MappedContainer>::value> {
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_FLAT_MAP_HPP
@@ -0,0 +1,387 @@
+#ifndef SJKXQ_STL_FLAT_SET_HPP
+#define SJKXQ_STL_FLAT_SET_HPP
+
+#include "common.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 基于有序数组的集合
+ *
+ * 元素按比较器严格递增地存放在一个连续容器中（默认为sjkxq_stl::vector），
+ * 查找是对连续内存的二分查找，没有任何节点开销，适合一次构建、大量查询的场景。
+ * 单个元素的插入和删除需要移动其后的所有元素，是O(n)的；
+ * 批量插入先对新元素排序，再与原有元素合并，总代价为O(n + m log m)。
+ * 任何插入和删除都可能使迭代器、指针和引用失效。
+ */
+template <typename Key, typename Compare = std::less<Key>, typename KeyContainer = vector<Key>>
+class flat_set
+{
+public:
+  // 类型定义
+  using key_type               = Key;
+  using value_type             = Key;
+  using key_compare            = Compare;
+  using value_compare          = Compare;
+  using reference              = value_type&;
+  using const_reference        = const value_type&;
+  using size_type              = typename KeyContainer::size_type;
+  using difference_type        = typename KeyContainer::difference_type;
+  using iterator               = typename KeyContainer::const_iterator;
+  using const_iterator         = typename KeyContainer::const_iterator;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using container_type         = KeyContainer;
+
+private:
+  container_type keys_;
+  Compare        comp_;
+
+  // 相邻两个元素等价；只用于有序序列，此时前者不大于后者
+  bool equivalent_adjacent(const Key& lhs, const Key& rhs) const { return !comp_(lhs, rhs); }
+
+  // 对[first, end)稳定排序并去重，重复的元素保留最先出现的一个
+  void sort_unique_from(size_type first)
+  {
+    auto begin = keys_.begin() + first;
+    if (!std::is_sorted(begin, keys_.end(), comp_)) {
+      std::stable_sort(begin, keys_.end(), comp_);
+    }
+    auto last = std::unique(begin, keys_.end(), [this](const Key& lhs, const Key& rhs) {
+      return equivalent_adjacent(lhs, rhs);
+    });
+    keys_.erase(last, keys_.end());
+  }
+
+  // [0, mid)与[mid, end)各自有序且无重复，合并为一个有序序列，与原有元素重复的新元素被丢弃。
+  // 抛出异常时原有元素的顺序可能已被打乱，只能清空（与std::flat_set相同）
+  void merge_from(size_type mid)
+  {
+    if (mid == 0 || mid == keys_.size() || comp_(keys_[mid - 1], keys_[mid])) {
+      return;  // 新元素都排在原有元素之后，不需要合并
+    }
+    try {
+      std::inplace_merge(keys_.begin(), keys_.begin() + mid, keys_.end(), comp_);
+      auto last = std::unique(keys_.begin(), keys_.end(), [this](const Key& lhs, const Key& rhs) {
+        return equivalent_adjacent(lhs, rhs);
+      });
+      keys_.erase(last, keys_.end());
+    } catch (...) {
+      keys_.clear();
+      throw;
+    }
+  }
+
+  // 把[first, last)追加到末尾并排序去重；抛出异常时删除已追加的元素，原有元素不受影响
+  template <typename InputIt>
+  void append_sorted(InputIt first, InputIt last, bool sorted)
+  {
+    const size_type mid = keys_.size();
+    try {
+      keys_.insert(keys_.end(), first, last);
+      if (!sorted) {
+        sort_unique_from(mid);
+      }
+    } catch (...) {
+      keys_.erase(keys_.begin() + std::min(mid, keys_.size()), keys_.end());
+      throw;
+    }
+  }
+
+public:
+  // 构造函数
+  flat_set() : keys_(), comp_() {}
+
+  explicit flat_set(const Compare& comp) : keys_(), comp_(comp) {}
+
+  // 接管一个未排序的容器，排序并去重
+  explicit flat_set(container_type cont, const Compare& comp = Compare())
+      : keys_(std::move(cont)), comp_(comp)
+  {
+    sort_unique_from(0);
+  }
+
+  // 接管一个已经有序且无重复的容器
+  flat_set(sorted_unique_t, container_type cont, const Compare& comp = Compare())
+      : keys_(std::move(cont)), comp_(comp)
+  {
+  }
+
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  flat_set(InputIt first, InputIt last, const Compare& comp = Compare()) : keys_(), comp_(comp)
+  {
+    insert(first, last);
+  }
+
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  flat_set(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare())
+      : keys_(first, last), comp_(comp)
+  {
+  }
+
+  flat_set(std::initializer_list<value_type> init, const Compare& comp = Compare())
+      : flat_set(init.begin(), init.end(), comp)
+  {
+  }
+
+  flat_set(sorted_unique_t, std::initializer_list<value_type> init, const Compare& comp = Compare())
+      : flat_set(sorted_unique, init.begin(), init.end(), comp)
+  {
+  }
+
+  flat_set& operator=(std::initializer_list<value_type> ilist)
+  {
+    clear();
+    insert(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  // 迭代器
+  iterator begin() const noexcept { return keys_.begin(); }
+
+  const_iterator cbegin() const noexcept { return keys_.begin(); }
+
+  iterator end() const noexcept { return keys_.end(); }
+
+  const_iterator cend() const noexcept { return keys_.end(); }
+
+  reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+  reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+  // 容量
+  bool empty() const noexcept { return keys_.empty(); }
+
+  size_type size() const noexcept { return keys_.size(); }
+
+  size_type max_size() const noexcept { return keys_.max_size(); }
+
+  // 预留空间，适合在批量插入前调用
+  void reserve(size_type new_cap) { keys_.reserve(new_cap); }
+
+  size_type capacity() const noexcept { return keys_.capacity(); }
+
+  void shrink_to_fit() { keys_.shrink_to_fit(); }
+
+  // 修改器
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args)
+  {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value)
+  {
+    auto pos = std::lower_bound(keys_.begin(), keys_.end(), value, comp_);
+    if (pos != keys_.end() && !comp_(value, *pos)) {
+      return {pos, false};
+    }
+    return {keys_.insert(pos, value), true};
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value)
+  {
+    auto pos = std::lower_bound(keys_.begin(), keys_.end(), value, comp_);
+    if (pos != keys_.end() && !comp_(value, *pos)) {
+      return {pos, false};
+    }
+    return {keys_.insert(pos, std::move(value)), true};
+  }
+
+  // 提示正确时（hint的前一个元素小于value且hint不小于value）不需要二分查找
+  iterator insert(const_iterator hint, const value_type& value)
+  {
+    if ((hint == cend() || comp_(value, *hint)) && (hint == cbegin() || comp_(*std::prev(hint), value))) {
+      return keys_.insert(hint, value);
+    }
+    return insert(value).first;
+  }
+
+  iterator insert(const_iterator hint, value_type&& value)
+  {
+    if ((hint == cend() || comp_(value, *hint)) && (hint == cbegin() || comp_(*std::prev(hint), value))) {
+      return keys_.insert(hint, std::move(value));
+    }
+    return insert(std::move(value)).first;
+  }
+
+  // 批量插入：新元素先追加到末尾并排序去重，再与原有元素合并，避免逐个插入时反复移动。
+  // 复制或比较新元素时抛出异常，容器保持原样；合并时抛出异常，容器被清空
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void insert(InputIt first, InputIt last)
+  {
+    const size_type mid = keys_.size();
+    append_sorted(first, last, false);
+    merge_from(mid);
+  }
+
+  // 批量插入已经有序且无重复的元素，只需合并
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void insert(sorted_unique_t, InputIt first, InputIt last)
+  {
+    const size_type mid = keys_.size();
+    append_sorted(first, last, true);
+    merge_from(mid);
+  }
+
+  void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  void insert(sorted_unique_t, std::initializer_list<value_type> ilist)
+  {
+    insert(sorted_unique, ilist.begin(), ilist.end());
+  }
+
+  // 取出底层容器，本容器变为空
+  container_type extract() &&
+  {
+    container_type result = std::move(keys_);
+    keys_.clear();
+    return result;
+  }
+
+  // 替换底层容器，cont必须已经有序且无重复
+  void replace(container_type&& cont) { keys_ = std::move(cont); }
+
+  iterator erase(const_iterator pos) { return keys_.erase(pos); }
+
+  iterator erase(const_iterator first, const_iterator last) { return keys_.erase(first, last); }
+
+  size_type erase(const key_type& key)
+  {
+    auto it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    keys_.erase(it);
+    return 1;
+  }
+
+  void swap(flat_set& other) noexcept
+  {
+    keys_.swap(other.keys_);
+    std::swap(comp_, other.comp_);
+  }
+
+  void clear() noexcept { keys_.clear(); }
+
+  // 观察器
+  key_compare key_comp() const { return comp_; }
+
+  value_compare value_comp() const { return comp_; }
+
+  // 查找（模板重载为异构查找，只在比较器声明is_transparent时启用）
+  iterator find(const key_type& key) const
+  {
+    auto it = lower_bound(key);
+    return (it != end() && !comp_(key, *it)) ? it : end();
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator find(const K& x) const
+  {
+    auto it = lower_bound(x);
+    return (it != end() && !comp_(x, *it)) ? it : end();
+  }
+
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  size_type count(const K& x) const
+  {
+    return contains(x) ? 1 : 0;
+  }
+
+  bool contains(const key_type& key) const { return find(key) != end(); }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  bool contains(const K& x) const
+  {
+    return find(x) != end();
+  }
+
+  iterator lower_bound(const key_type& key) const
+  {
+    return std::lower_bound(keys_.begin(), keys_.end(), key, comp_);
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator lower_bound(const K& x) const
+  {
+    return std::lower_bound(keys_.begin(), keys_.end(), x, comp_);
+  }
+
+  iterator upper_bound(const key_type& key) const
+  {
+    return std::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  iterator upper_bound(const K& x) const
+  {
+    return std::upper_bound(keys_.begin(), keys_.end(), x, comp_);
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key) const
+  {
+    auto it = lower_bound(key);
+    return {it, (it != end() && !comp_(key, *it)) ? std::next(it) : it};
+  }
+
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& x) const
+  {
+    return {lower_bound(x), upper_bound(x)};
+  }
+
+  // 比较运算符
+  friend bool operator==(const flat_set& lhs, const flat_set& rhs) { return lhs.keys_ == rhs.keys_; }
+
+  friend bool operator!=(const flat_set& lhs, const flat_set& rhs) { return !(lhs == rhs); }
+
+  friend bool operator<(const flat_set& lhs, const flat_set& rhs)
+  {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend bool operator<=(const flat_set& lhs, const flat_set& rhs) { return !(rhs < lhs); }
+
+  friend bool operator>(const flat_set& lhs, const flat_set& rhs) { return rhs < lhs; }
+
+  friend bool operator>=(const flat_set& lhs, const flat_set& rhs) { return !(lhs < rhs); }
+};
+
+// 特化的swap函数
+template <typename Key, typename Compare, typename KeyContainer>
+void swap(flat_set<Key, Compare, KeyContainer>& lhs, flat_set<Key, Compare, KeyContainer>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+// 只包含底层容器和比较器，二者都可以按字节搬迁时整体也可以
+template <typename Key, typename Compare, typename KeyContainer>
+struct is_trivially_relocatable<flat_set<Key, Compare, KeyContainer>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<Compare>::value
+                                 && is_trivially_relocatable<KeyContainer>::value> {
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_FLAT_SET_HPP
@@ -0,0 +1,90 @@
+#ifndef SJKXQ_STL_GROWTH_POLICY_HPP
+#define SJKXQ_STL_GROWTH_POLICY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace sjkxq_stl
+{
+
+/*
+ * 容量增长策略
+ *
+ * vector在插入导致容量不足时通过策略计算新容量，策略需要提供：
+ *   static size_type next_capacity(size_type capacity, size_type new_size,
+ *                                  size_type max_size, size_type value_size) noexcept;
+ * 其中capacity为当前容量，new_size为本次操作需要的元素数（不超过max_size），value_size为单个元素的字节数。
+ * 返回值必须在[new_size, max_size]之内。reserve和shrink_to_fit按请求的精确值分配，不经过策略。
+ */
+
+// 默认策略：容量小于4096时翻倍，之后每次增加50%，最小容量为16
+struct default_growth
+{
+  using size_type = std::size_t;
+
+  static size_type next_capacity(size_type capacity, size_type new_size,
+                                 size_type max_size, size_type /*value_size*/) noexcept
+  {
+    if (capacity >= max_size / 2) {
+      return max_size;
+    }
+    size_type growth = capacity < 4096 ? capacity * 2 : capacity + capacity / 2;
+    return std::min(std::max({growth, new_size, size_type(16)}), max_size);
+  }
+};
+
+// 始终按1.5倍增长，没有最小容量，适合对内存占用敏感的场景
+struct half_growth
+{
+  using size_type = std::size_t;
+
+  static size_type next_capacity(size_type capacity, size_type new_size,
+                                 size_type max_size, size_type /*value_size*/) noexcept
+  {
+    if (capacity >= max_size / 3 * 2) {
+      return max_size;
+    }
+    return std::min(std::max(capacity + capacity / 2, new_size), max_size);
+  }
+};
+
+// 按默认策略增长后把占用的字节数向上取整到整页：不超过2MiB时按4KiB对齐，否则按2MiB对齐，
+// 使大块内存能完整地映射到透明大页上。小容量时也至少占满一个4KiB页
+struct page_aligned_growth
+{
+  using size_type = std::size_t;
+
+  static constexpr size_type small_page = size_type(4) << 10;
+  static constexpr size_type huge_page  = size_type(2) << 20;
+
+  static size_type next_capacity(size_type capacity, size_type new_size,
+                                 size_type max_size, size_type value_size) noexcept
+  {
+    size_type target = default_growth::next_capacity(capacity, new_size, max_size, value_size);
+    if (target > (std::numeric_limits<size_type>::max() - huge_page) / value_size) {
+      return target;  // 取整后的字节数可能溢出，不再对齐
+    }
+    size_type bytes = target * value_size;
+    size_type page  = bytes > huge_page ? huge_page : small_page;
+    bytes           = (bytes + page - 1) / page * page;
+    return std::min(std::max(bytes / value_size, target), max_size);
+  }
+};
+
+// 精确分配：容量恰好等于需要的元素数，不留任何余量。
+// 逐个追加元素时每次都会重新分配，只适合大小预先可知或很少增长的场景
+struct exact_growth
+{
+  using size_type = std::size_t;
+
+  static size_type next_capacity(size_type /*capacity*/, size_type new_size,
+                                 size_type /*max_size*/, size_type /*value_size*/) noexcept
+  {
+    return new_size;
+  }
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_GROWTH_POLICY_HPP
@@ -0,0 +1,268 @@
+#ifndef SJKXQ_STL_HASH_POLICY_HPP
+#define SJKXQ_STL_HASH_POLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sjkxq_stl
+{
+
+// 对用户哈希值做一次混合（MurmurHash3 的 finalizer）
+// std::hash 对整数通常是恒等映射，直接取低位/高位会导致大量冲突，混合后每一位都依赖全部输入位
+inline std::size_t hash_mix(std::size_t h) noexcept
+{
+  if constexpr (sizeof(std::size_t) >= 8) {
+    std::uint64_t x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+  } else {
+    std::uint32_t x = static_cast<std::uint32_t>(h);
+    x ^= x >> 16;
+    x *= 0x85ebca6bU;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35U;
+    x ^= x >> 16;
+    return x;
+  }
+}
+
+/*
+ * 桶下标策略
+ *
+ * 链式哈希表通过策略对象把哈希值映射到桶下标，策略需要提供：
+ *   size_type adjust(size_type n);                  // 把n调整为策略支持的桶数（不小于n）并记录下来
+ *   size_type index(std::size_t hash) const noexcept; // 按最近一次adjust的桶数计算下标
+ * rehash时先在策略副本上调用adjust，新桶数组建好后再替换原策略，因此adjust抛出异常不会破坏容器。
+ */
+
+// 桶数取2的幂，用位与代替取模；先混合哈希值，避免恒等哈希的整数键只落在少数桶里
+class power_of_two_bucket_policy
+{
+public:
+  using size_type = std::size_t;
+
+  size_type adjust(size_type n)
+  {
+    constexpr size_type max_count = (std::numeric_limits<size_type>::max() >> 1) + 1;
+    if (n > max_count) {
+      throw std::length_error("power_of_two_bucket_policy: bucket count too large");
+    }
+    size_type count = 1;
+    while (count < n) {
+      count <<= 1;
+    }
+    mask_ = count - 1;
+    return count;
+  }
+
+  size_type index(std::size_t hash) const noexcept { return hash_mix(hash) & mask_; }
+
+private:
+  size_type mask_ = 0;
+};
+
+// 桶数取素数，不对哈希值做混合。
+// 取模时按素数表下标分派到除数为字面常量的分支，编译器会把除法替换成乘法和移位
+class prime_bucket_policy
+{
+public:
+  using size_type = std::size_t;
+
+  size_type adjust(size_type n)
+  {
+    std::size_t i = 0;
+    while (i < prime_count && primes_[i] < n) {
+      ++i;
+    }
+    if (i == prime_count || primes_[i] > std::numeric_limits<size_type>::max()) {
+      throw std::length_error("prime_bucket_policy: bucket count too large");
+    }
+    prime_index_ = i;
+    return static_cast<size_type>(primes_[i]);
+  }
+
+  size_type index(std::size_t hash) const noexcept
+  {
+    return static_cast<size_type>(mod(static_cast<std::uint64_t>(hash), prime_index_));
+  }
+
+private:
+  static constexpr std::size_t prime_count = 61;
+
+  // 每项是大于2^k的最小素数（k = 3, 4, ..., 63），相邻两项约为两倍关系
+  static constexpr std::uint64_t primes_[prime_count] = {
+    11ULL,
+    17ULL,
+    37ULL,
+    67ULL,
+    131ULL,
+    257ULL,
+    521ULL,
+    1031ULL,
+    2053ULL,
+    4099ULL,
+    8209ULL,
+    16411ULL,
+    32771ULL,
+    65537ULL,
+    131101ULL,
+    262147ULL,
+    524309ULL,
+    1048583ULL,
+    2097169ULL,
+    4194319ULL,
+    8388617ULL,
+    16777259ULL,
+    33554467ULL,
+    67108879ULL,
+    134217757ULL,
+    268435459ULL,
+    536870923ULL,
+    1073741827ULL,
+    2147483659ULL,
+    4294967311ULL,
+    8589934609ULL,
+    17179869209ULL,
+    34359738421ULL,
+    68719476767ULL,
+    137438953481ULL,
+    274877906951ULL,
+    549755813911ULL,
+    1099511627791ULL,
+    2199023255579ULL,
+    4398046511119ULL,
+    8796093022237ULL,
+    17592186044423ULL,
+    35184372088891ULL,
+    70368744177679ULL,
+    140737488355333ULL,
+    281474976710677ULL,
+    562949953421381ULL,
+    1125899906842679ULL,
+    2251799813685269ULL,
+    4503599627370517ULL,
+    9007199254740997ULL,
+    18014398509482143ULL,
+    36028797018963971ULL,
+    72057594037928017ULL,
+    144115188075855881ULL,
+    288230376151711813ULL,
+    576460752303423619ULL,
+    1152921504606847009ULL,
+    2305843009213693967ULL,
+    4611686018427388039ULL,
+    9223372036854775837ULL};
+
+  // 除数直接取自primes_，只有下标写在分支里：下标是常量，primes_[i]仍是编译期常量。
+  // 分支与素数表一一对应，增删素数时要同步调整下面的static_assert和分支
+  static_assert(prime_count == 61, "prime_bucket_policy::mod must have one case per prime");
+
+  static std::uint64_t mod(std::uint64_t h, std::size_t prime_index) noexcept
+  {
+    switch (prime_index) {
+    case 0: return h % primes_[0];
+    case 1: return h % primes_[1];
+    case 2: return h % primes_[2];
+    case 3: return h % primes_[3];
+    case 4: return h % primes_[4];
+    case 5: return h % primes_[5];
+    case 6: return h % primes_[6];
+    case 7: return h % primes_[7];
+    case 8: return h % primes_[8];
+    case 9: return h % primes_[9];
+    case 10: return h % primes_[10];
+    case 11: return h % primes_[11];
+    case 12: return h % primes_[12];
+    case 13: return h % primes_[13];
+    case 14: return h % primes_[14];
+    case 15: return h % primes_[15];
+    case 16: return h % primes_[16];
+    case 17: return h % primes_[17];
+    case 18: return h % primes_[18];
+    case 19: return h % primes_[19];
+    case 20: return h % primes_[20];
+    case 21: return h % primes_[21];
+    case 22: return h % primes_[22];
+    case 23: return h % primes_[23];
+    case 24: return h % primes_[24];
+    case 25: return h % primes_[25];
+    case 26: return h % primes_[26];
+    case 27: return h % primes_[27];
+    case 28: return h % primes_[28];
+    case 29: return h % primes_[29];
+    case 30: return h % primes_[30];
+    case 31: return h % primes_[31];
+    case 32: return h % primes_[32];
+    case 33: return h % primes_[33];
+    case 34: return h % primes_[34];
+    case 35: return h % primes_[35];
+    case 36: return h % primes_[36];
+    case 37: return h % primes_[37];
+    case 38: return h % primes_[38];
+    case 39: return h % primes_[39];
+    case 40: return h % primes_[40];
+    case 41: return h % primes_[41];
+    case 42: return h % primes_[42];
+    case 43: return h % primes_[43];
+    case 44: return h % primes_[44];
+    case 45: return h % primes_[45];
+    case 46: return h % primes_[46];
+    case 47: return h % primes_[47];
+    case 48: return h % primes_[48];
+    case 49: return h % primes_[49];
+    case 50: return h % primes_[50];
+    case 51: return h % primes_[51];
+    case 52: return h % primes_[52];
+    case 53: return h % primes_[53];
+    case 54: return h % primes_[54];
+    case 55: return h % primes_[55];
+    case 56: return h % primes_[56];
+    case 57: return h % primes_[57];
+    case 58: return h % primes_[58];
+    case 59: return h % primes_[59];
+    // prime_index_只由adjust设置，不会超过60
+    default: return h % primes_[60];
+    }
+  }
+
+  std::size_t prime_index_ = 0;
+};
+
+/*
+ * 链式哈希表的节点是否保存键的完整哈希值（可由用户特化）
+ *
+ * 保存后rehash和merge不必再调用哈希函数，沿链查找时也可以先比较哈希值，只有相等时才调用key_equal。
+ * 默认只有使用std::hash的算术类型、枚举和指针不保存：它们的哈希和比较都只需几条指令，多占的8字节不划算。
+ */
+template <typename Key, typename Hash>
+struct cache_hash_code
+    : std::integral_constant<bool,
+                             !((std::is_arithmetic<Key>::value || std::is_enum<Key>::value
+                                || std::is_pointer<Key>::value)
+                               && std::is_same<Hash, std::hash<Key>>::value)> {
+};
+
+template <typename Key, typename Hash>
+inline constexpr bool cache_hash_code_v = cache_hash_code<Key, Hash>::value;
+
+// 节点中保存哈希值的位置，不缓存时是空基类，不占空间
+template <bool Cache>
+struct hash_code_storage {
+  std::size_t hash_code = 0;
+};
+
+template <>
+struct hash_code_storage<false> {
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_HASH_POLICY_HPP
@@ -0,0 +1,971 @@
+#ifndef SJKXQ_STL_HASHTABLE_HPP
+#define SJKXQ_STL_HASHTABLE_HPP
+
+#include <functional>  // for std::hash, std::equal_to
+#include <memory>     // for std::allocator
+#include <utility>    // for std::pair
+#include <cstddef>    // for size_t
+#include <iterator>   // for iterator tags
+#include <limits>     // for std::numeric_limits
+#include <cmath>      // for std::ceil
+#include <algorithm>  // for std::fill, std::max
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include "../common.hpp"
+#include "../hash_policy.hpp"
+#include "../container_base/node_pool.hpp"
+
+namespace sjkxq_stl {
+
+/**
+ * @brief 链式哈希表核心
+ *
+ * unordered_set 与 unordered_map 共用此实现，对哈希、桶和节点的任何调整会同时作用于两者。
+ * Policy 描述元素类型以及如何从元素中取出键：
+ *   key_type、value_type、constant_values（迭代器是否只读）、
+ *   static const key_type& key(const value_type&)、
+ *   static bool mapped_equal(const value_type&, const value_type&)（供比较运算符使用）
+ *
+ * 节点从 node_pool 中分配；桶下标由 BucketPolicy 计算；
+ * cache_hash_code<key_type, Hash> 为真时节点保存完整哈希值，rehash 不再调用哈希函数，
+ * 哈希函数无状态时 merge 也不再调用。
+ */
+template <typename Policy, typename Hash, typename KeyEqual, typename Allocator, typename BucketPolicy>
+class hashtable {
+public:
+    // 类型定义
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using bucket_policy = BucketPolicy;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+private:
+    static constexpr bool cache_hash = cache_hash_code<key_type, Hash>::value;
+
+    // 节点结构；cache_hash为true时还保存键的完整哈希值
+    struct Node : hash_code_storage<cache_hash> {
+        value_type value;
+        Node* next;
+
+        template <typename... Args>
+        explicit Node(Args&&... args) : value(std::forward<Args>(args)...), next(nullptr) {}
+    };
+
+    using node_pool_type = node_pool<Node, Allocator>;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+    using bucket_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node*>;
+    using bucket_traits = std::allocator_traits<bucket_allocator>;
+
+public:
+    // 节点句柄类型
+    class node_type {
+    private:
+        // 节点仍在容器内存池的slab中，句柄单独持有该slab的引用，因此可以比容器活得更久
+        friend class hashtable;
+        using slab_ref = typename node_pool_type::slab_ref;
+
+        Node* node_;
+        slab_ref slab_;
+        node_allocator alloc_;
+
+        node_type(Node* node, slab_ref slab, const node_allocator& alloc) noexcept
+            : node_(node), slab_(slab), alloc_(alloc) {}
+
+        void reset() noexcept {
+            if (node_) {
+                node_traits::destroy(alloc_, node_);
+                node_pool_type::release_slab(slab_, alloc_);
+                node_ = nullptr;
+            }
+        }
+
+    public:
+        node_type() noexcept : node_(nullptr), slab_(nullptr), alloc_() {}
+        node_type(node_type&& other) noexcept
+            : node_(other.node_), slab_(other.slab_), alloc_(std::move(other.alloc_)) {
+            other.node_ = nullptr;
+        }
+
+        ~node_type() {
+            reset();
+        }
+
+        node_type& operator=(node_type&& other) noexcept {
+            if (this != &other) {
+                reset();
+                node_ = other.node_;
+                slab_ = other.slab_;
+                // 节点总是随自己的分配器一起转移；分配器可能不可赋值（如pmr），原地重建
+                alloc_.~node_allocator();
+                ::new (static_cast<void*>(std::addressof(alloc_))) node_allocator(std::move(other.alloc_));
+                other.node_ = nullptr;
+            }
+            return *this;
+        }
+
+        bool empty() const noexcept { return !node_; }
+        explicit operator bool() const noexcept { return !empty(); }
+
+        value_type& value() const {
+            if (!node_) {
+                throw std::runtime_error("Accessing empty node");
+            }
+            return node_->value;
+        }
+
+        // 禁用复制操作
+        node_type(const node_type&) = delete;
+        node_type& operator=(const node_type&) = delete;
+    };
+
+    // 迭代器：记录当前节点和它所在的桶，到达链表末尾时转到下一个非空桶
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const || Policy::constant_values, const value_type*, value_type*>;
+        using reference = std::conditional_t<Const || Policy::constant_values, const value_type&, value_type&>;
+
+        basic_iterator() noexcept : node_(nullptr), container_(nullptr), bucket_idx_(0) {}
+
+        // 非const迭代器可以隐式转换为const迭代器
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false>& it) noexcept
+            : node_(it.node_), container_(it.container_), bucket_idx_(it.bucket_idx_) {}
+
+        reference operator*() const { return node_->value; }
+        pointer operator->() const { return &(node_->value); }
+
+        basic_iterator& operator++() {
+            if (node_) {  // end()迭代器保持不动
+                node_ = container_->next_node(node_, bucket_idx_);
+            }
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) {
+            return lhs.node_ == rhs.node_;
+        }
+
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class hashtable;
+        friend class basic_iterator<!Const>;
+        using node_pointer = std::conditional_t<Const, const Node*, Node*>;
+
+        node_pointer node_;
+        const hashtable* container_;
+        size_type bucket_idx_;
+
+        basic_iterator(node_pointer node, const hashtable* container, size_type bucket_idx)
+            : node_(node), container_(container), bucket_idx_(bucket_idx) {}
+    };
+
+    // 桶迭代器：只沿一个桶的链表前进
+    template <bool Const>
+    class basic_local_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const || Policy::constant_values, const value_type*, value_type*>;
+        using reference = std::conditional_t<Const || Policy::constant_values, const value_type&, value_type&>;
+
+        basic_local_iterator() noexcept : node_(nullptr) {}
+
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_local_iterator(const basic_local_iterator<false>& it) noexcept : node_(it.node_) {}
+
+        reference operator*() const { return node_->value; }
+        pointer operator->() const { return &(node_->value); }
+
+        basic_local_iterator& operator++() {
+            node_ = node_->next;
+            return *this;
+        }
+
+        basic_local_iterator operator++(int) {
+            basic_local_iterator tmp = *this;
+            node_ = node_->next;
+            return tmp;
+        }
+
+        friend bool operator==(const basic_local_iterator& lhs, const basic_local_iterator& rhs) {
+            return lhs.node_ == rhs.node_;
+        }
+
+        friend bool operator!=(const basic_local_iterator& lhs, const basic_local_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class hashtable;
+        friend class basic_local_iterator<!Const>;
+        using node_pointer = std::conditional_t<Const, const Node*, Node*>;
+
+        node_pointer node_;
+
+        explicit basic_local_iterator(node_pointer node) : node_(node) {}
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using local_iterator = basic_local_iterator<false>;
+    using const_local_iterator = basic_local_iterator<true>;
+
+private:
+    // 基本成员变量
+    Node** buckets_;          // 桶数组
+    size_type bucket_count_;  // 桶数量
+    size_type size_;         // 元素数量
+    float max_load_factor_;  // 最大负载因子
+    hasher hash_function_;   // 哈希函数对象
+    key_equal key_equal_;    // 键比较函数对象
+    bucket_policy policy_;   // 哈希值到桶下标的映射，与bucket_count_保持一致
+    node_pool_type pool_;    // 节点内存池，同时保存分配器
+
+    Node** allocate_buckets(size_type n) {
+        bucket_allocator alloc(pool_.get_allocator());
+        Node** buckets = bucket_traits::allocate(alloc, n);
+        std::fill(buckets, buckets + n, nullptr);
+        return buckets;
+    }
+
+    void deallocate_buckets() noexcept {
+        if (buckets_) {
+            bucket_allocator alloc(pool_.get_allocator());
+            bucket_traits::deallocate(alloc, buckets_, bucket_count_);
+        }
+    }
+
+    // 节点中键的哈希值：有缓存时直接读取，不调用哈希函数
+    std::size_t node_hash(const Node* node) const {
+        if constexpr (cache_hash) {
+            return node->hash_code;
+        } else {
+            return hash_function_(Policy::key(node->value));
+        }
+    }
+
+    void set_node_hash(Node* node, std::size_t hash) const noexcept {
+        if constexpr (cache_hash) {
+            node->hash_code = hash;
+        }
+    }
+
+    // 判断节点的键是否等于key，有缓存时先比较哈希值，不相等就不必调用key_equal
+    bool node_matches(const Node* node, std::size_t hash, const key_type& key) const {
+        if constexpr (cache_hash) {
+            if (node->hash_code != hash) {
+                return false;
+            }
+        }
+        return key_equal_(Policy::key(node->value), key);
+    }
+
+    // 在哈希值为hash的键所在的桶中查找节点，同时通过bucket_idx返回桶下标
+    Node* find_node(const key_type& key, std::size_t hash, size_type& bucket_idx) const {
+        if (bucket_count_ == 0) return nullptr;
+
+        bucket_idx = policy_.index(hash);
+        for (Node* current = buckets_[bucket_idx]; current; current = current->next) {
+            if (node_matches(current, hash, key)) {
+                return current;
+            }
+        }
+        return nullptr;
+    }
+
+    Node* find_node(const key_type& key, size_type& bucket_idx) const {
+        return find_node(key, hash_function_(key), bucket_idx);
+    }
+
+    Node* find_node(const key_type& key) const {
+        size_type bucket_idx;
+        return find_node(key, bucket_idx);
+    }
+
+    // 迭代器前进：同一桶链表中的下一个节点，或者后面第一个非空桶的首节点
+    Node* next_node(const Node* node, size_type& bucket_idx) const noexcept {
+        if (node->next) {
+            return node->next;
+        }
+        while (++bucket_idx < bucket_count_) {
+            if (buckets_[bucket_idx]) {
+                return buckets_[bucket_idx];
+            }
+        }
+        return nullptr;
+    }
+
+    // 再插入一个元素会超过最大负载因子时扩容
+    void grow_if_needed() {
+        if (size_ + 1 > bucket_count_ * max_load_factor_) {
+            rehash(bucket_count_ * 2);
+        }
+    }
+
+    // 把新节点挂到桶链表头部，调用前应已完成扩容
+    iterator link_node(Node* node, std::size_t hash) noexcept {
+        set_node_hash(node, hash);
+        size_type bucket_idx = policy_.index(hash);
+        node->next = buckets_[bucket_idx];
+        buckets_[bucket_idx] = node;
+        ++size_;
+        return iterator(node, this, bucket_idx);
+    }
+
+    // 从桶链表中摘下节点，返回它之后的迭代器
+    iterator unlink_node(const Node* target, size_type bucket_idx) {
+        Node** link = &buckets_[bucket_idx];
+        while (*link != target) {
+            link = &(*link)->next;
+        }
+        Node* node = *link;
+        iterator next(node, this, bucket_idx);
+        ++next;
+        *link = node->next;
+        --size_;
+        pool_.destroy(node);
+        return next;
+    }
+
+protected:
+    // 键不存在时才用args构造元素；哈希值只计算一次，需要扩容时也不重新计算
+    template <typename... Args>
+    std::pair<iterator, bool> insert_unique(const key_type& key, Args&&... args) {
+        std::size_t hash = hash_function_(key);
+        size_type bucket_idx;
+        if (Node* existing = find_node(key, hash, bucket_idx)) {
+            return {iterator(existing, this, bucket_idx), false};
+        }
+
+        grow_if_needed();
+        Node* node = pool_.create(std::forward<Args>(args)...);
+        return {link_node(node, hash), true};
+    }
+
+public:
+    // 构造函数
+    hashtable() : hashtable(16) {}  // 默认16个桶
+
+    explicit hashtable(size_type bucket_count,
+                       const hasher& hash = hasher(),
+                       const key_equal& equal = key_equal(),
+                       const allocator_type& alloc = allocator_type())
+        : buckets_(nullptr)
+        , bucket_count_(0)
+        , size_(0)
+        , max_load_factor_(1.0f)
+        , hash_function_(hash)
+        , key_equal_(equal)
+        , pool_(alloc) {
+        rehash(bucket_count);
+    }
+
+    hashtable(size_type bucket_count, const allocator_type& alloc)
+        : hashtable(bucket_count, hasher(), key_equal(), alloc) {}
+
+    hashtable(size_type bucket_count, const hasher& hash, const allocator_type& alloc)
+        : hashtable(bucket_count, hash, key_equal(), alloc) {}
+
+    explicit hashtable(const allocator_type& alloc)
+        : hashtable(16, hasher(), key_equal(), alloc) {}
+
+    template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    hashtable(InputIt first, InputIt last,
+              size_type bucket_count = 16,
+              const hasher& hash = hasher(),
+              const key_equal& equal = key_equal(),
+              const allocator_type& alloc = allocator_type())
+        : hashtable(bucket_count, hash, equal, alloc) {
+        insert(first, last);
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    hashtable(InputIt first, InputIt last, size_type bucket_count, const allocator_type& alloc)
+        : hashtable(first, last, bucket_count, hasher(), key_equal(), alloc) {}
+
+    template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    hashtable(InputIt first, InputIt last, size_type bucket_count,
+              const hasher& hash, const allocator_type& alloc)
+        : hashtable(first, last, bucket_count, hash, key_equal(), alloc) {}
+
+    hashtable(std::initializer_list<value_type> init,
+              size_type bucket_count = 16,
+              const hasher& hash = hasher(),
+              const key_equal& equal = key_equal(),
+              const allocator_type& alloc = allocator_type())
+        : hashtable(init.begin(), init.end(), bucket_count, hash, equal, alloc) {}
+
+    hashtable(std::initializer_list<value_type> init, size_type bucket_count, const allocator_type& alloc)
+        : hashtable(init.begin(), init.end(), bucket_count, hasher(), key_equal(), alloc) {}
+
+    hashtable(std::initializer_list<value_type> init, size_type bucket_count,
+              const hasher& hash, const allocator_type& alloc)
+        : hashtable(init.begin(), init.end(), bucket_count, hash, key_equal(), alloc) {}
+
+    hashtable(const hashtable& other)
+        : hashtable(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(
+                               other.get_allocator())) {}
+
+    hashtable(const hashtable& other, const allocator_type& alloc)
+        : buckets_(nullptr)
+        , bucket_count_(0)
+        , size_(0)
+        , max_load_factor_(other.max_load_factor_)
+        , hash_function_(other.hash_function_)
+        , key_equal_(other.key_equal_)
+        , policy_(other.policy_)
+        , pool_(alloc) {
+        rehash(other.bucket_count_);
+        for (const auto& value : other) {
+            insert(value);
+        }
+    }
+
+    hashtable(hashtable&& other) noexcept
+        : buckets_(other.buckets_)
+        , bucket_count_(other.bucket_count_)
+        , size_(other.size_)
+        , max_load_factor_(other.max_load_factor_)
+        , hash_function_(std::move(other.hash_function_))
+        , key_equal_(std::move(other.key_equal_))
+        , policy_(other.policy_)
+        , pool_(std::move(other.pool_)) {
+        other.buckets_ = nullptr;
+        other.bucket_count_ = 0;
+        other.size_ = 0;
+    }
+
+    // 分配器相等时直接接管桶数组和内存池；不相等时节点属于各自的内存池，只能逐个移动元素
+    hashtable(hashtable&& other, const allocator_type& alloc)
+        : buckets_(nullptr)
+        , bucket_count_(0)
+        , size_(0)
+        , max_load_factor_(other.max_load_factor_)
+        , hash_function_(other.hash_function_)
+        , key_equal_(other.key_equal_)
+        , policy_(other.policy_)
+        , pool_(alloc) {
+        if (pool_.get_allocator() == other.pool_.get_allocator()) {
+            buckets_ = other.buckets_;
+            bucket_count_ = other.bucket_count_;
+            size_ = other.size_;
+            pool_ = std::move(other.pool_);
+
+            other.buckets_ = nullptr;
+            other.bucket_count_ = 0;
+            other.size_ = 0;
+        } else {
+            rehash(other.bucket_count_);
+            for (size_type i = 0; i < other.bucket_count_; ++i) {
+                for (Node* current = other.buckets_[i]; current; current = current->next) {
+                    link_node(pool_.create(std::move(current->value)), other.node_hash(current));
+                }
+            }
+            other.clear();
+        }
+    }
+
+    // 分配器随复制传播且两者不相等时，桶数组和slab都要先用原来的分配器归还
+    hashtable& operator=(const hashtable& other) {
+        if (this != &other) {
+            clear();
+            if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+                if (!(pool_.get_allocator() == other.pool_.get_allocator())) {
+                    deallocate_buckets();
+                    buckets_ = nullptr;
+                    bucket_count_ = 0;
+                }
+                pool_.copy_allocator_from(other.pool_);
+            }
+            max_load_factor_ = other.max_load_factor_;
+            hash_function_ = other.hash_function_;
+            key_equal_ = other.key_equal_;
+            rehash(other.bucket_count_);
+            for (const auto& value : other) {
+                insert(value);
+            }
+        }
+        return *this;
+    }
+
+    // 分配器不传播且与other的不相等时，与带分配器的移动构造一样逐个移动元素
+    hashtable& operator=(hashtable&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+        || std::allocator_traits<Allocator>::is_always_equal::value) {
+        if (this != &other && !allocator_can_steal(pool_.get_allocator(), other.pool_.get_allocator())) {
+            clear();
+            max_load_factor_ = other.max_load_factor_;
+            hash_function_ = other.hash_function_;
+            key_equal_ = other.key_equal_;
+            rehash(other.bucket_count_);
+            for (size_type i = 0; i < other.bucket_count_; ++i) {
+                for (Node* current = other.buckets_[i]; current; current = current->next) {
+                    link_node(pool_.create(std::move(current->value)), other.node_hash(current));
+                }
+            }
+            other.clear();
+        } else if (this != &other) {
+            clear();
+            deallocate_buckets();
+
+            buckets_ = other.buckets_;
+            bucket_count_ = other.bucket_count_;
+            size_ = other.size_;
+            max_load_factor_ = other.max_load_factor_;
+            hash_function_ = std::move(other.hash_function_);
+            key_equal_ = std::move(other.key_equal_);
+            policy_ = other.policy_;
+            pool_ = std::move(other.pool_);
+
+            other.buckets_ = nullptr;
+            other.bucket_count_ = 0;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    hashtable& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    // 析构函数
+    ~hashtable() {
+        clear();
+        deallocate_buckets();
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return pool_.get_allocator();
+    }
+
+    // 基本容量操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept {
+        return std::numeric_limits<size_type>::max() / sizeof(Node);
+    }
+
+    // 哈希策略
+    float load_factor() const noexcept {
+        return bucket_count_ ? static_cast<float>(size_) / bucket_count_ : 0.0f;
+    }
+
+    float max_load_factor() const noexcept {
+        return max_load_factor_;
+    }
+
+    void max_load_factor(float ml) {
+        max_load_factor_ = ml;
+    }
+
+    // 迭代器操作
+    iterator begin() noexcept {
+        // 找到第一个非空桶
+        if (size_ != 0) {
+            for (size_type i = 0; i < bucket_count_; ++i) {
+                if (buckets_[i]) {
+                    return iterator(buckets_[i], this, i);
+                }
+            }
+        }
+        return end();
+    }
+
+    const_iterator begin() const noexcept {
+        return cbegin();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return const_cast<hashtable*>(this)->begin();
+    }
+
+    iterator end() noexcept {
+        return iterator(nullptr, this, bucket_count_);
+    }
+
+    const_iterator end() const noexcept {
+        return cend();
+    }
+
+    const_iterator cend() const noexcept {
+        return const_iterator(nullptr, this, bucket_count_);
+    }
+
+    // 桶迭代器
+    local_iterator begin(size_type n) {
+        return local_iterator(buckets_[n]);
+    }
+
+    const_local_iterator begin(size_type n) const {
+        return const_local_iterator(buckets_[n]);
+    }
+
+    const_local_iterator cbegin(size_type n) const {
+        return const_local_iterator(buckets_[n]);
+    }
+
+    local_iterator end(size_type) {
+        return local_iterator(nullptr);
+    }
+
+    const_local_iterator end(size_type) const {
+        return const_local_iterator(nullptr);
+    }
+
+    const_local_iterator cend(size_type) const {
+        return const_local_iterator(nullptr);
+    }
+
+    // 元素操作
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert_unique(Policy::key(value), value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_unique(Policy::key(value), std::move(value));
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return insert(value).first;
+    }
+
+    iterator insert(const_iterator, value_type&& value) {
+        return insert(std::move(value)).first;
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // 先在池中构造节点再按它的键查找，键已存在时节点直接回收
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        Node* node = pool_.create(std::forward<Args>(args)...);
+        const key_type& key = Policy::key(node->value);
+        std::size_t hash;
+        size_type bucket_idx;
+        try {
+            hash = hash_function_(key);
+            if (Node* existing = find_node(key, hash, bucket_idx)) {
+                pool_.destroy(node);
+                return {iterator(existing, this, bucket_idx), false};
+            }
+            grow_if_needed();
+        } catch (...) {
+            pool_.destroy(node);
+            throw;
+        }
+        return {link_node(node, hash), true};
+    }
+
+    template<typename... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        // 位置由哈希函数决定，hint被忽略
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    iterator erase(const_iterator pos) {
+        if (pos == cend()) {
+            return end();
+        }
+        return unlink_node(pos.node_, pos.bucket_idx_);
+    }
+
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(const_cast<Node*>(last.node_), this, last.bucket_idx_);
+    }
+
+    size_type erase(const key_type& key) {
+        size_type bucket_idx;
+        Node* node = find_node(key, bucket_idx);
+        if (!node) {
+            return 0;
+        }
+        unlink_node(node, bucket_idx);
+        return 1;
+    }
+
+    // 提取节点
+    node_type extract(const_iterator position) {
+        if (position == cend()) {
+            return node_type();
+        }
+
+        // 迭代器记录了节点所在的桶，不需要重新计算哈希
+        size_type bucket_idx = position.bucket_idx_;
+        Node** link = &buckets_[bucket_idx];
+        while (*link != position.node_) {
+            link = &(*link)->next;
+        }
+        Node* node = *link;
+
+        // 节点原地交给句柄，元素不移动，指向它的指针和引用保持有效
+        *link = node->next;
+        --size_;
+        return node_type(node, pool_.retain(node), node_allocator(pool_.get_allocator()));
+    }
+
+    node_type extract(const key_type& key) {
+        return extract(find(key));
+    }
+
+    iterator find(const key_type& key) {
+        size_type bucket_idx;
+        Node* node = find_node(key, bucket_idx);
+        if (node) {
+            return iterator(node, this, bucket_idx);
+        }
+        return end();
+    }
+
+    const_iterator find(const key_type& key) const {
+        return const_cast<hashtable*>(this)->find(key);
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {
+        iterator it = find(key);
+        if (it == end()) {
+            return {it, it};
+        }
+        iterator next = it;
+        ++next;
+        return {it, next};
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        auto range = const_cast<hashtable*>(this)->equal_range(key);
+        return {range.first, range.second};
+    }
+
+    size_type count(const key_type& key) const {
+        return find_node(key) ? 1 : 0;
+    }
+
+    bool contains(const key_type& key) const {
+        return find_node(key) != nullptr;
+    }
+
+    // 键可以平凡析构时不必逐个访问节点，直接把内存池中的slab整体归还
+    void clear() {
+        for (size_type i = 0; i < bucket_count_; ++i) {
+            if constexpr (!std::is_trivially_destructible<value_type>::value) {
+                Node* current = buckets_[i];
+                while (current) {
+                    Node* next = current->next;
+                    current->~Node();
+                    current = next;
+                }
+            }
+            buckets_[i] = nullptr;
+        }
+        pool_.release();
+        size_ = 0;
+    }
+
+    void rehash(size_type count) {
+        size_type new_bucket_count = std::max(count, size_type(1));
+
+        // 如果新的桶数量小于当前元素数量除以最大负载因子，调整桶数量
+        if (new_bucket_count < size_ / max_load_factor_) {
+            new_bucket_count = std::ceil(size_ / max_load_factor_);
+        }
+
+        // 避免过度收缩，确保新的桶数量不小于当前桶数量的一半
+        // 除非新的桶数量是1（最小值）
+        if (new_bucket_count < bucket_count_ / 2 && new_bucket_count > 1) {
+            new_bucket_count = bucket_count_ / 2;
+        }
+
+        // 由策略调整为它支持的桶数（2的幂或素数）；先在副本上调整，分配失败时原策略保持不变
+        bucket_policy new_policy = policy_;
+        new_bucket_count = new_policy.adjust(new_bucket_count);
+
+        // 如果新的桶数量与当前相同，不需要rehash
+        if (new_bucket_count == bucket_count_) {
+            return;
+        }
+
+        // 分配新的桶数组
+        Node** new_buckets = allocate_buckets(new_bucket_count);
+
+        // 重新分配所有节点
+        for (size_type i = 0; i < bucket_count_; ++i) {
+            Node* current = buckets_[i];
+            while (current) {
+                Node* next = current->next;
+
+                // 计算新的桶索引
+                size_type new_bucket = new_policy.index(node_hash(current));
+
+                // 将节点插入新的桶
+                current->next = new_buckets[new_bucket];
+                new_buckets[new_bucket] = current;
+
+                current = next;
+            }
+        }
+
+        // 释放旧的桶数组
+        deallocate_buckets();
+
+        // 更新成员变量
+        buckets_ = new_buckets;
+        bucket_count_ = new_bucket_count;
+        policy_ = new_policy;
+    }
+
+    void reserve(size_type count) {
+        rehash(std::ceil(count / max_load_factor_));
+    }
+
+    // 桶接口
+    size_type bucket_count() const noexcept { return bucket_count_; }
+
+    size_type max_bucket_count() const noexcept {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    size_type bucket_size(size_type n) const {
+        size_type count = 0;
+        for (Node* current = buckets_[n]; current; current = current->next) {
+            ++count;
+        }
+        return count;
+    }
+
+    size_type bucket(const key_type& key) const {
+        return policy_.index(hash_function_(key));
+    }
+
+    // 观察器
+    hasher hash_function() const {
+        return hash_function_;
+    }
+
+    key_equal key_eq() const {
+        return key_equal_;
+    }
+
+    // 合并操作
+    // 本容器中已存在的键保留在other中。other缓存的哈希值由它自己的哈希函数算出，
+    // 只有哈希函数无状态时两者才一定相同，否则（如种子不同）要用本容器的哈希函数重新计算。
+    // 分配器相等时本容器的内存池先引用other的全部slab，再把节点直接挂到本容器的桶中，
+    // 元素不会被复制或移动，指针和引用保持有效，只有哈希函数或键比较抛出异常时才会中途失败。
+    // 分配器不相等时节点无法转移，只能把元素移动到本容器池中的新节点里，原节点在other中销毁；
+    // 这时指向被合并元素的指针和引用失效，元素的构造也可能抛出异常
+    void merge(hashtable& other) {
+        if (this == &other) {
+            return;
+        }
+
+        // 预留足够的空间，保证合并过程中不会再rehash
+        reserve(size_ + other.size_);
+
+        const bool transfer_nodes = pool_.get_allocator() == other.pool_.get_allocator();
+        if (transfer_nodes) {
+            pool_.share(other.pool_);
+        }
+
+        for (size_type i = 0; i < other.bucket_count_; ++i) {
+            Node** link = &other.buckets_[i];
+            while (*link) {
+                Node* node = *link;
+                std::size_t hash = std::is_empty<Hash>::value
+                                       ? node_hash(node)
+                                       : hash_function_(Policy::key(node->value));
+                size_type bucket_idx;
+                if (find_node(Policy::key(node->value), hash, bucket_idx)) {
+                    link = &node->next;
+                    continue;
+                }
+
+                if (transfer_nodes) {
+                    *link = node->next;
+                    --other.size_;
+                    link_node(node, hash);
+                } else {
+                    link_node(pool_.create(std::move(node->value)), hash);
+                    *link = node->next;
+                    other.pool_.destroy(node);
+                    --other.size_;
+                }
+            }
+        }
+    }
+
+    // 辅助功能
+    void swap(hashtable& other) noexcept {
+        std::swap(buckets_, other.buckets_);
+        std::swap(bucket_count_, other.bucket_count_);
+        std::swap(size_, other.size_);
+        std::swap(max_load_factor_, other.max_load_factor_);
+        std::swap(hash_function_, other.hash_function_);
+        std::swap(key_equal_, other.key_equal_);
+        std::swap(policy_, other.policy_);
+        pool_.swap(other.pool_);
+    }
+
+    // 比较运算符：元素个数相同，且一方的每个元素都能在另一方找到相同的键和值
+    friend bool operator==(const hashtable& lhs, const hashtable& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        for (const auto& value : lhs) {
+            const Node* node = rhs.find_node(Policy::key(value));
+            if (!node || !Policy::mapped_equal(node->value, value)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    friend bool operator!=(const hashtable& lhs, const hashtable& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+} // namespace sjkxq_stl
+
+#endif // SJKXQ_STL_HASHTABLE_HPP
@@ -1,15 +1,17 @@
 #ifndef SJKXQ_STL_LIST_HPP
 #define SJKXQ_STL_LIST_HPP
 
+#include "../common.hpp"
 #include "list_base.hpp"
 #include <algorithm>
 #include <initializer_list>
+#include <limits>
 
 namespace sjkxq_stl {
 
-template <typename T, typename Allocator>
-class list : public list_base<T, Allocator> {
-    using base = list_base<T, Allocator>;
+template <typename T, typename Allocator, bool Pooled>
+class list : public list_base<T, Allocator, Pooled> {
+    using base = list_base<T, Allocator, Pooled>;
 
 public:
     using value_type = typename base::value_type;
@@ -54,7 +56,7 @@ public:
     }
 
     list(const list& other)
-        : base(other.get_allocator()) {
+        : base(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {
         this->init();
         insert(begin(), other.begin(), other.end());
     }
@@ -63,6 +65,7 @@ public:
         : base(std::move(other.get_allocator())) {
         this->init();
         this->swap_data(other);
+        this->node_alloc.swap(other.node_alloc);
     }
 
     list(std::initializer_list<value_type> init, const allocator_type& alloc = allocator_type())
@@ -76,18 +79,32 @@ public:
     }
 
     // 赋值操作符
+    // 分配器随复制传播时，原有节点先用原来的分配器归还，新节点来自other的分配器
     list& operator=(const list& other) {
         if (this != &other) {
             clear();
+            copy_assign_allocator(this->alloc, other.alloc);
+            this->node_alloc.copy_assign(other.node_alloc);
             insert(begin(), other.begin(), other.end());
         }
         return *this;
     }
 
-    list& operator=(list&& other) noexcept {
+    // 分配器不传播且与other的不相等时，节点不能转移到本list，只能逐个移动元素
+    list& operator=(list&& other) noexcept(
+        std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+        || std::allocator_traits<allocator_type>::is_always_equal::value) {
         if (this != &other) {
             clear();
-            this->swap_data(other);
+            if (allocator_can_steal(this->alloc, other.alloc)) {
+                this->swap_data(other);
+                move_assign_allocator(this->alloc, other.alloc);
+                this->node_alloc.move_assign(other.node_alloc);
+            } else {
+                for (auto& value : other) {
+                    emplace_back(std::move(value));
+                }
+            }
         }
         return *this;
     }
@@ -300,6 +317,8 @@ public:
     void swap(list& other) noexcept {
         if (this != &other) {
             this->swap_data(other);
+            swap_allocator(this->alloc, other.alloc);
+            this->node_alloc.swap(other.node_alloc);
         }
     }
 
@@ -323,28 +342,19 @@ public:
             return;
         }
 
-        iterator first1 = begin();
-        iterator last1 = end();
-        iterator first2 = other.begin();
-        iterator last2 = other.end();
-
-        while (first1 != last1 && first2 != last2) {
-            if (comp(*first2, *first1)) {
-                iterator next = first2;
+        if constexpr (Pooled) {
+            iterator first1 = begin();
+            while (!other.empty()) {
+                while (first1 != end() && !comp(other.front(), *first1)) {
+                    ++first1;
+                }
+                iterator next = other.begin();
                 ++next;
-                this->transfer(first1, first2, next);
-                first2 = next;
-            } else {
-                ++first1;
+                move_nodes(first1, other, other.begin(), next);
             }
+        } else {
+            merge_nodes(other, comp);
         }
-
-        if (first2 != last2) {
-            this->transfer(last1, first2, last2);
-        }
-
-        this->increase_size(other.size());
-        other.node_count = 0;
     }
 
     void splice(const_iterator pos, list& other) {
@@ -352,6 +362,12 @@ public:
     }
 
     void splice(const_iterator pos, list&& other) {
+        if constexpr (Pooled) {
+            if (this != &other) {
+                move_nodes(pos, other, other.begin(), other.end());
+                return;
+            }
+        }
         if (!other.empty()) {
             this->transfer(iterator(const_cast<typename base::node_type*>(pos.get_node())),
                           other.begin(), other.end());
@@ -371,6 +387,13 @@ public:
             return;
         }
 
+        if constexpr (Pooled) {
+            if (this != &other) {
+                move_nodes(pos, other, it, inext);
+                return;
+            }
+        }
+
         this->transfer(iterator(const_cast<typename base::node_type*>(pos.get_node())),
                       iterator(const_cast<typename base::node_type*>(it.get_node())),
                       inext);
@@ -383,6 +406,12 @@ public:
     }
 
     void splice(const_iterator pos, list&& other, const_iterator first, const_iterator last) {
+        if constexpr (Pooled) {
+            if (this != &other) {
+                move_nodes(pos, other, first, last);
+                return;
+            }
+        }
         if (first != last) {
             size_type n = std::distance(first, last);
             this->transfer(iterator(const_cast<typename base::node_type*>(pos.get_node())),
@@ -457,77 +486,144 @@ public:
             return;
         }
 
+        // 临时list只借用节点链，不分配节点；用transfer/swap_data搬运，
+        // 这样池化模式下节点始终属于本list的池
         list carry;
         list tmp[64];
         list* fill = &tmp[0];
         list* counter = nullptr;
 
-        do {
-            carry.splice(carry.begin(), *this, begin());
-
-            for (counter = &tmp[0]; counter != fill && !counter->empty(); ++counter) {
-                counter->merge(carry, comp);
-                carry.swap(*counter);
+        try {
+            do {
+                iterator next = begin();
+                ++next;
+                carry.transfer(carry.begin(), begin(), next);
+                carry.increase_size(1);
+                this->decrease_size(1);
+
+                for (counter = &tmp[0]; counter != fill && !counter->empty(); ++counter) {
+                    counter->merge_nodes(carry, comp);
+                    carry.swap_data(*counter);
+                }
+
+                carry.swap_data(*counter);
+                if (counter == fill) {
+                    ++fill;
+                }
+            } while (!empty());
+
+            for (counter = &tmp[1]; counter != fill; ++counter) {
+                counter->merge_nodes(*(counter - 1), comp);
             }
 
-            carry.swap(*counter);
-            if (counter == fill) {
-                ++fill;
+            this->swap_data(*(fill - 1));
+        } catch (...) {
+            // 比较抛出异常时把所有节点收回本list，保证不丢失也不经由临时list释放
+            // 归并中途抛出时各list的计数可能不准，但总数不变
+            size_type n = this->get_size();
+            auto reclaim = [this, &n](list& l) {
+                n += l.get_size();
+                if (l.begin() != l.end()) {
+                    this->transfer(end(), l.begin(), l.end());
+                }
+                l.init();
+            };
+            reclaim(carry);
+            for (counter = &tmp[0]; counter != fill; ++counter) {
+                reclaim(*counter);
             }
-        } while (!empty());
-
-        for (counter = &tmp[1]; counter != fill; ++counter) {
-            counter->merge(*(counter - 1), comp);
+            this->node_count = n;
+            throw;
         }
-
-        swap(*(fill - 1));
     }
 
     // 获取分配器
     allocator_type get_allocator() const noexcept {
         return this->memory_base_type::get_allocator();
     }
+
+private:
+    // 直接转移节点的归并，要求两个list的节点来自同一个分配器
+    template <typename Compare>
+    void merge_nodes(list& other, Compare& comp) {
+        iterator first1 = begin();
+        iterator last1 = end();
+        iterator first2 = other.begin();
+        iterator last2 = other.end();
+
+        while (first1 != last1 && first2 != last2) {
+            if (comp(*first2, *first1)) {
+                iterator next = first2;
+                ++next;
+                this->transfer(first1, first2, next);
+                first2 = next;
+            } else {
+                ++first1;
+            }
+        }
+
+        if (first2 != last2) {
+            this->transfer(last1, first2, last2);
+        }
+
+        this->increase_size(other.size());
+        other.node_count = 0;
+    }
+
+    // 池化模式下把other中[first, last)的元素逐个移动到本池的新节点中并释放原节点，
+    // 被移动元素的迭代器随之失效
+    void move_nodes(const_iterator pos, list& other, const_iterator first, const_iterator last) {
+        while (first != last) {
+            iterator it(const_cast<typename base::node_type*>(first.get_node()));
+            emplace(pos, std::move(*it));
+            first = other.erase(first);
+        }
+    }
 };
 
 // 非成员函数
-template <typename T, typename Alloc>
-bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
+template <typename T, typename Alloc, bool Pooled>
+bool operator==(const list<T, Alloc, Pooled>& lhs, const list<T, Alloc, Pooled>& rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
     return std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <typename T, typename Alloc>
-bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
+template <typename T, typename Alloc, bool Pooled>
+bool operator!=(const list<T, Alloc, Pooled>& lhs, const list<T, Alloc, Pooled>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename T, typename Alloc>
-bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
+template <typename T, typename Alloc, bool Pooled>
+bool operator<(const list<T, Alloc, Pooled>& lhs, const list<T, Alloc, Pooled>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, typename Alloc>
-bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
+template <typename T, typename Alloc, bool Pooled>
+bool operator<=(const list<T, Alloc, Pooled>& lhs, const list<T, Alloc, Pooled>& rhs) {
     return !(rhs < lhs);
 }
 
-template <typename T, typename Alloc>
-bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
+template <typename T, typename Alloc, bool Pooled>
+bool operator>(const list<T, Alloc, Pooled>& lhs, const list<T, Alloc, Pooled>& rhs) {
     return rhs < lhs;
 }
 
-template <typename T, typename Alloc>
-bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
+template <typename T, typename Alloc, bool Pooled>
+bool operator>=(const list<T, Alloc, Pooled>& lhs, const list<T, Alloc, Pooled>& rhs) {
     return !(lhs < rhs);
 }
 
-template <typename T, typename Alloc>
-void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept {
+template <typename T, typename Alloc, bool Pooled>
+void swap(list<T, Alloc, Pooled>& lhs, list<T, Alloc, Pooled>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// 节点来自list独占内存池的list，适合频繁插入删除的场景
+template <typename T, typename Allocator = std::allocator<T>>
+using pooled_list = list<T, Allocator, true>;
+
 } // namespace sjkxq_stl
 
 #endif // SJKXQ_STL_LIST_HPP
\ No newline at end of file
@@ -10,7 +10,7 @@
 
 namespace sjkxq_stl {
 
-template <typename T, typename Allocator = std::allocator<T>>
+template <typename T, typename Allocator = std::allocator<T>, bool Pooled = false>
 class list_base : protected memory_base<T, Allocator> {
 public:
     using size_type = std::size_t;
@@ -31,7 +31,7 @@ protected:
 protected:
     using memory_base_type = memory_base<T, Allocator>;
     using node_type = list_node_impl<T>;
-    using node_allocator_type = list_node_allocator<T, Allocator>;
+    using node_allocator_type = list_node_allocator<T, Allocator, Pooled>;
 
     node_base header;
     node_allocator_type node_alloc;
@@ -127,6 +127,7 @@ protected:
         position.get_node()->transfer(first.get_node(), last.get_node());
     }
 
+    // 只交换节点链和计数，节点分配器由调用者决定是否一起交换
     void swap_data(list_base& other) noexcept {
         std::swap(header.next, other.header.next);
         std::swap(header.prev, other.header.prev);
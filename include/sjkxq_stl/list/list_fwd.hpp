@@ -6,7 +6,8 @@
 namespace sjkxq_stl {
 
 // 前向声明
-template <typename T, typename Allocator = std::allocator<T>>
+// Pooled为true时节点从list独占的内存池中分配，见list_node_allocator
+template <typename T, typename Allocator = std::allocator<T>, bool Pooled = false>
 class list;
 
 template <typename T>
@@ -18,7 +19,7 @@ class list_iterator;
 template <typename T>
 class const_list_iterator;
 
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, bool Pooled = false>
 class list_node_allocator;
 
 } // namespace sjkxq_stl
@@ -3,6 +3,7 @@
 
 #include "../container_base/node_base.hpp"
 #include "../container_base/memory_base.hpp"
+#include "../container_base/node_pool.hpp"
 #include "list_fwd.hpp"
 #include <memory>
 
@@ -18,7 +19,7 @@ struct list_node_impl : public node_base {
 };
 
 // 为了保持向后兼容性，保留list_node_allocator，但使用新的基础设施
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, bool Pooled>
 class list_node_allocator {
     using node_type = list_node_impl<T>;
     using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
@@ -48,6 +49,77 @@ public:
     void destroy(node_type* p) {
         allocator_traits::destroy(alloc, p);
     }
+
+    // 容器复制赋值、移动赋值时按propagate_on_container_*决定是否接受other的分配器
+    void copy_assign(const list_node_allocator& other) {
+        copy_assign_allocator(alloc, other.alloc);
+    }
+
+    void move_assign(list_node_allocator& other) noexcept {
+        move_assign_allocator(alloc, other.alloc);
+    }
+
+    void swap(list_node_allocator& other) noexcept {
+        swap_allocator(alloc, other.alloc);
+    }
+};
+
+/*
+ * 池化模式
+ *
+ * 每个list独占一个node_pool：节点从大块slab中切出，释放的节点挂在侵入式空闲链表上供下次复用，
+ * slab在list析构时整块归还。频繁insert/erase的场景下，一次节点分配只是一次空闲链表出栈。
+ *
+ * 节点只能回到分配它的池中，因此池化list之间的splice/merge会在本池中重建元素，而不是直接转移节点。
+ */
+template <typename T, typename Allocator>
+class list_node_allocator<T, Allocator, true> {
+    using node_type = list_node_impl<T>;
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+    using allocator_traits = std::allocator_traits<allocator_type>;
+
+    node_pool<node_type, Allocator> pool;
+
+public:
+    using size_type = typename allocator_traits::size_type;
+
+    explicit list_node_allocator(const Allocator& a = Allocator())
+        : pool(a) {}
+
+    // 池只按单个节点分配，n必须为1
+    node_type* allocate(size_type = 1) {
+        return pool.allocate();
+    }
+
+    void deallocate(node_type* p, size_type = 1) noexcept {
+        pool.deallocate(p);
+    }
+
+    template <typename... Args>
+    void construct(node_type* p, Args&&... args) {
+        allocator_type alloc(pool.get_allocator());
+        allocator_traits::construct(alloc, p, std::forward<Args>(args)...);
+    }
+
+    void destroy(node_type* p) {
+        allocator_type alloc(pool.get_allocator());
+        allocator_traits::destroy(alloc, p);
+    }
+
+    // 调用前list必须已经清空：复制赋值传播分配器时原有的slab先归还，移动赋值接管other的全部slab
+    void copy_assign(const list_node_allocator& other) {
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+            pool.copy_allocator_from(other.pool);
+        }
+    }
+
+    void move_assign(list_node_allocator& other) noexcept {
+        pool = std::move(other.pool);
+    }
+
+    void swap(list_node_allocator& other) noexcept {
+        pool.swap(other.pool);
+    }
 };
 
 } // namespace sjkxq_stl
@@ -0,0 +1,70 @@
+#ifndef SJKXQ_STL_MALLOC_ALLOCATOR_HPP
+#define SJKXQ_STL_MALLOC_ALLOCATOR_HPP
+
+#include "common.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 基于malloc/free的分配器
+ *
+ * 与std::allocator的区别在于提供reallocate：容器扩容时可以先尝试realloc，
+ * 由C库在原地扩大内存块，或者在必要时一次性搬走整个块，避免逐个搬迁元素。
+ * vector只在元素可以按字节搬迁时使用reallocate。
+ * 只支持不超过alignof(std::max_align_t)的对齐要求。
+ */
+template <typename T>
+class malloc_allocator
+{
+  static_assert(alignof(T) <= alignof(std::max_align_t), "malloc_allocator: over-aligned types are not supported");
+
+public:
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using is_always_equal = std::true_type;
+
+  malloc_allocator() noexcept = default;
+
+  template <typename U>
+  malloc_allocator(const malloc_allocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(size_type n)
+  {
+    if (n > size_type(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    void* p = std::malloc(n * sizeof(T));
+    if (!p && n > 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, size_type) noexcept { std::free(p); }
+
+  // 把p处的块调整为new_n个元素，前min(old_n, new_n)个元素的字节保持不变，返回新地址；
+  // 失败时返回nullptr，原有的块保持不变
+  T* reallocate(T* p, size_type /*old_n*/, size_type new_n) noexcept
+  {
+    if (new_n == 0 || new_n > size_type(-1) / sizeof(T)) {
+      return nullptr;
+    }
+    return static_cast<T*>(std::realloc(static_cast<void*>(p), new_n * sizeof(T)));
+  }
+
+  friend bool operator==(const malloc_allocator&, const malloc_allocator&) noexcept { return true; }
+
+  friend bool operator!=(const malloc_allocator&, const malloc_allocator&) noexcept { return false; }
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_MALLOC_ALLOCATOR_HPP
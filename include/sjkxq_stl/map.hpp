@@ -2,41 +2,45 @@
 #define SJKXQ_STL_MAP_HPP
 
 #include "common.hpp"
+#include "tree/rb_tree.hpp"
 #include <functional>
-#include <map>
 #include <memory>
+#include <tuple>
 
 namespace sjkxq_stl
 {
 
+// map的元素是键值对，键取自first
+template <typename Key, typename T>
+struct map_policy {
+  using key_type   = Key;
+  using value_type = std::pair<const Key, T>;
+
+  // 可以通过迭代器修改值（键本身是const）
+  static constexpr bool constant_values = false;
+
+  static const key_type& key(const value_type& value) noexcept { return value.first; }
+};
+
+/**
+ * @brief 基于红黑树的有序映射
+ *
+ * 与set共用rb_tree核心，节点由Allocator分配。插入和删除不会使其他元素的迭代器失效。
+ */
 template <typename Key,
           typename T,
           typename Compare   = std::less<Key>,
           typename Allocator = std::allocator<std::pair<const Key, T>>>
-class map
+class map : public rb_tree<map_policy<Key, T>, Compare, Allocator>
 {
-public:
-  // 类型定义
-  using key_type        = Key;
-  using mapped_type     = T;
-  using value_type      = std::pair<const Key, T>;
-  using size_type       = std::size_t;
-  using difference_type = std::ptrdiff_t;
-  using key_compare     = Compare;
-  using allocator_type  = Allocator;
-  using reference       = value_type&;
-  using const_reference = const value_type&;
-  using pointer         = typename std::allocator_traits<Allocator>::pointer;
-  using const_pointer   = typename std::allocator_traits<Allocator>::const_pointer;
-
-  // 内部使用std::map作为实现
-  using impl_type = std::map<Key, T, Compare, Allocator>;
+  using base = rb_tree<map_policy<Key, T>, Compare, Allocator>;
 
-  // 迭代器类型
-  using iterator               = typename impl_type::iterator;
-  using const_iterator         = typename impl_type::const_iterator;
-  using reverse_iterator       = typename impl_type::reverse_iterator;
-  using const_reverse_iterator = typename impl_type::const_reverse_iterator;
+public:
+  using mapped_type = T;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::key_type;
+  using typename base::value_type;
 
   // 值比较器
   class value_compare
@@ -53,272 +57,114 @@ public:
     friend class map;
   };
 
-private:
-  impl_type m_map;  // 底层实现
-
-public:
-  // 构造函数
-  map() : m_map() {}
-
-  explicit map(const Compare& comp, const Allocator& alloc = Allocator()) : m_map(comp, alloc) {}
-
-  explicit map(const Allocator& alloc) : m_map(alloc) {}
-
-  template <typename InputIt>
-  map(InputIt          first,
-      InputIt          last,
-      const Compare&   comp  = Compare(),
-      const Allocator& alloc = Allocator())
-      : m_map(first, last, comp, alloc)
-  {
-  }
-
-  template <typename InputIt>
-  map(InputIt first, InputIt last, const Allocator& alloc) : m_map(first, last, Compare(), alloc)
-  {
-  }
-
-  map(const map& other) : m_map(other.m_map) {}
-
-  map(const map& other, const Allocator& alloc) : m_map(other.m_map, alloc) {}
-
-  map(map&& other) noexcept : m_map(std::move(other.m_map)) {}
-
-  map(map&& other, const Allocator& alloc) : m_map(std::move(other.m_map), alloc) {}
+  using base::base;
+  using base::insert;
 
-  map(std::initializer_list<value_type> init,
-      const Compare&                    comp  = Compare(),
-      const Allocator&                  alloc = Allocator())
-      : m_map(init, comp, alloc)
-  {
-  }
+  map() = default;
 
-  map(std::initializer_list<value_type> init, const Allocator& alloc)
-      : m_map(init, Compare(), alloc)
-  {
-  }
-
-  // 赋值运算符
-  map& operator=(const map& other)
+  map& operator=(std::initializer_list<value_type> ilist)
   {
-    m_map = other.m_map;
+    base::operator=(ilist);
     return *this;
   }
 
-  map& operator=(map&& other) noexcept
+  // 元素访问
+  T& at(const Key& key)
   {
-    m_map = std::move(other.m_map);
-    return *this;
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("map::at: key not found");
+    }
+    return it->second;
   }
 
-  map& operator=(std::initializer_list<value_type> ilist)
+  const T& at(const Key& key) const
   {
-    m_map = ilist;
-    return *this;
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("map::at: key not found");
+    }
+    return it->second;
   }
 
-  // 获取分配器
-  allocator_type get_allocator() const noexcept { return m_map.get_allocator(); }
-
-  // 元素访问
-  T& at(const Key& key) { return m_map.at(key); }
-
-  const T& at(const Key& key) const { return m_map.at(key); }
-
-  T& operator[](const Key& key) { return m_map[key]; }
-
-  T& operator[](Key&& key) { return m_map[std::move(key)]; }
-
-  // 迭代器
-  iterator begin() noexcept { return m_map.begin(); }
-
-  const_iterator begin() const noexcept { return m_map.begin(); }
-
-  const_iterator cbegin() const noexcept { return m_map.cbegin(); }
-
-  iterator end() noexcept { return m_map.end(); }
-
-  const_iterator end() const noexcept { return m_map.end(); }
-
-  const_iterator cend() const noexcept { return m_map.cend(); }
-
-  reverse_iterator rbegin() noexcept { return m_map.rbegin(); }
-
-  const_reverse_iterator rbegin() const noexcept { return m_map.rbegin(); }
-
-  const_reverse_iterator crbegin() const noexcept { return m_map.crbegin(); }
-
-  reverse_iterator rend() noexcept { return m_map.rend(); }
-
-  const_reverse_iterator rend() const noexcept { return m_map.rend(); }
-
-  const_reverse_iterator crend() const noexcept { return m_map.crend(); }
-
-  // 容量
-  bool empty() const noexcept { return m_map.empty(); }
-
-  size_type size() const noexcept { return m_map.size(); }
-
-  size_type max_size() const noexcept { return m_map.max_size(); }
-
-  // 修改器
-  void clear() noexcept { m_map.clear(); }
-
-  std::pair<iterator, bool> insert(const value_type& value) { return m_map.insert(value); }
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
 
-  std::pair<iterator, bool> insert(value_type&& value) { return m_map.insert(std::move(value)); }
+  T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
 
-  template <typename P>
+  // 可转换为value_type的参数，如 std::pair<Key, T>
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
   std::pair<iterator, bool> insert(P&& value)
   {
-    return m_map.insert(std::forward<P>(value));
+    return this->emplace(std::forward<P>(value));
   }
 
-  iterator insert(const_iterator hint, const value_type& value)
-  {
-    return m_map.insert(hint, value);
-  }
-
-  iterator insert(const_iterator hint, value_type&& value)
-  {
-    return m_map.insert(hint, std::move(value));
-  }
-
-  template <typename P>
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
   iterator insert(const_iterator hint, P&& value)
   {
-    return m_map.insert(hint, std::forward<P>(value));
-  }
-
-  template <typename InputIt>
-  void insert(InputIt first, InputIt last)
-  {
-    m_map.insert(first, last);
+    return this->emplace_hint(hint, std::forward<P>(value));
   }
 
-  void insert(std::initializer_list<value_type> ilist) { m_map.insert(ilist); }
-
+  // 键不存在时才构造值，键已存在时参数不会被移动
   template <typename... Args>
-  std::pair<iterator, bool> emplace(Args&&... args)
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
   {
-    return m_map.emplace(std::forward<Args>(args)...);
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(key),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
   template <typename... Args>
-  iterator emplace_hint(const_iterator hint, Args&&... args)
-  {
-    return m_map.emplace_hint(hint, std::forward<Args>(args)...);
-  }
-
-  iterator erase(const_iterator pos) { return m_map.erase(pos); }
-
-  iterator erase(const_iterator first, const_iterator last) { return m_map.erase(first, last); }
-
-  size_type erase(const key_type& key) { return m_map.erase(key); }
-
-  void swap(map& other) noexcept(std::is_nothrow_swappable_v<Compare>) { m_map.swap(other.m_map); }
-
-  // 查找
-  size_type count(const Key& key) const { return m_map.count(key); }
-
-  template <typename K>
-  size_type count(const K& x) const
-  {
-    return m_map.count(x);
-  }
-
-  iterator find(const Key& key) { return m_map.find(key); }
-
-  const_iterator find(const Key& key) const { return m_map.find(key); }
-
-  template <typename K>
-  iterator find(const K& x)
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
   {
-    return m_map.find(x);
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(std::move(key)),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
-  template <typename K>
-  const_iterator find(const K& x) const
-  {
-    return m_map.find(x);
-  }
-
-  bool contains(const Key& key) const { return m_map.find(key) != m_map.end(); }
-
-  template <typename K>
-  bool contains(const K& x) const
-  {
-    return m_map.find(x) != m_map.end();
-  }
-
-  std::pair<iterator, iterator> equal_range(const Key& key) { return m_map.equal_range(key); }
-
-  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const
-  {
-    return m_map.equal_range(key);
-  }
-
-  template <typename K>
-  std::pair<iterator, iterator> equal_range(const K& x)
-  {
-    return m_map.equal_range(x);
-  }
-
-  template <typename K>
-  std::pair<const_iterator, const_iterator> equal_range(const K& x) const
-  {
-    return m_map.equal_range(x);
-  }
-
-  iterator lower_bound(const Key& key) { return m_map.lower_bound(key); }
-
-  const_iterator lower_bound(const Key& key) const { return m_map.lower_bound(key); }
-
-  template <typename K>
-  iterator lower_bound(const K& x)
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, const Key& key, Args&&... args)
   {
-    return m_map.lower_bound(x);
+    return this->insert_hint_unique(hint,
+                                    key,
+                                    std::piecewise_construct,
+                                    std::forward_as_tuple(key),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
-  template <typename K>
-  const_iterator lower_bound(const K& x) const
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, Key&& key, Args&&... args)
   {
-    return m_map.lower_bound(x);
+    return this->insert_hint_unique(hint,
+                                    key,
+                                    std::piecewise_construct,
+                                    std::forward_as_tuple(std::move(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
-  iterator upper_bound(const Key& key) { return m_map.upper_bound(key); }
-
-  const_iterator upper_bound(const Key& key) const { return m_map.upper_bound(key); }
-
-  template <typename K>
-  iterator upper_bound(const K& x)
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
   {
-    return m_map.upper_bound(x);
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
   }
 
-  template <typename K>
-  const_iterator upper_bound(const K& x) const
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
   {
-    return m_map.upper_bound(x);
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
   }
 
   // 观察器
-  key_compare key_comp() const { return m_map.key_comp(); }
-
-  value_compare value_comp() const { return value_compare(m_map.key_comp()); }
-
-  // 比较运算符
-  friend bool operator==(const map& lhs, const map& rhs) { return lhs.m_map == rhs.m_map; }
-
-  friend bool operator!=(const map& lhs, const map& rhs) { return lhs.m_map != rhs.m_map; }
-
-  friend bool operator<(const map& lhs, const map& rhs) { return lhs.m_map < rhs.m_map; }
-
-  friend bool operator<=(const map& lhs, const map& rhs) { return lhs.m_map <= rhs.m_map; }
-
-  friend bool operator>(const map& lhs, const map& rhs) { return lhs.m_map > rhs.m_map; }
-
-  friend bool operator>=(const map& lhs, const map& rhs) { return lhs.m_map >= rhs.m_map; }
+  value_compare value_comp() const { return value_compare(this->key_comp()); }
 };
 
 // 特化的swap函数
@@ -331,4 +177,4 @@ void swap(map<Key, T, Compare, Alloc>& lhs,
 
 }  // namespace sjkxq_stl
 
-#endif  // SJKXQ_STL_MAP_HPP
\ No newline at end of file
+#endif  // SJKXQ_STL_MAP_HPP
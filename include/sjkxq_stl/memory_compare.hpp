@@ -0,0 +1,107 @@
+#ifndef SJKXQ_STL_MEMORY_COMPARE_HPP
+#define SJKXQ_STL_MEMORY_COMPARE_HPP
+
+#include "common.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// 查找首个不同字节的实现按 common.hpp 中的检测结果选择：
+// AVX2（一次32个字节）、SSE2（一次16个字节），否则使用可移植实现（每次比较8个字节）
+#if defined(SJKXQ_STL_HAVE_AVX2)
+#include <immintrin.h>
+#elif defined(SJKXQ_STL_HAVE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace sjkxq_stl
+{
+
+// 返回[a, a + n)与[b, b + n)中首个不同字节的偏移，完全相同时返回n
+inline std::size_t first_byte_mismatch(const void* a, const void* b, std::size_t n) noexcept
+{
+  const unsigned char* p = static_cast<const unsigned char*>(a);
+  const unsigned char* q = static_cast<const unsigned char*>(b);
+  std::size_t          i = 0;
+
+#if defined(SJKXQ_STL_HAVE_AVX2)
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i));
+    std::uint32_t diff = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    if (diff != 0) {
+      return i + count_trailing_zeros(diff);
+    }
+  }
+#endif
+#if defined(SJKXQ_STL_HAVE_SSE2)
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i));
+    std::uint32_t diff = ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFu;
+    if (diff != 0) {
+      return i + count_trailing_zeros(diff);
+    }
+  }
+#endif
+
+  // 剩余部分每次比较8个字节，找到不同的字后再逐字节定位
+  for (; i + 8 <= n; i += 8) {
+    std::uint64_t x;
+    std::uint64_t y;
+    std::memcpy(&x, p + i, 8);
+    std::memcpy(&y, q + i, 8);
+    if (x != y) {
+      break;
+    }
+  }
+  for (; i < n; ++i) {
+    if (p[i] != q[i]) {
+      return i;
+    }
+  }
+  return n;
+}
+
+// 按字节比较即可判断相等的类型：整数和指针的每种取值只有一种对象表示。
+// 浮点数不在其中：+0.0与-0.0相等但字节不同，NaN的字节相同却不相等
+template <typename T>
+inline constexpr bool is_bytewise_equality_comparable_v = std::is_integral<T>::value || std::is_pointer<T>::value;
+
+// 算术类型数组的字典序比较，结果与std::lexicographical_compare相同。
+// 先用first_byte_mismatch跳过字节完全相同的前缀，再在首个不同的元素上按值比较；
+// 字节不同而值相等（+0.0与-0.0）时从下一个元素继续查找。无符号字节类型直接使用memcmp
+template <typename T>
+bool arithmetic_lexicographical_less(const T* a, std::size_t na, const T* b, std::size_t nb) noexcept
+{
+  static_assert(std::is_arithmetic<T>::value, "arithmetic_lexicographical_less: T must be arithmetic");
+
+  const std::size_t n = std::min(na, nb);
+  if constexpr (std::is_same<T, unsigned char>::value || std::is_same<T, bool>::value
+                || (std::is_same<T, char>::value && !std::is_signed<char>::value)) {
+    int c = n > 0 ? std::memcmp(a, b, n) : 0;
+    return c != 0 ? c < 0 : na < nb;
+  } else {
+    std::size_t i = 0;
+    while (i < n) {
+      i += first_byte_mismatch(a + i, b + i, (n - i) * sizeof(T)) / sizeof(T);
+      if (i == n) {
+        break;
+      }
+      if (a[i] < b[i]) {
+        return true;
+      }
+      if (b[i] < a[i]) {
+        return false;
+      }
+      ++i;
+    }
+    return na < nb;
+  }
+}
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_MEMORY_COMPARE_HPP
@@ -0,0 +1,89 @@
+#ifndef SJKXQ_STL_MEMORY_RESOURCE_HPP
+#define SJKXQ_STL_MEMORY_RESOURCE_HPP
+
+#include "btree_map.hpp"
+#include "btree_set.hpp"
+#include "flat_hash_map.hpp"
+#include "flat_hash_set.hpp"
+#include "list.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "small_vector.hpp"
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+#include "vector.hpp"
+#include <functional>
+#include <memory_resource>
+
+namespace sjkxq_stl
+{
+
+/*
+ * 多态内存资源（PMR）
+ *
+ * 内存资源与标准库<memory_resource>相同，容器通过polymorphic_allocator从资源中分配，
+ * 因此sjkxq_stl和标准库的pmr容器可以共用同一个资源：
+ *   monotonic_buffer_resource     只增不减的区域分配，释放是空操作，资源析构时整体归还；
+ *                                  适合生命周期与一次请求相同的临时容器
+ *   unsynchronized_pool_resource  按块大小分池，单线程使用
+ *   synchronized_pool_resource    同上，可被多个线程同时使用
+ *
+ * polymorphic_allocator在复制、移动和交换容器时都不传播：容器始终使用构造时的资源，
+ * 不同资源的容器之间移动赋值会逐个移动元素，交换要求两者使用同一个资源。
+ * 元素本身也是pmr容器时，会通过分配器的construct自动使用外层容器的资源。
+ */
+namespace pmr
+{
+
+using std::pmr::get_default_resource;
+using std::pmr::memory_resource;
+using std::pmr::monotonic_buffer_resource;
+using std::pmr::new_delete_resource;
+using std::pmr::null_memory_resource;
+using std::pmr::polymorphic_allocator;
+using std::pmr::pool_options;
+using std::pmr::set_default_resource;
+using std::pmr::synchronized_pool_resource;
+using std::pmr::unsynchronized_pool_resource;
+
+template <typename T>
+using vector = sjkxq_stl::vector<T, polymorphic_allocator<T>>;
+
+template <typename T, size_type N>
+using small_vector = sjkxq_stl::small_vector<T, N, polymorphic_allocator<T>>;
+
+template <typename T>
+using list = sjkxq_stl::list<T, polymorphic_allocator<T>>;
+
+template <typename T>
+using pooled_list = sjkxq_stl::pooled_list<T, polymorphic_allocator<T>>;
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using map = sjkxq_stl::map<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using set = sjkxq_stl::set<Key, Compare, polymorphic_allocator<Key>>;
+
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using unordered_map = sjkxq_stl::unordered_map<Key, T, Hash, KeyEqual, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using unordered_set = sjkxq_stl::unordered_set<Key, Hash, KeyEqual, polymorphic_allocator<Key>>;
+
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using flat_hash_map = sjkxq_stl::flat_hash_map<Key, T, Hash, KeyEqual, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using flat_hash_set = sjkxq_stl::flat_hash_set<Key, Hash, KeyEqual, polymorphic_allocator<Key>>;
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using btree_map = sjkxq_stl::btree_map<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using btree_set = sjkxq_stl::btree_set<Key, Compare, polymorphic_allocator<Key>>;
+
+}  // namespace pmr
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_MEMORY_RESOURCE_HPP
@@ -0,0 +1,224 @@
+#ifndef SJKXQ_STL_MMAP_ALLOCATOR_HPP
+#define SJKXQ_STL_MMAP_ALLOCATOR_HPP
+
+#include "common.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define SJKXQ_STL_HAS_MMAP 1
+#if defined(__linux__) && defined(MREMAP_MAYMOVE) && defined(MREMAP_FIXED)
+#define SJKXQ_STL_HAS_MREMAP 1
+#endif
+#endif
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 基于mmap的大块内存分配器
+ *
+ * 每次allocate先保留一段连续的虚拟地址（不小于reserve_bytes），只把实际需要的部分提交为可读写，
+ * 物理页在首次访问时才分配。容器扩容时通过expand在保留区内原地提交更多页面，不需要搬迁任何元素；
+ * 超出保留区后expand失败，容器退回到分配新内存再搬迁的常规路径。
+ * huge_pages为true时保留区按2MiB对齐并通过madvise(MADV_HUGEPAGE)请求透明大页，减少扫描时的TLB缺失。
+ *
+ * 超出保留区时，reallocate在Linux上用mremap把已提交的页面整体移到一段更大的保留区，只改页表、不复制数据。
+ *
+ * 只适合少量、很大的内存块：即使只存放一个元素也会占用一整段保留区。
+ * 没有mmap的平台上退化为operator new，expand和reallocate总是失败。
+ */
+template <typename T>
+class mmap_allocator
+{
+public:
+  using value_type                             = T;
+  using size_type                              = std::size_t;
+  using difference_type                        = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+  using is_always_equal                        = std::false_type;
+
+  static constexpr size_type huge_page_size = size_type(2) << 20;
+  static constexpr size_type default_reserve_bytes =
+      sizeof(void*) >= 8 ? size_type(1) << 30 : size_type(64) << 20;
+
+  explicit mmap_allocator(size_type reserve_bytes = default_reserve_bytes, bool huge_pages = false) noexcept
+      : reserve_bytes_(reserve_bytes), huge_pages_(huge_pages)
+  {
+  }
+
+  template <typename U>
+  mmap_allocator(const mmap_allocator<U>& other) noexcept
+      : reserve_bytes_(other.reserve_bytes()), huge_pages_(other.huge_pages())
+  {
+  }
+
+  size_type reserve_bytes() const noexcept { return reserve_bytes_; }
+
+  bool huge_pages() const noexcept { return huge_pages_; }
+
+  T* allocate(size_type n)
+  {
+    if (n > size_type(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+#if defined(SJKXQ_STL_HAS_MMAP)
+    const size_type length = reservation(n);
+    void* p = reserve(length);
+    if (!p) {
+      throw std::bad_alloc();
+    }
+    if (!commit(p, 0, n * sizeof(T))) {
+      ::munmap(p, length);
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+#else
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+#endif
+  }
+
+  void deallocate(T* p, size_type n) noexcept
+  {
+#if defined(SJKXQ_STL_HAS_MMAP)
+    ::munmap(static_cast<void*>(p), reservation(n));
+#else
+    (void)n;
+    ::operator delete(static_cast<void*>(p));
+#endif
+  }
+
+  // 在原地把p处的块从old_n扩大到new_n个元素，成功返回true；失败时块保持不变。
+  // 只在保留区内提交更多页面，因此保留区大小只取决于reserve_bytes和块的大小，deallocate可以据此还原
+  bool expand(T* p, size_type old_n, size_type new_n) noexcept
+  {
+#if defined(SJKXQ_STL_HAS_MMAP)
+    if (new_n > size_type(-1) / sizeof(T) || reservation(new_n) != reservation(old_n)) {
+      return false;
+    }
+    return commit(static_cast<void*>(p), old_n * sizeof(T), new_n * sizeof(T));
+#else
+    (void)p;
+    (void)old_n;
+    (void)new_n;
+    return false;
+#endif
+  }
+
+  // 把p处的块从old_n扩大到new_n个元素并返回新地址，前old_n个元素的字节保持不变；
+  // 失败时返回nullptr，原有的块保持不变。先在新保留区提交好新增的页面，再把已提交的旧页面移过去
+  T* reallocate(T* p, size_type old_n, size_type new_n) noexcept
+  {
+#if defined(SJKXQ_STL_HAS_MREMAP)
+    if (new_n <= old_n || new_n > size_type(-1) / sizeof(T)) {
+      return nullptr;
+    }
+    const size_type old_length = reservation(old_n);
+    const size_type new_length = reservation(new_n);
+    const size_type committed  = round_up(old_n * sizeof(T), commit_unit());
+
+    void* q = reserve(new_length);
+    if (!q) {
+      return nullptr;
+    }
+    if (!commit(q, committed, new_n * sizeof(T))
+        || (committed > 0
+            && ::mremap(static_cast<void*>(p), committed, committed, MREMAP_MAYMOVE | MREMAP_FIXED, q) == MAP_FAILED)) {
+      ::munmap(q, new_length);
+      return nullptr;
+    }
+    // 已提交的页面已随mremap离开旧地址，只需释放旧保留区的剩余部分
+    ::munmap(static_cast<char*>(static_cast<void*>(p)) + committed, old_length - committed);
+    return static_cast<T*>(q);
+#else
+    (void)p;
+    (void)old_n;
+    (void)new_n;
+    return nullptr;
+#endif
+  }
+
+  friend bool operator==(const mmap_allocator& lhs, const mmap_allocator& rhs) noexcept
+  {
+    return lhs.reserve_bytes_ == rhs.reserve_bytes_ && lhs.huge_pages_ == rhs.huge_pages_;
+  }
+
+  friend bool operator!=(const mmap_allocator& lhs, const mmap_allocator& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  size_type reserve_bytes_;
+  bool      huge_pages_;
+
+#if defined(SJKXQ_STL_HAS_MMAP)
+  static size_type page_size() noexcept
+  {
+    static const size_type size = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  static size_type round_up(size_type bytes, size_type unit) noexcept { return (bytes + unit - 1) / unit * unit; }
+
+  // 保留区的起始地址和提交页面的单位：开启大页时为2MiB，避免拆散大页
+  size_type commit_unit() const noexcept { return huge_pages_ ? huge_page_size : page_size(); }
+
+  // 块的保留区大小：至少reserve_bytes，放不下时按需要的字节数取整到对齐单位
+  size_type reservation(size_type n) const noexcept
+  {
+    const size_type bytes = n * sizeof(T);
+    return round_up(bytes <= reserve_bytes_ ? reserve_bytes_ : bytes, commit_unit());
+  }
+
+  // 保留length字节的不可访问地址空间，起始地址按commit_unit对齐；失败时返回nullptr
+  void* reserve(size_type length) const noexcept
+  {
+    const size_type align = commit_unit();
+
+    // 多保留一个对齐单位，再裁掉首尾多余的部分
+    const size_type padded = length + align - page_size();
+    void* raw = ::mmap(nullptr, padded, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED) {
+      return nullptr;
+    }
+    const std::uintptr_t begin   = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t aligned = round_up(begin, align);
+    if (aligned > begin) {
+      ::munmap(raw, aligned - begin);
+    }
+    if (aligned + length < begin + padded) {
+      ::munmap(reinterpret_cast<void*>(aligned + length), begin + padded - (aligned + length));
+    }
+
+    void* p = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    if (huge_pages_) {
+      ::madvise(p, length, MADV_HUGEPAGE);
+    }
+#endif
+    return p;
+  }
+
+  // 把[old_bytes, new_bytes)所在的页面提交为可读写
+  bool commit(void* p, size_type old_bytes, size_type new_bytes) const noexcept
+  {
+    const size_type from = round_up(old_bytes, commit_unit());
+    const size_type to   = round_up(new_bytes, commit_unit());
+    if (to <= from) {
+      return true;
+    }
+    return ::mprotect(static_cast<char*>(p) + from, to - from, PROT_READ | PROT_WRITE) == 0;
+  }
+#endif
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_MMAP_ALLOCATOR_HPP
@@ -0,0 +1,288 @@
+#ifndef SJKXQ_STL_MPMC_QUEUE_HPP
+#define SJKXQ_STL_MPMC_QUEUE_HPP
+
+#include "common.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 有界的多生产者多消费者无锁队列
+ *
+ * 环形缓冲区的每个槽位带一个序号：序号等于写入位置时槽位可写，等于写入位置+1时可读，
+ * 读出后序号前进一圈（加容量）供下一轮写入。生产者和消费者各自只对写入/读出位置做一次CAS
+ * 来认领槽位，随后独立地构造或取出元素，互不阻塞。两个位置和每个槽位各占一个缓存行，避免伪共享。
+ *
+ * 与queue的区别：容量在构造时确定（向上取整为2的幂）；无法安全地返回队首元素的引用，
+ * 因此没有front/back，pop把元素移出到参数中。try_*版本在队列满或空时立即返回，
+ * push/emplace/pop在此时让出CPU并重试直到成功。size和empty在并发时只是近似值。
+ *
+ * 要求T的移动构造、移动赋值和析构不抛异常：认领的槽位必须填入元素，不能撤销。
+ * 从其他参数构造可能抛异常时，先在槽位之外构造好元素再移入，失败时不影响队列。
+ */
+template <typename T>
+class mpmc_queue
+{
+  static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value
+                    && std::is_nothrow_destructible<T>::value,
+                "mpmc_queue: T must be nothrow move constructible, move assignable and destructible");
+
+public:
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using reference       = T&;
+  using const_reference = const T&;
+
+  static constexpr size_type cache_line_size = 64;
+
+  explicit mpmc_queue(size_type capacity) : slots_(nullptr), mask_(0), enqueue_pos_(0), dequeue_pos_(0)
+  {
+    if (capacity == 0 || capacity > (std::numeric_limits<size_type>::max() >> 2)) {
+      throw std::invalid_argument("mpmc_queue: invalid capacity");
+    }
+    size_type rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    slots_.reset(new slot[rounded]);
+    mask_ = rounded - 1;
+    for (size_type i = 0; i < rounded; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue&)            = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  // 析构时不能有其他线程仍在使用队列
+  ~mpmc_queue()
+  {
+    const size_type end = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_type pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; ++pos) {
+      slot& s = slots_[pos & mask_];
+      if (s.sequence.load(std::memory_order_relaxed) == pos + 1) {
+        s.value()->~T();
+      }
+    }
+  }
+
+  // 容量
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  size_type size() const noexcept
+  {
+    const size_type dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+    const size_type enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? std::min(enqueued - dequeued, capacity()) : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  // 修改器（非阻塞）：队列满时返回false，元素保持不变
+  bool try_push(const value_type& value) { return try_emplace(value); }
+
+  bool try_push(value_type&& value) { return try_emplace(std::move(value)); }
+
+  // 只有可能抛异常的构造会在认领槽位之前完成，这种情况下即使队列已满，参数也可能已被移走
+  template <typename... Args>
+  bool try_emplace(Args&&... args)
+  {
+    if constexpr (!std::is_nothrow_constructible<T, Args&&...>::value) {
+      return try_emplace(T(std::forward<Args>(args)...));
+    } else {
+      size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+      for (;;) {
+        const std::ptrdiff_t dif = distance(slots_[pos & mask_].sequence.load(std::memory_order_acquire), pos);
+        if (dif == 0) {
+          if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (dif < 0) {
+          return false;
+        } else {
+          pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+      }
+      slot& s = slots_[pos & mask_];
+      ::new (static_cast<void*>(s.storage)) T(std::forward<Args>(args)...);
+      s.sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+  }
+
+  // 队列空时返回false
+  bool try_pop(value_type& value) noexcept
+  {
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::ptrdiff_t dif = distance(slots_[pos & mask_].sequence.load(std::memory_order_acquire), pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(*slots_[pos & mask_].value());
+    vacate(pos);
+    return true;
+  }
+
+  // 批量写入：一次CAS认领连续的空闲槽位，从first开始最多写入n个元素，返回实际写入的个数。
+  // 从*first构造可能抛异常时退化为逐个try_emplace
+  template <typename InputIt>
+  size_type try_push_n(InputIt first, size_type n)
+  {
+    if constexpr (!std::is_nothrow_constructible<T, decltype(*first)>::value) {
+      size_type count = 0;
+      for (; count < n && try_emplace(*first); ++count) {
+        ++first;
+      }
+      return count;
+    } else {
+      if (n == 0) {
+        return 0;
+      }
+      size_type pos   = enqueue_pos_.load(std::memory_order_relaxed);
+      size_type count = 0;
+      for (;;) {
+        const std::ptrdiff_t dif = distance(slots_[pos & mask_].sequence.load(std::memory_order_acquire), pos);
+        if (dif < 0) {
+          return 0;
+        }
+        if (dif > 0) {
+          pos = enqueue_pos_.load(std::memory_order_relaxed);
+          continue;
+        }
+        count = 1;
+        while (count < n
+               && slots_[(pos + count) & mask_].sequence.load(std::memory_order_acquire) == pos + count) {
+          ++count;
+        }
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+          break;
+        }
+      }
+
+      for (size_type i = 0; i < count; ++i, ++first) {
+        slot& s = slots_[(pos + i) & mask_];
+        ::new (static_cast<void*>(s.storage)) T(*first);
+        s.sequence.store(pos + i + 1, std::memory_order_release);
+      }
+      return count;
+    }
+  }
+
+  // 批量读出：一次CAS认领连续的已写入槽位，最多读出n个元素依次写到out，返回实际读出的个数。
+  // 写入out抛出异常时，已认领但尚未写出的元素被丢弃，槽位照常归还，随后重新抛出
+  template <typename OutputIt>
+  size_type try_pop_n(OutputIt out, size_type n)
+  {
+    if (n == 0) {
+      return 0;
+    }
+    size_type pos   = dequeue_pos_.load(std::memory_order_relaxed);
+    size_type count = 0;
+    for (;;) {
+      const std::ptrdiff_t dif = distance(slots_[pos & mask_].sequence.load(std::memory_order_acquire), pos + 1);
+      if (dif < 0) {
+        return 0;
+      }
+      if (dif > 0) {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+        continue;
+      }
+      count = 1;
+      while (count < n
+             && slots_[(pos + count) & mask_].sequence.load(std::memory_order_acquire) == pos + count + 1) {
+        ++count;
+      }
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+
+    size_type i = 0;
+    try {
+      for (; i < count; ++i, ++out) {
+        slot& s = slots_[(pos + i) & mask_];
+        *out    = std::move(*s.value());
+        vacate(pos + i);
+      }
+    } catch (...) {
+      for (; i < count; ++i) {
+        vacate(pos + i);
+      }
+      throw;
+    }
+    return count;
+  }
+
+  // 修改器（阻塞）：队列满或空时让出CPU并重试
+  void push(const value_type& value) { emplace(value); }
+
+  void push(value_type&& value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args)
+  {
+    if constexpr (!std::is_nothrow_constructible<T, Args&&...>::value) {
+      emplace(T(std::forward<Args>(args)...));
+    } else {
+      while (!try_emplace(std::forward<Args>(args)...)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void pop(value_type& value) noexcept
+  {
+    while (!try_pop(value)) {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  struct alignas(cache_line_size) slot
+  {
+    std::atomic<size_type>   sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  static std::ptrdiff_t distance(size_type sequence, size_type pos) noexcept
+  {
+    return static_cast<std::ptrdiff_t>(sequence - pos);
+  }
+
+  // 析构已认领的pos处的元素，并把槽位留给下一圈的写入
+  void vacate(size_type pos) noexcept
+  {
+    slot& s = slots_[pos & mask_];
+    s.value()->~T();
+    s.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  }
+
+  std::unique_ptr<slot[]> slots_;
+  size_type               mask_;
+  alignas(cache_line_size) std::atomic<size_type> enqueue_pos_;
+  alignas(cache_line_size) std::atomic<size_type> dequeue_pos_;  // 类本身按缓存行对齐，其后不会紧跟其他数据
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_MPMC_QUEUE_HPP
@@ -0,0 +1,204 @@
+#ifndef SJKXQ_STL_NUMA_ALLOCATOR_HPP
+#define SJKXQ_STL_NUMA_ALLOCATOR_HPP
+
+#include "common.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(SYS_mbind)
+#define SJKXQ_STL_HAS_NUMA 1
+#endif
+#endif
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief NUMA内存放置策略
+ *
+ * 对应Linux mbind(2)的模式，节点用位掩码表示（最多64个节点）：
+ * bind只在指定节点上分配，preferred优先指定节点、不够时回退到其他节点，
+ * interleave按页在多个节点间轮流分配，local在首次访问的线程所在节点上分配（与默认行为相同）。
+ */
+struct numa_policy
+{
+  enum class mode : int
+  {
+    local,
+    preferred,
+    bind,
+    interleave
+  };
+
+  mode          kind  = mode::local;
+  std::uint64_t nodes = 0;
+
+  // 节点编号须在[0, 64)内，否则抛出std::invalid_argument
+  static numa_policy bind(int node) { return {mode::bind, node_bit(node)}; }
+
+  static numa_policy preferred(int node) { return {mode::preferred, node_bit(node)}; }
+
+  static numa_policy interleave(std::uint64_t node_mask) noexcept { return {mode::interleave, node_mask}; }
+
+  friend bool operator==(const numa_policy& lhs, const numa_policy& rhs) noexcept
+  {
+    return lhs.kind == rhs.kind && lhs.nodes == rhs.nodes;
+  }
+
+  friend bool operator!=(const numa_policy& lhs, const numa_policy& rhs) noexcept { return !(lhs == rhs); }
+
+  // 把[addr, addr + length)的页面按本策略绑定，addr必须按页对齐。
+  // 页面应尚未被访问，否则已分配的页面不会迁移。失败时（内核不支持、节点不存在）返回false，页面保持默认策略
+  bool apply(void* addr, std::size_t length) const noexcept
+  {
+#if defined(SJKXQ_STL_HAS_NUMA)
+    // 内核<linux/mempolicy.h>中的MPOL_*取值
+    static constexpr long mpol_preferred  = 1;
+    static constexpr long mpol_bind       = 2;
+    static constexpr long mpol_interleave = 3;
+    static constexpr long mpol_local      = 4;
+
+    long mpol = mpol_local;
+    switch (kind) {
+      case mode::preferred:
+        mpol = mpol_preferred;
+        break;
+      case mode::bind:
+        mpol = mpol_bind;
+        break;
+      case mode::interleave:
+        mpol = mpol_interleave;
+        break;
+      case mode::local:
+        return true;
+    }
+    unsigned long mask[64 / (8 * sizeof(unsigned long))] = {};
+    for (unsigned i = 0; i < 64; ++i) {
+      if (nodes & (std::uint64_t(1) << i)) {
+        mask[i / (8 * sizeof(unsigned long))] |= 1ul << (i % (8 * sizeof(unsigned long)));
+      }
+    }
+    // maxnode比掩码位数多1，与libnuma的调用方式一致
+    return ::syscall(SYS_mbind, addr, length, mpol, mask, 64 + 1, 0) == 0;
+#else
+    (void)addr;
+    (void)length;
+    return kind == mode::local;
+#endif
+  }
+
+private:
+  static std::uint64_t node_bit(int node)
+  {
+    if (node < 0 || node >= 64) {
+      throw std::invalid_argument("numa_policy: node out of range [0, 64)");
+    }
+    return std::uint64_t(1) << node;
+  }
+};
+
+/**
+ * @brief 按NUMA策略放置内存的分配器
+ *
+ * 不小于一页的分配直接通过mmap获得，在首次访问之前用mbind按numa_policy绑定，
+ * 因此无论哪个线程首先写入，页面都落在指定的节点上。
+ * 小于一页的分配来自operator new，不单独绑定（与同一页上的其他数据共享策略）：
+ * 节点型容器应使用按slab分配节点的版本（如pooled_list、哈希容器），让节点所在的slab整体绑定。
+ *
+ * 直接使用mbind系统调用，不依赖libnuma；在没有NUMA支持的平台上退化为operator new，策略被忽略。
+ * 只支持不超过alignof(std::max_align_t)的对齐要求。
+ */
+template <typename T>
+class numa_allocator
+{
+  static_assert(alignof(T) <= alignof(std::max_align_t), "numa_allocator: over-aligned types are not supported");
+
+public:
+  using value_type                             = T;
+  using size_type                              = std::size_t;
+  using difference_type                        = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+  using is_always_equal                        = std::false_type;
+
+  explicit numa_allocator(numa_policy policy = numa_policy()) noexcept : policy_(policy) {}
+
+  template <typename U>
+  numa_allocator(const numa_allocator<U>& other) noexcept : policy_(other.policy())
+  {
+  }
+
+  numa_policy policy() const noexcept { return policy_; }
+
+  T* allocate(size_type n)
+  {
+    if (n > size_type(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+#if defined(SJKXQ_STL_HAS_NUMA)
+    if (use_mmap(n)) {
+      const size_type length = mapped_length(n);
+      void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      policy_.apply(p, length);
+      return static_cast<T*>(p);
+    }
+#endif
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_type n) noexcept
+  {
+#if defined(SJKXQ_STL_HAS_NUMA)
+    if (use_mmap(n)) {
+      ::munmap(static_cast<void*>(p), mapped_length(n));
+      return;
+    }
+#endif
+    (void)n;
+    ::operator delete(static_cast<void*>(p));
+  }
+
+  friend bool operator==(const numa_allocator& lhs, const numa_allocator& rhs) noexcept
+  {
+    return lhs.policy_ == rhs.policy_;
+  }
+
+  friend bool operator!=(const numa_allocator& lhs, const numa_allocator& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  numa_policy policy_;
+
+#if defined(SJKXQ_STL_HAS_NUMA)
+  static size_type page_size() noexcept
+  {
+    static const size_type size = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  // 分配方式只取决于元素个数，deallocate可以据此还原
+  static bool use_mmap(size_type n) noexcept { return n * sizeof(T) >= page_size(); }
+
+  static size_type mapped_length(size_type n) noexcept
+  {
+    return (n * sizeof(T) + page_size() - 1) / page_size() * page_size();
+  }
+#endif
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_NUMA_ALLOCATOR_HPP
@@ -243,6 +243,11 @@ void swap(queue<T, Container>& lhs, queue<T, Container>& rhs) noexcept(noexcept(
   lhs.swap(rhs);
 }
 
+// 容器适配器能否按字节搬迁取决于底层容器
+template <typename T, typename Container>
+struct is_trivially_relocatable<queue<T, Container>> : is_trivially_relocatable<Container> {
+};
+
 }  // namespace sjkxq_stl
 
 #endif  // SJKXQ_STL_QUEUE_HPP
\ No newline at end of file
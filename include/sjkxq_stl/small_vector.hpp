@@ -0,0 +1,22 @@
+#ifndef SJKXQ_STL_SMALL_VECTOR_HPP
+#define SJKXQ_STL_SMALL_VECTOR_HPP
+
+#include "vector.hpp"
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 带内联缓冲区的vector
+ *
+ * 不超过N个元素时存放在对象内部，不进行任何堆分配；超出N个后与普通vector一样在堆上按增长策略扩容，
+ * shrink_to_fit能把不超过N个的元素搬回内联缓冲区。接口与vector完全相同。
+ * 移动和交换处于内联状态的small_vector需要逐个移动元素，是O(N)的，且会使迭代器失效。
+ */
+template <typename T, size_type N, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = default_growth>
+using small_vector = vector<T, Allocator, N, GrowthPolicy>;
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_SMALL_VECTOR_HPP
@@ -136,6 +136,11 @@ void swap(stack<T, Container>& lhs, stack<T, Container>& rhs) noexcept(noexcept(
   lhs.swap(rhs);
 }
 
+// 容器适配器能否按字节搬迁取决于底层容器
+template <typename T, typename Container>
+struct is_trivially_relocatable<stack<T, Container>> : is_trivially_relocatable<Container> {
+};
+
 }  // namespace sjkxq_stl
 
 #endif  // SJKXQ_STL_STACK_HPP
\ No newline at end of file
@@ -0,0 +1,359 @@
+#ifndef SJKXQ_STL_THREAD_CACHE_ALLOCATOR_HPP
+#define SJKXQ_STL_THREAD_CACHE_ALLOCATOR_HPP
+
+#include "common.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+namespace sjkxq_stl
+{
+
+/**
+ * @brief 带线程缓存的定长块池
+ *
+ * 每个线程持有两个弹匣（magazine，最多magazine_capacity个空闲块的栈），分配和释放只在本线程的弹匣上进行，
+ * 不需要任何同步。弹匣取空或装满时才与全局仓库（depot）整体交换：仓库是两个无锁栈，分别存放
+ * 装有空闲块的弹匣和空弹匣，栈顶带版本号以避免ABA问题。一个线程分配、另一个线程释放的块会随弹匣
+ * 经仓库回到分配方，因此生产者和消费者分处不同线程时既不需要锁，也不会泄漏。
+ *
+ * 仓库中没有可用的块时一次向operator new申请magazine_capacity个块装满弹匣。
+ * 块和弹匣在进程结束前都不归还，池的占用量等于历史上同时存活的块数的峰值。
+ * 每种块大小和对齐只有一个池，所有线程共享。
+ *
+ * 释放不会抛出异常：释放时需要的弹匣用nothrow方式申请，申请不到时把块挂到溢出链表上
+ * （链接指针就写在块里，因此块至少能放下一个指针），之后由分配方取回。
+ */
+template <std::size_t BlockSize, std::size_t Align>
+class thread_cache_pool
+{
+public:
+  static constexpr std::size_t block_size        = BlockSize;
+  static constexpr std::size_t magazine_capacity = 64;
+
+  static_assert(BlockSize > 0 && BlockSize % Align == 0, "thread_cache_pool: invalid block size");
+  static_assert(BlockSize >= sizeof(void*) && Align >= alignof(void*),
+                "thread_cache_pool: blocks must be able to hold a pointer");
+
+  static thread_cache_pool& instance()
+  {
+    // 有意不析构：其他线程缓存的析构可能晚于静态对象
+    static thread_cache_pool* pool = new thread_cache_pool();
+    return *pool;
+  }
+
+  void* allocate()
+  {
+    thread_cache& cache = local_cache();
+    if (!cache.loaded) {
+      cache.loaded = acquire_empty();
+    }
+    if (!cache.previous) {
+      cache.previous = acquire_empty();
+    }
+    magazine* m = cache.loaded;
+    if (m->count == 0) {
+      if (cache.previous->count > 0) {
+        std::swap(cache.loaded, cache.previous);
+      } else if (magazine* full = pop(full_)) {
+        // 两个弹匣都空了：留一个备用，另一个还给仓库，换回一个有块的弹匣
+        push(empty_, cache.previous);
+        cache.previous = cache.loaded;
+        cache.loaded   = full;
+      } else if (!take_overflow(cache.loaded)) {
+        refill(cache.loaded);
+      }
+      m = cache.loaded;
+    }
+    return m->blocks[--m->count];
+  }
+
+  void deallocate(void* p) noexcept
+  {
+    thread_cache& cache = local_cache();
+    magazine*     m     = cache.loaded;
+    if (!m || m->count == magazine_capacity) {
+      if (cache.previous && cache.previous->count == 0) {
+        std::swap(cache.loaded, cache.previous);
+      } else if (magazine* empty = acquire_empty(std::nothrow)) {
+        // 两个弹匣都满了：把一个交给仓库，换一个空弹匣
+        if (cache.previous) {
+          push(full_, cache.previous);
+        }
+        cache.previous = cache.loaded;
+        cache.loaded   = empty;
+      } else {
+        push_overflow(p);
+        return;
+      }
+      m = cache.loaded;
+    }
+    m->blocks[m->count++] = p;
+  }
+
+private:
+  struct magazine
+  {
+    std::atomic<std::uint32_t> next{0};  // 仓库栈中下一个弹匣的编号+1，0表示栈底
+    std::uint32_t              index = 0;
+    std::size_t                count = 0;
+    void*                      blocks[magazine_capacity];
+  };
+
+  // 弹匣按编号分段存放，编号可以与版本号一起装进一个64位原子量。
+  // 第k段有first_segment_size << k个弹匣，只用到少量块的池只占用第一段
+  static constexpr std::size_t first_segment_size = 8;
+  static constexpr std::size_t max_segments       = 30;  // 总数超过2^32，覆盖全部编号
+
+  std::atomic<magazine*>     segments_[max_segments] = {};
+  std::atomic<std::uint32_t> magazine_count_{0};
+  std::atomic<std::uint64_t> full_{0};   // 装有空闲块的弹匣：低32位为栈顶编号+1，高32位为版本号
+  std::atomic<std::uint64_t> empty_{0};  // 空弹匣
+  std::atomic<void*>         overflow_{nullptr};  // 释放时拿不到弹匣的块
+
+  // 每个线程的两个弹匣，线程退出时交还仓库。构造时申请不到弹匣则留空，由allocate补齐
+  struct thread_cache
+  {
+    magazine* loaded;
+    magazine* previous;
+
+    explicit thread_cache(thread_cache_pool& pool) noexcept
+        : loaded(pool.acquire_empty(std::nothrow)), previous(pool.acquire_empty(std::nothrow))
+    {
+    }
+
+    ~thread_cache()
+    {
+      thread_cache_pool& pool = instance();
+      for (magazine* m : {loaded, previous}) {
+        if (m) {
+          pool.push(m->count > 0 ? pool.full_ : pool.empty_, m);
+        }
+      }
+    }
+  };
+
+  thread_cache_pool() = default;
+
+  thread_cache& local_cache() noexcept
+  {
+    static thread_local thread_cache cache(*this);
+    return cache;
+  }
+
+  // 编号所在的段及该段第一个弹匣的编号
+  static std::size_t segment_of(std::uint32_t index, std::size_t& first) noexcept
+  {
+    std::size_t segment = 0;
+    std::size_t size    = first_segment_size;
+    first               = 0;
+    while (index >= first + size) {
+      first += size;
+      size <<= 1;
+      ++segment;
+    }
+    return segment;
+  }
+
+  magazine* at(std::uint32_t index) const noexcept
+  {
+    std::size_t       first;
+    const std::size_t segment = segment_of(index, first);
+    return segments_[segment].load(std::memory_order_acquire) + (index - first);
+  }
+
+  void push(std::atomic<std::uint64_t>& stack, magazine* m) noexcept
+  {
+    std::uint64_t old = stack.load(std::memory_order_relaxed);
+    std::uint64_t desired;
+    do {
+      m->next.store(static_cast<std::uint32_t>(old), std::memory_order_relaxed);
+      desired = ((old >> 32) + 1) << 32 | (m->index + 1);
+    } while (!stack.compare_exchange_weak(old, desired, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  magazine* pop(std::atomic<std::uint64_t>& stack) noexcept
+  {
+    std::uint64_t old = stack.load(std::memory_order_acquire);
+    for (;;) {
+      const std::uint32_t top = static_cast<std::uint32_t>(old);
+      if (top == 0) {
+        return nullptr;
+      }
+      // 弹匣从不释放，即使已被其他线程取走，读取next也是安全的；版本号保证此时CAS必然失败
+      magazine*           m       = at(top - 1);
+      const std::uint64_t desired = ((old >> 32) + 1) << 32 | m->next.load(std::memory_order_relaxed);
+      if (stack.compare_exchange_weak(old, desired, std::memory_order_acquire, std::memory_order_acquire)) {
+        return m;
+      }
+    }
+  }
+
+  // 从仓库取一个空弹匣，没有时新建
+  magazine* acquire_empty()
+  {
+    if (magazine* m = acquire_empty(std::nothrow)) {
+      return m;
+    }
+    throw std::bad_alloc();
+  }
+
+  // 同上，内存不足时返回nullptr
+  magazine* acquire_empty(const std::nothrow_t&) noexcept
+  {
+    if (magazine* m = pop(empty_)) {
+      return m;
+    }
+    std::uint32_t index = magazine_count_.load(std::memory_order_relaxed);
+    std::size_t   first;
+    std::size_t   segment;
+    do {
+      segment = segment_of(index, first);
+      if (segment >= max_segments || index == std::uint32_t(-1)) {
+        return nullptr;
+      }
+      if (!segments_[segment].load(std::memory_order_acquire) && !create_segment(segment, first)) {
+        return nullptr;
+      }
+      // 段已存在后才领取编号，申请段失败时编号不会被浪费
+    } while (!magazine_count_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+    return segments_[segment].load(std::memory_order_acquire) + (index - first);
+  }
+
+  // 新建第segment段（第一个弹匣的编号为first），其他线程已建好时使用它们的
+  bool create_segment(std::size_t segment, std::size_t first) noexcept
+  {
+    const std::size_t size  = first_segment_size << segment;
+    magazine*         fresh = new (std::nothrow) magazine[size];
+    if (!fresh) {
+      return false;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      fresh[i].index = static_cast<std::uint32_t>(first + i);
+    }
+    magazine* expected = nullptr;
+    if (!segments_[segment].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+      delete[] fresh;
+    }
+    return true;
+  }
+
+  static void* next_of(void* block) noexcept
+  {
+    void* next;
+    std::memcpy(&next, block, sizeof(next));
+    return next;
+  }
+
+  static void set_next(void* block, void* next) noexcept { std::memcpy(block, &next, sizeof(next)); }
+
+  // 把first到last（已经依次链接）整段放入溢出链表
+  void push_overflow(void* first, void* last) noexcept
+  {
+    void* head = overflow_.load(std::memory_order_relaxed);
+    do {
+      set_next(last, head);
+    } while (!overflow_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  void push_overflow(void* block) noexcept { push_overflow(block, block); }
+
+  // 把溢出链表上的块装入空弹匣m，装不下的放回链表；链表为空时返回false。
+  // 一次取走整个链表，不会出现逐个弹出时的ABA问题
+  bool take_overflow(magazine* m) noexcept
+  {
+    if (!overflow_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    void* head = overflow_.exchange(nullptr, std::memory_order_acquire);
+    if (!head) {
+      return false;
+    }
+    while (head && m->count < magazine_capacity) {
+      m->blocks[m->count++] = head;
+      head                  = next_of(head);
+    }
+    if (head) {
+      void* last = head;
+      while (void* next = next_of(last)) {
+        last = next;
+      }
+      push_overflow(head, last);
+    }
+    return true;
+  }
+
+  // 向operator new申请一批新块装满空弹匣m
+  static void refill(magazine* m)
+  {
+    char* chunk = static_cast<char*>(::operator new(BlockSize * magazine_capacity, std::align_val_t(Align)));
+    for (std::size_t i = 0; i < magazine_capacity; ++i) {
+      m->blocks[i] = chunk + i * BlockSize;
+    }
+    m->count = magazine_capacity;
+  }
+};
+
+/**
+ * @brief 基于thread_cache_pool的分配器
+ *
+ * 单个对象（n == 1）的分配走对应大小的线程缓存池，可以在任意线程释放；其余请求直接使用operator new。
+ * 无状态，所有实例都相等，适合作为list等逐个分配节点的容器的分配器（经rebind后按节点大小取池）。
+ * 哈希容器自己按slab成批分配节点，使用本分配器时只有节点句柄等单个对象的分配经过线程缓存。
+ */
+template <typename T>
+class thread_cache_allocator
+{
+public:
+  using value_type      = T;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using is_always_equal = std::true_type;
+
+  thread_cache_allocator() noexcept = default;
+
+  template <typename U>
+  thread_cache_allocator(const thread_cache_allocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(size_type n)
+  {
+    if (n == 1) {
+      return static_cast<T*>(pool_type::instance().allocate());
+    }
+    if (n > size_type(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+  }
+
+  void deallocate(T* p, size_type n) noexcept
+  {
+    if (n == 1) {
+      pool_type::instance().deallocate(p);
+    } else {
+      ::operator delete(static_cast<void*>(p), std::align_val_t(alignof(T)));
+    }
+  }
+
+  friend bool operator==(const thread_cache_allocator&, const thread_cache_allocator&) noexcept { return true; }
+
+  friend bool operator!=(const thread_cache_allocator&, const thread_cache_allocator&) noexcept { return false; }
+
+private:
+  // 大小和对齐相同的类型共用一个池；块至少能放下一个指针，供释放时挂入溢出链表
+  static constexpr std::size_t block_align = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+  static constexpr std::size_t block_size =
+      ((sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*)) + block_align - 1) / block_align * block_align;
+
+  using pool_type = thread_cache_pool<block_size, block_align>;
+};
+
+}  // namespace sjkxq_stl
+
+#endif  // SJKXQ_STL_THREAD_CACHE_ALLOCATOR_HPP
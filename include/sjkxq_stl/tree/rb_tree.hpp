@@ -0,0 +1,606 @@
+#ifndef SJKXQ_STL_RB_TREE_HPP
+#define SJKXQ_STL_RB_TREE_HPP
+
+#include "../common.hpp"
+#include "../container_base/memory_base.hpp"
+#include "rb_tree_node.hpp"
+#include "rb_tree_iterator.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sjkxq_stl {
+
+/**
+ * @brief 红黑树核心
+ *
+ * map 与 set 共用此实现。Policy 描述元素类型以及如何从元素中取出键：
+ *   key_type、value_type、constant_values（迭代器是否只读）、
+ *   static const key_type& key(const value_type&)
+ * 键唯一；节点通过 memory_base 用分配器分配，颜色位压缩在父节点指针中。
+ * 头节点是树对象的成员，根节点的parent指向它，因此移动和交换后需要修正根节点的parent。
+ */
+template <typename Policy, typename Compare, typename Allocator>
+class rb_tree
+    : protected memory_base<rb_tree_node<typename Policy::value_type>,
+                            typename std::allocator_traits<Allocator>::template rebind_alloc<
+                                rb_tree_node<typename Policy::value_type>>> {
+public:
+    // 类型定义
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<Allocator>::pointer;
+    using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
+
+    using iterator = rb_tree_iterator<value_type, !Policy::constant_values>;
+    using const_iterator = rb_tree_iterator<value_type, false>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using node_type = rb_tree_node<value_type>;
+    using node_ptr = node_type*;
+    using base_ptr = rb_tree_node_base*;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+    using memory_base_type = memory_base<node_type, node_allocator>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    rb_tree_node_base header_;  // parent为根，left为最小节点，right为最大节点
+    size_type node_count_;
+    Compare comp_;
+
+    static const key_type& key_of(const rb_tree_node_base* x) noexcept {
+        return Policy::key(static_cast<const node_type*>(x)->value);
+    }
+
+    base_ptr header() const noexcept { return const_cast<base_ptr>(&header_); }
+    base_ptr root() const noexcept { return header_.parent(); }
+
+    void reset_header() noexcept {
+        header_.parent_color = 0;  // 根为空，头节点为红色
+        header_.left = &header_;
+        header_.right = &header_;
+        node_count_ = 0;
+    }
+
+    // 接管other的所有节点，other变为空树。
+    // 移动构造时header_尚未初始化，先重置以保证头节点为红色，set_parent会保留原有的颜色位
+    void steal(rb_tree& other) noexcept {
+        reset_header();
+        if (other.root()) {
+            header_.set_parent(other.root());
+            header_.left = other.header_.left;
+            header_.right = other.header_.right;
+            root()->set_parent(&header_);
+            node_count_ = other.node_count_;
+            other.reset_header();
+        }
+    }
+
+    template <typename... Args>
+    node_ptr create_node(Args&&... args) {
+        node_ptr p = this->allocate(1);
+        try {
+            this->construct(p, std::forward<Args>(args)...);
+        } catch (...) {
+            this->deallocate(p, 1);
+            throw;
+        }
+        return p;
+    }
+
+    void destroy_node(base_ptr p) noexcept {
+        node_ptr node = static_cast<node_ptr>(p);
+        this->destroy(node);
+        this->deallocate(node, 1);
+    }
+
+    // 释放以x为根的子树：对右子树递归，沿左子树循环，递归深度不超过树高
+    void erase_subtree(base_ptr x) noexcept {
+        while (x) {
+            erase_subtree(x->right);
+            base_ptr left = x->left;
+            destroy_node(x);
+            x = left;
+        }
+    }
+
+    // 按原样复制以x为根的子树，颜色和形状都与原树相同，不需要任何比较和旋转
+    base_ptr copy_subtree(const rb_tree_node_base* x, base_ptr parent) {
+        base_ptr top = create_node(static_cast<const node_type*>(x)->value);
+        top->parent_color = x->parent_color;
+        top->set_parent(parent);
+        top->left = nullptr;
+        top->right = nullptr;
+        try {
+            if (x->right) {
+                top->right = copy_subtree(x->right, top);
+            }
+            parent = top;
+            x = x->left;
+            while (x) {
+                base_ptr y = create_node(static_cast<const node_type*>(x)->value);
+                y->parent_color = x->parent_color;
+                y->set_parent(parent);
+                y->left = nullptr;
+                y->right = nullptr;
+                parent->left = y;
+                if (x->right) {
+                    y->right = copy_subtree(x->right, y);
+                }
+                parent = y;
+                x = x->left;
+            }
+        } catch (...) {
+            erase_subtree(top);
+            throw;
+        }
+        return top;
+    }
+
+    void copy_from(const rb_tree& other) {
+        if (other.root()) {
+            header_.set_parent(copy_subtree(other.root(), &header_));
+            header_.left = rb_tree_node_base::minimum(root());
+            header_.right = rb_tree_node_base::maximum(root());
+            node_count_ = other.node_count_;
+        }
+    }
+
+    // 查找键k的插入位置
+    // 返回 {x, p}：p为空表示键已存在，x是等价节点；否则新节点作为p的子节点插入，x非空时强制插在左侧
+    std::pair<base_ptr, base_ptr> get_insert_unique_pos(const key_type& k) const {
+        base_ptr x = root();
+        base_ptr y = header();
+        bool go_left = true;
+        while (x) {
+            y = x;
+            go_left = comp_(k, key_of(x));
+            x = go_left ? x->left : x->right;
+        }
+
+        base_ptr j = y;
+        if (go_left) {
+            if (j == header_.left) {
+                return {nullptr, y};
+            }
+            j = rb_tree_decrement(j);
+        }
+        if (comp_(key_of(j), k)) {
+            return {nullptr, y};
+        }
+        return {j, nullptr};
+    }
+
+    // 带提示的插入位置：提示正确时只需与相邻元素比较一两次
+    std::pair<base_ptr, base_ptr> get_insert_hint_unique_pos(const_iterator hint, const key_type& k) const {
+        base_ptr pos = hint.get_node();
+
+        if (pos == header()) {
+            if (node_count_ > 0 && comp_(key_of(header_.right), k)) {
+                return {nullptr, header_.right};
+            }
+            return get_insert_unique_pos(k);
+        }
+
+        if (comp_(k, key_of(pos))) {
+            if (pos == header_.left) {
+                return {pos, pos};
+            }
+            base_ptr before = rb_tree_decrement(pos);
+            if (comp_(key_of(before), k)) {
+                if (!before->right) {
+                    return {nullptr, before};
+                }
+                return {pos, pos};
+            }
+            return get_insert_unique_pos(k);
+        }
+
+        if (comp_(key_of(pos), k)) {
+            if (pos == header_.right) {
+                return {nullptr, pos};
+            }
+            base_ptr after = rb_tree_increment(pos);
+            if (comp_(k, key_of(after))) {
+                if (!pos->right) {
+                    return {nullptr, pos};
+                }
+                return {after, after};
+            }
+            return get_insert_unique_pos(k);
+        }
+
+        return {pos, nullptr};  // 键等价
+    }
+
+    iterator insert_node(base_ptr x, base_ptr p, node_ptr z) noexcept {
+        bool insert_left = x != nullptr || p == header() || comp_(key_of(z), key_of(p));
+        rb_tree_insert_and_rebalance(insert_left, z, p, header_);
+        ++node_count_;
+        return iterator(z);
+    }
+
+    template <typename K>
+    base_ptr lower_bound_node(const K& k) const {
+        base_ptr x = root();
+        base_ptr y = header();
+        while (x) {
+            if (!comp_(key_of(x), k)) {
+                y = x;
+                x = x->left;
+            } else {
+                x = x->right;
+            }
+        }
+        return y;
+    }
+
+    template <typename K>
+    base_ptr upper_bound_node(const K& k) const {
+        base_ptr x = root();
+        base_ptr y = header();
+        while (x) {
+            if (comp_(k, key_of(x))) {
+                y = x;
+                x = x->left;
+            } else {
+                x = x->right;
+            }
+        }
+        return y;
+    }
+
+    template <typename K>
+    base_ptr find_node(const K& k) const {
+        base_ptr j = lower_bound_node(k);
+        return (j == header() || comp_(k, key_of(j))) ? header() : j;
+    }
+
+protected:
+    // 键不存在时才用args构造元素
+    template <typename... Args>
+    std::pair<iterator, bool> insert_unique(const key_type& k, Args&&... args) {
+        auto pos = get_insert_unique_pos(k);
+        if (!pos.second) {
+            return {iterator(pos.first), false};
+        }
+        return {insert_node(pos.first, pos.second, create_node(std::forward<Args>(args)...)), true};
+    }
+
+    template <typename... Args>
+    iterator insert_hint_unique(const_iterator hint, const key_type& k, Args&&... args) {
+        auto pos = get_insert_hint_unique_pos(hint, k);
+        if (!pos.second) {
+            return iterator(pos.first);
+        }
+        return insert_node(pos.first, pos.second, create_node(std::forward<Args>(args)...));
+    }
+
+public:
+    // 构造函数
+    rb_tree() : rb_tree(Compare()) {}
+
+    explicit rb_tree(const Compare& comp, const Allocator& alloc = Allocator())
+        : memory_base_type(node_allocator(alloc)), node_count_(0), comp_(comp) {
+        reset_header();
+    }
+
+    explicit rb_tree(const Allocator& alloc) : rb_tree(Compare(), alloc) {}
+
+    template <typename InputIt>
+    rb_tree(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : rb_tree(comp, alloc) {
+        insert(first, last);
+    }
+
+    template <typename InputIt>
+    rb_tree(InputIt first, InputIt last, const Allocator& alloc) : rb_tree(first, last, Compare(), alloc) {}
+
+    rb_tree(std::initializer_list<value_type> init,
+            const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+        : rb_tree(init.begin(), init.end(), comp, alloc) {}
+
+    rb_tree(std::initializer_list<value_type> init, const Allocator& alloc)
+        : rb_tree(init.begin(), init.end(), Compare(), alloc) {}
+
+    rb_tree(const rb_tree& other)
+        : rb_tree(other, node_traits::select_on_container_copy_construction(other.alloc)) {}
+
+    rb_tree(const rb_tree& other, const Allocator& alloc) : rb_tree(other.comp_, alloc) {
+        copy_from(other);
+    }
+
+    rb_tree(rb_tree&& other) noexcept
+        : memory_base_type(std::move(other.alloc)), node_count_(0), comp_(std::move(other.comp_)) {
+        steal(other);
+    }
+
+    // 分配器不相等时节点不能直接接管，只能逐个移动元素
+    rb_tree(rb_tree&& other, const Allocator& alloc) : rb_tree(other.comp_, alloc) {
+        if (this->alloc == other.alloc) {
+            steal(other);
+        } else {
+            for (auto it = other.begin(); it != other.end(); ++it) {
+                emplace_hint(cend(), std::move(const_cast<value_type&>(*it)));
+            }
+            other.clear();
+        }
+    }
+
+    rb_tree& operator=(const rb_tree& other) {
+        if (this != &other) {
+            clear();
+            copy_assign_allocator(this->alloc, other.alloc);
+            comp_ = other.comp_;
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    // 分配器不传播且与other的不相等时，同样只能逐个移动元素
+    rb_tree& operator=(rb_tree&& other) noexcept(
+        node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value) {
+        if (this != &other) {
+            clear();
+            comp_ = std::move(other.comp_);
+            if (allocator_can_steal(this->alloc, other.alloc)) {
+                move_assign_allocator(this->alloc, other.alloc);
+                steal(other);
+            } else {
+                for (auto it = other.begin(); it != other.end(); ++it) {
+                    emplace_hint(cend(), std::move(const_cast<value_type&>(*it)));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    rb_tree& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    ~rb_tree() {
+        erase_subtree(root());
+    }
+
+    // 获取分配器
+    allocator_type get_allocator() const noexcept { return allocator_type(this->alloc); }
+
+    // 迭代器
+    iterator begin() noexcept { return iterator(header_.left); }
+    const_iterator begin() const noexcept { return const_iterator(header_.left); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(header()); }
+    const_iterator end() const noexcept { return const_iterator(header()); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量
+    bool empty() const noexcept { return node_count_ == 0; }
+    size_type size() const noexcept { return node_count_; }
+    size_type max_size() const noexcept { return node_traits::max_size(this->alloc); }
+
+    // 修改器
+    void clear() noexcept {
+        erase_subtree(root());
+        reset_header();
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert_unique(Policy::key(value), value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_unique(Policy::key(value), std::move(value));
+    }
+
+    iterator insert(const_iterator hint, const value_type& value) {
+        return insert_hint_unique(hint, Policy::key(value), value);
+    }
+
+    iterator insert(const_iterator hint, value_type&& value) {
+        return insert_hint_unique(hint, Policy::key(value), std::move(value));
+    }
+
+    // 以end()为提示逐个插入，输入已有序时每次插入只需一次比较
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace_hint(cend(), *first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+    // 先构造节点再按它的键查找位置，键已存在时释放节点
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        node_ptr z = create_node(std::forward<Args>(args)...);
+        auto pos = get_insert_unique_pos(key_of(z));
+        if (!pos.second) {
+            destroy_node(z);
+            return {iterator(pos.first), false};
+        }
+        return {insert_node(pos.first, pos.second, z), true};
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        node_ptr z = create_node(std::forward<Args>(args)...);
+        auto pos = get_insert_hint_unique_pos(hint, key_of(z));
+        if (!pos.second) {
+            destroy_node(z);
+            return iterator(pos.first);
+        }
+        return insert_node(pos.first, pos.second, z);
+    }
+
+    iterator erase(const_iterator pos) {
+        base_ptr x = pos.get_node();
+        iterator next(rb_tree_increment(x));
+        destroy_node(rb_tree_rebalance_for_erase(x, header_));
+        --node_count_;
+        return next;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first == cbegin() && last == cend()) {
+            clear();
+        } else {
+            while (first != last) {
+                first = erase(first);
+            }
+        }
+        return iterator(last.get_node());
+    }
+
+    size_type erase(const key_type& key) {
+        base_ptr x = find_node(key);
+        if (x == header()) {
+            return 0;
+        }
+        erase(const_iterator(x));
+        return 1;
+    }
+
+    void swap(rb_tree& other) noexcept(std::is_nothrow_swappable<Compare>::value) {
+        if (this == &other) {
+            return;
+        }
+        // 比较器最先交换，抛出异常时两棵树保持原样
+        using std::swap;
+        swap(comp_, other.comp_);
+        std::swap(header_, other.header_);
+        std::swap(node_count_, other.node_count_);
+        swap_allocator(this->alloc, other.alloc);
+
+        // 头节点交换了位置，修正根节点的parent；空树的最小/最大指针要指回自己的头节点
+        for (rb_tree* t : {this, &other}) {
+            if (t->root()) {
+                t->root()->set_parent(&t->header_);
+            } else {
+                t->reset_header();
+            }
+        }
+    }
+
+    // 查找（模板重载为异构查找，只在比较器声明is_transparent时启用）
+    size_type count(const key_type& key) const { return find_node(key) == header() ? 0 : 1; }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K& x) const {
+        return find_node(x) == header() ? 0 : 1;
+    }
+
+    iterator find(const key_type& key) { return iterator(find_node(key)); }
+
+    const_iterator find(const key_type& key) const { return const_iterator(find_node(key)); }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K& x) {
+        return iterator(find_node(x));
+    }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const K& x) const {
+        return const_iterator(find_node(x));
+    }
+
+    bool contains(const key_type& key) const { return find_node(key) != header(); }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const K& x) const {
+        return find_node(x) != header();
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& x) {
+        return {lower_bound(x), upper_bound(x)};
+    }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K& x) const {
+        return {lower_bound(x), upper_bound(x)};
+    }
+
+    iterator lower_bound(const key_type& key) { return iterator(lower_bound_node(key)); }
+
+    const_iterator lower_bound(const key_type& key) const { return const_iterator(lower_bound_node(key)); }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K& x) {
+        return iterator(lower_bound_node(x));
+    }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K& x) const {
+        return const_iterator(lower_bound_node(x));
+    }
+
+    iterator upper_bound(const key_type& key) { return iterator(upper_bound_node(key)); }
+
+    const_iterator upper_bound(const key_type& key) const { return const_iterator(upper_bound_node(key)); }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K& x) {
+        return iterator(upper_bound_node(x));
+    }
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K& x) const {
+        return const_iterator(upper_bound_node(x));
+    }
+
+    // 观察器
+    key_compare key_comp() const { return comp_; }
+
+    // 比较运算符：按中序逐个比较元素
+    friend bool operator==(const rb_tree& lhs, const rb_tree& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const rb_tree& lhs, const rb_tree& rhs) { return !(lhs == rhs); }
+
+    friend bool operator<(const rb_tree& lhs, const rb_tree& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator<=(const rb_tree& lhs, const rb_tree& rhs) { return !(rhs < lhs); }
+
+    friend bool operator>(const rb_tree& lhs, const rb_tree& rhs) { return rhs < lhs; }
+
+    friend bool operator>=(const rb_tree& lhs, const rb_tree& rhs) { return !(lhs < rhs); }
+};
+
+} // namespace sjkxq_stl
+
+#endif // SJKXQ_STL_RB_TREE_HPP
@@ -0,0 +1,80 @@
+#ifndef SJKXQ_STL_RB_TREE_ITERATOR_HPP
+#define SJKXQ_STL_RB_TREE_ITERATOR_HPP
+
+#include "rb_tree_node.hpp"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace sjkxq_stl {
+
+// 红黑树的双向迭代器，按中序遍历；end()指向头节点
+// Mutable为false时只能读取元素（set的迭代器和所有const_iterator）
+template <typename T, bool Mutable>
+class rb_tree_iterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Mutable, T*, const T*>;
+    using reference = std::conditional_t<Mutable, T&, const T&>;
+
+    using base_ptr = rb_tree_node_base*;
+    using node_ptr = rb_tree_node<T>*;
+
+    rb_tree_iterator() noexcept : node_(nullptr) {}
+
+    explicit rb_tree_iterator(base_ptr x) noexcept : node_(x) {}
+
+    // 可修改的迭代器可以隐式转换为只读迭代器
+    template <bool M = Mutable, typename = std::enable_if_t<!M>>
+    rb_tree_iterator(const rb_tree_iterator<T, true>& it) noexcept : node_(it.get_node()) {}
+
+    reference operator*() const noexcept {
+        return static_cast<node_ptr>(node_)->value;
+    }
+
+    pointer operator->() const noexcept {
+        return std::addressof(static_cast<node_ptr>(node_)->value);
+    }
+
+    rb_tree_iterator& operator++() noexcept {
+        node_ = rb_tree_increment(node_);
+        return *this;
+    }
+
+    rb_tree_iterator operator++(int) noexcept {
+        rb_tree_iterator tmp = *this;
+        node_ = rb_tree_increment(node_);
+        return tmp;
+    }
+
+    rb_tree_iterator& operator--() noexcept {
+        node_ = rb_tree_decrement(node_);
+        return *this;
+    }
+
+    rb_tree_iterator operator--(int) noexcept {
+        rb_tree_iterator tmp = *this;
+        node_ = rb_tree_decrement(node_);
+        return tmp;
+    }
+
+    base_ptr get_node() const noexcept { return node_; }
+
+    friend bool operator==(const rb_tree_iterator& lhs, const rb_tree_iterator& rhs) noexcept {
+        return lhs.node_ == rhs.node_;
+    }
+
+    friend bool operator!=(const rb_tree_iterator& lhs, const rb_tree_iterator& rhs) noexcept {
+        return lhs.node_ != rhs.node_;
+    }
+
+private:
+    base_ptr node_;
+};
+
+} // namespace sjkxq_stl
+
+#endif // SJKXQ_STL_RB_TREE_ITERATOR_HPP
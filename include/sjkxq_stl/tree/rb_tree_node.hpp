@@ -0,0 +1,343 @@
+#ifndef SJKXQ_STL_RB_TREE_NODE_HPP
+#define SJKXQ_STL_RB_TREE_NODE_HPP
+
+#include <cstdint>
+#include <utility>
+
+namespace sjkxq_stl {
+
+/*
+ * 红黑树节点基类
+ *
+ * 节点至少按指针对齐，父节点指针的最低位恒为0，这里用它保存颜色（0为红，1为黑），
+ * 所以每个节点只有三个指针的开销，不需要单独的颜色字段。
+ *
+ * 树的头节点（header）也是一个rb_tree_node_base：parent指向根节点，left指向最小节点，
+ * right指向最大节点；根节点的parent指向头节点。头节点始终是红色，据此与根节点区分。
+ */
+struct rb_tree_node_base {
+    using base_ptr = rb_tree_node_base*;
+
+    std::uintptr_t parent_color;  // 父节点指针 | 颜色位
+    base_ptr left;
+    base_ptr right;
+
+    static constexpr std::uintptr_t black_bit = 1;
+
+    base_ptr parent() const noexcept {
+        return reinterpret_cast<base_ptr>(parent_color & ~black_bit);
+    }
+
+    void set_parent(base_ptr p) noexcept {
+        parent_color = reinterpret_cast<std::uintptr_t>(p) | (parent_color & black_bit);
+    }
+
+    bool is_red() const noexcept { return !(parent_color & black_bit); }
+    bool is_black() const noexcept { return (parent_color & black_bit) != 0; }
+    void set_red() noexcept { parent_color &= ~black_bit; }
+    void set_black() noexcept { parent_color |= black_bit; }
+
+    void set_color_of(const rb_tree_node_base* other) noexcept {
+        parent_color = (parent_color & ~black_bit) | (other->parent_color & black_bit);
+    }
+
+    static base_ptr minimum(base_ptr x) noexcept {
+        while (x->left) {
+            x = x->left;
+        }
+        return x;
+    }
+
+    static base_ptr maximum(base_ptr x) noexcept {
+        while (x->right) {
+            x = x->right;
+        }
+        return x;
+    }
+};
+
+static_assert(alignof(rb_tree_node_base) >= 2, "颜色位需要父节点指针的最低位恒为0");
+
+// 保存元素的节点
+template <typename T>
+struct rb_tree_node : public rb_tree_node_base {
+    T value;
+
+    template <typename... Args>
+    explicit rb_tree_node(Args&&... args) : value(std::forward<Args>(args)...) {}
+};
+
+// 中序后继；对最大节点调用得到头节点
+inline rb_tree_node_base* rb_tree_increment(rb_tree_node_base* x) noexcept {
+    if (x->right) {
+        return rb_tree_node_base::minimum(x->right);
+    }
+    rb_tree_node_base* y = x->parent();
+    while (x == y->right) {
+        x = y;
+        y = y->parent();
+    }
+    // 树只有根节点时，根的父节点是头节点，而头节点的right又指向根，此时x已经是头节点
+    return x->right != y ? y : x;
+}
+
+// 中序前驱；对头节点调用得到最大节点
+inline rb_tree_node_base* rb_tree_decrement(rb_tree_node_base* x) noexcept {
+    if (x->is_red() && x->parent()->parent() == x) {
+        return x->right;  // x是头节点
+    }
+    if (x->left) {
+        return rb_tree_node_base::maximum(x->left);
+    }
+    rb_tree_node_base* y = x->parent();
+    while (x == y->left) {
+        x = y;
+        y = y->parent();
+    }
+    return y;
+}
+
+inline void rb_tree_rotate_left(rb_tree_node_base* x, rb_tree_node_base& header) noexcept {
+    rb_tree_node_base* y = x->right;
+    x->right = y->left;
+    if (y->left) {
+        y->left->set_parent(x);
+    }
+    y->set_parent(x->parent());
+
+    if (x == header.parent()) {
+        header.set_parent(y);
+    } else if (x == x->parent()->left) {
+        x->parent()->left = y;
+    } else {
+        x->parent()->right = y;
+    }
+    y->left = x;
+    x->set_parent(y);
+}
+
+inline void rb_tree_rotate_right(rb_tree_node_base* x, rb_tree_node_base& header) noexcept {
+    rb_tree_node_base* y = x->left;
+    x->left = y->right;
+    if (y->right) {
+        y->right->set_parent(x);
+    }
+    y->set_parent(x->parent());
+
+    if (x == header.parent()) {
+        header.set_parent(y);
+    } else if (x == x->parent()->right) {
+        x->parent()->right = y;
+    } else {
+        x->parent()->left = y;
+    }
+    y->right = x;
+    x->set_parent(y);
+}
+
+// 把新节点x挂到p的左侧或右侧，并恢复红黑性质；同时维护头节点的最小/最大指针
+inline void rb_tree_insert_and_rebalance(bool insert_left,
+                                         rb_tree_node_base* x,
+                                         rb_tree_node_base* p,
+                                         rb_tree_node_base& header) noexcept {
+    x->parent_color = reinterpret_cast<std::uintptr_t>(p);  // 新节点为红色
+    x->left = nullptr;
+    x->right = nullptr;
+
+    if (insert_left) {
+        p->left = x;  // 空树时p是头节点，这里同时设置了最小节点
+        if (p == &header) {
+            header.set_parent(x);
+            header.right = x;
+        } else if (p == header.left) {
+            header.left = x;
+        }
+    } else {
+        p->right = x;
+        if (p == header.right) {
+            header.right = x;
+        }
+    }
+
+    // 父节点为红时违反性质，按叔节点的颜色重新着色或旋转
+    while (x != header.parent() && x->parent()->is_red()) {
+        rb_tree_node_base* const xpp = x->parent()->parent();
+
+        if (x->parent() == xpp->left) {
+            rb_tree_node_base* const y = xpp->right;
+            if (y && y->is_red()) {
+                x->parent()->set_black();
+                y->set_black();
+                xpp->set_red();
+                x = xpp;
+            } else {
+                if (x == x->parent()->right) {
+                    x = x->parent();
+                    rb_tree_rotate_left(x, header);
+                }
+                x->parent()->set_black();
+                xpp->set_red();
+                rb_tree_rotate_right(xpp, header);
+            }
+        } else {
+            rb_tree_node_base* const y = xpp->left;
+            if (y && y->is_red()) {
+                x->parent()->set_black();
+                y->set_black();
+                xpp->set_red();
+                x = xpp;
+            } else {
+                if (x == x->parent()->left) {
+                    x = x->parent();
+                    rb_tree_rotate_right(x, header);
+                }
+                x->parent()->set_black();
+                xpp->set_red();
+                rb_tree_rotate_left(xpp, header);
+            }
+        }
+    }
+    header.parent()->set_black();
+}
+
+// 从树中摘下节点z并恢复红黑性质，返回实际需要释放的节点（即z本身）
+inline rb_tree_node_base* rb_tree_rebalance_for_erase(rb_tree_node_base* const z,
+                                                      rb_tree_node_base& header) noexcept {
+    rb_tree_node_base* y = z;
+    rb_tree_node_base* x = nullptr;
+    rb_tree_node_base* x_parent = nullptr;
+
+    if (!y->left) {
+        x = y->right;  // z至多有一个非空子节点，x可能为空
+    } else if (!y->right) {
+        x = y->left;
+    } else {
+        y = rb_tree_node_base::minimum(y->right);  // z有两个子节点，用后继y顶替z
+        x = y->right;
+    }
+
+    if (y != z) {
+        // 把y移到z的位置
+        z->left->set_parent(y);
+        y->left = z->left;
+        if (y != z->right) {
+            x_parent = y->parent();
+            if (x) {
+                x->set_parent(y->parent());
+            }
+            y->parent()->left = x;
+            y->right = z->right;
+            z->right->set_parent(y);
+        } else {
+            x_parent = y;
+        }
+
+        if (header.parent() == z) {
+            header.set_parent(y);
+        } else if (z->parent()->left == z) {
+            z->parent()->left = y;
+        } else {
+            z->parent()->right = y;
+        }
+        y->set_parent(z->parent());
+
+        // 交换y和z的颜色，之后按删除z原位置上的颜色处理
+        const bool y_was_black = y->is_black();
+        y->set_color_of(z);
+        if (y_was_black) {
+            z->set_black();
+        } else {
+            z->set_red();
+        }
+        y = z;
+    } else {
+        x_parent = y->parent();
+        if (x) {
+            x->set_parent(y->parent());
+        }
+
+        if (header.parent() == z) {
+            header.set_parent(x);
+        } else if (z->parent()->left == z) {
+            z->parent()->left = x;
+        } else {
+            z->parent()->right = x;
+        }
+
+        if (header.left == z) {
+            header.left = z->right ? rb_tree_node_base::minimum(x) : z->parent();
+        }
+        if (header.right == z) {
+            header.right = z->left ? rb_tree_node_base::maximum(x) : z->parent();
+        }
+    }
+
+    // 删除的是黑节点时，x所在路径少了一个黑节点，需要从兄弟子树借或向上传递
+    if (y->is_black()) {
+        while (x != header.parent() && (!x || x->is_black())) {
+            if (x == x_parent->left) {
+                rb_tree_node_base* w = x_parent->right;
+                if (w->is_red()) {
+                    w->set_black();
+                    x_parent->set_red();
+                    rb_tree_rotate_left(x_parent, header);
+                    w = x_parent->right;
+                }
+                if ((!w->left || w->left->is_black()) && (!w->right || w->right->is_black())) {
+                    w->set_red();
+                    x = x_parent;
+                    x_parent = x_parent->parent();
+                } else {
+                    if (!w->right || w->right->is_black()) {
+                        w->left->set_black();
+                        w->set_red();
+                        rb_tree_rotate_right(w, header);
+                        w = x_parent->right;
+                    }
+                    w->set_color_of(x_parent);
+                    x_parent->set_black();
+                    if (w->right) {
+                        w->right->set_black();
+                    }
+                    rb_tree_rotate_left(x_parent, header);
+                    break;
+                }
+            } else {
+                rb_tree_node_base* w = x_parent->left;
+                if (w->is_red()) {
+                    w->set_black();
+                    x_parent->set_red();
+                    rb_tree_rotate_right(x_parent, header);
+                    w = x_parent->left;
+                }
+                if ((!w->right || w->right->is_black()) && (!w->left || w->left->is_black())) {
+                    w->set_red();
+                    x = x_parent;
+                    x_parent = x_parent->parent();
+                } else {
+                    if (!w->left || w->left->is_black()) {
+                        w->right->set_black();
+                        w->set_red();
+                        rb_tree_rotate_left(w, header);
+                        w = x_parent->left;
+                    }
+                    w->set_color_of(x_parent);
+                    x_parent->set_black();
+                    if (w->left) {
+                        w->left->set_black();
+                    }
+                    rb_tree_rotate_right(x_parent, header);
+                    break;
+                }
+            }
+        }
+        if (x) {
+            x->set_black();
+        }
+    }
+    return y;
+}
+
+} // namespace sjkxq_stl
+
+#endif // SJKXQ_STL_RB_TREE_NODE_HPP
@@ -2,351 +2,160 @@
 #define SJKXQ_STL_UNORDERED_MAP_HPP
 
 #include "common.hpp"
+#include "hashtable/hashtable.hpp"
 #include <functional>
 #include <memory>
-#include <unordered_map>
+#include <tuple>
 
 namespace sjkxq_stl
 {
 
-template <typename Key,
-          typename T,
-          typename Hash      = std::hash<Key>,
-          typename KeyEqual  = std::equal_to<Key>,
-          typename Allocator = std::allocator<std::pair<const Key, T>>>
-class unordered_map
-{
-public:
-  // 类型定义
-  using key_type        = Key;
-  using mapped_type     = T;
-  using value_type      = std::pair<const Key, T>;
-  using size_type       = std::size_t;
-  using difference_type = std::ptrdiff_t;
-  using hasher          = Hash;
-  using key_equal       = KeyEqual;
-  using allocator_type  = Allocator;
-  using reference       = value_type&;
-  using const_reference = const value_type&;
-  using pointer         = typename std::allocator_traits<Allocator>::pointer;
-  using const_pointer   = typename std::allocator_traits<Allocator>::const_pointer;
-
-  // 内部使用std::unordered_map作为实现
-  using impl_type = std::unordered_map<Key, T, Hash, KeyEqual, Allocator>;
-
-  // 迭代器类型
-  using iterator             = typename impl_type::iterator;
-  using const_iterator       = typename impl_type::const_iterator;
-  using local_iterator       = typename impl_type::local_iterator;
-  using const_local_iterator = typename impl_type::const_local_iterator;
-
-private:
-  impl_type m_map;  // 底层实现
-
-public:
-  // 构造函数
-  unordered_map() : m_map() {}
-
-  explicit unordered_map(size_type        bucket_count,
-                         const Hash&      hash  = Hash(),
-                         const KeyEqual&  equal = KeyEqual(),
-                         const Allocator& alloc = Allocator())
-      : m_map(bucket_count, hash, equal, alloc)
-  {
-  }
-
-  unordered_map(size_type bucket_count, const Allocator& alloc)
-      : m_map(bucket_count, Hash(), KeyEqual(), alloc)
-  {
-  }
-
-  unordered_map(size_type bucket_count, const Hash& hash, const Allocator& alloc)
-      : m_map(bucket_count, hash, KeyEqual(), alloc)
-  {
-  }
-
-  explicit unordered_map(const Allocator& alloc) : m_map(alloc) {}
-
-  template <typename InputIt>
-  unordered_map(InputIt          first,
-                InputIt          last,
-                size_type        bucket_count = 0,
-                const Hash&      hash         = Hash(),
-                const KeyEqual&  equal        = KeyEqual(),
-                const Allocator& alloc        = Allocator())
-      : m_map(first, last, bucket_count, hash, equal, alloc)
-  {
-  }
-
-  template <typename InputIt>
-  unordered_map(InputIt first, InputIt last, size_type bucket_count, const Allocator& alloc)
-      : m_map(first, last, bucket_count, Hash(), KeyEqual(), alloc)
-  {
-  }
-
-  template <typename InputIt>
-  unordered_map(
-      InputIt first, InputIt last, size_type bucket_count, const Hash& hash, const Allocator& alloc)
-      : m_map(first, last, bucket_count, hash, KeyEqual(), alloc)
-  {
-  }
-
-  unordered_map(const unordered_map& other) : m_map(other.m_map) {}
-
-  unordered_map(const unordered_map& other, const Allocator& alloc) : m_map(other.m_map, alloc) {}
+// map的元素是键值对，键取自first
+template <typename Key, typename T>
+struct unordered_map_policy {
+  using key_type   = Key;
+  using value_type = std::pair<const Key, T>;
 
-  unordered_map(unordered_map&& other) noexcept : m_map(std::move(other.m_map)) {}
+  // 可以通过迭代器修改值（键本身是const）
+  static constexpr bool constant_values = false;
 
-  unordered_map(unordered_map&& other, const Allocator& alloc)
-      : m_map(std::move(other.m_map), alloc)
-  {
-  }
+  static const key_type& key(const value_type& value) noexcept { return value.first; }
 
-  unordered_map(std::initializer_list<value_type> init,
-                size_type                         bucket_count = 0,
-                const Hash&                       hash         = Hash(),
-                const KeyEqual&                   equal        = KeyEqual(),
-                const Allocator&                  alloc        = Allocator())
-      : m_map(init, bucket_count, hash, equal, alloc)
+  static bool mapped_equal(const value_type& lhs, const value_type& rhs)
   {
+    return lhs.second == rhs.second;
   }
+};
 
-  unordered_map(std::initializer_list<value_type> init,
-                size_type                         bucket_count,
-                const Allocator&                  alloc)
-      : m_map(init, bucket_count, Hash(), KeyEqual(), alloc)
-  {
-  }
+/**
+ * @brief 基于链式哈希表的映射
+ *
+ * 与unordered_set共用hashtable核心：节点来自内存池，桶下标由BucketPolicy计算，
+ * 键的哈希较昂贵时节点缓存哈希值。插入不会使已有元素的指针和引用失效。
+ */
+template <typename Key,
+          typename T,
+          typename Hash         = std::hash<Key>,
+          typename KeyEqual     = std::equal_to<Key>,
+          typename Allocator    = std::allocator<std::pair<const Key, T>>,
+          typename BucketPolicy = power_of_two_bucket_policy>
+class unordered_map
+    : public hashtable<unordered_map_policy<Key, T>, Hash, KeyEqual, Allocator, BucketPolicy>
+{
+  using base = hashtable<unordered_map_policy<Key, T>, Hash, KeyEqual, Allocator, BucketPolicy>;
 
-  unordered_map(std::initializer_list<value_type> init,
-                size_type                         bucket_count,
-                const Hash&                       hash,
-                const Allocator&                  alloc)
-      : m_map(init, bucket_count, hash, KeyEqual(), alloc)
-  {
-  }
+public:
+  using mapped_type = T;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::key_type;
+  using typename base::value_type;
 
-  // 赋值运算符
-  unordered_map& operator=(const unordered_map& other)
-  {
-    m_map = other.m_map;
-    return *this;
-  }
+  using base::base;
+  using base::insert;
 
-  unordered_map& operator=(unordered_map&& other) noexcept
-  {
-    m_map = std::move(other.m_map);
-    return *this;
-  }
+  unordered_map() = default;
 
   unordered_map& operator=(std::initializer_list<value_type> ilist)
   {
-    m_map = ilist;
+    base::operator=(ilist);
     return *this;
   }
 
-  // 获取分配器
-  allocator_type get_allocator() const noexcept { return m_map.get_allocator(); }
-
   // 元素访问
-  T& at(const Key& key) { return m_map.at(key); }
-
-  const T& at(const Key& key) const { return m_map.at(key); }
-
-  T& operator[](const Key& key) { return m_map[key]; }
-
-  T& operator[](Key&& key) { return m_map[std::move(key)]; }
-
-  // 迭代器
-  iterator begin() noexcept { return m_map.begin(); }
-
-  const_iterator begin() const noexcept { return m_map.begin(); }
-
-  const_iterator cbegin() const noexcept { return m_map.cbegin(); }
-
-  iterator end() noexcept { return m_map.end(); }
-
-  const_iterator end() const noexcept { return m_map.end(); }
-
-  const_iterator cend() const noexcept { return m_map.cend(); }
-
-  // 容量
-  bool empty() const noexcept { return m_map.empty(); }
-
-  size_type size() const noexcept { return m_map.size(); }
-
-  size_type max_size() const noexcept { return m_map.max_size(); }
-
-  // 修改器
-  void clear() noexcept { m_map.clear(); }
-
-  std::pair<iterator, bool> insert(const value_type& value) { return m_map.insert(value); }
-
-  std::pair<iterator, bool> insert(value_type&& value) { return m_map.insert(std::move(value)); }
-
-  template <typename P>
-  std::pair<iterator, bool> insert(P&& value)
+  T& at(const Key& key)
   {
-    return m_map.insert(std::forward<P>(value));
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("unordered_map::at: key not found");
+    }
+    return it->second;
   }
 
-  iterator insert(const_iterator hint, const value_type& value)
+  const T& at(const Key& key) const
   {
-    return m_map.insert(hint, value);
+    auto it = this->find(key);
+    if (it == this->end()) {
+      throw out_of_range("unordered_map::at: key not found");
+    }
+    return it->second;
   }
 
-  iterator insert(const_iterator hint, value_type&& value)
-  {
-    return m_map.insert(hint, std::move(value));
-  }
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
 
-  template <typename P>
-  iterator insert(const_iterator hint, P&& value)
-  {
-    return m_map.insert(hint, std::forward<P>(value));
-  }
+  T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
 
-  template <typename InputIt>
-  void insert(InputIt first, InputIt last)
+  // 可转换为value_type的参数，如 std::pair<Key, T>
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+  std::pair<iterator, bool> insert(P&& value)
   {
-    m_map.insert(first, last);
+    return this->emplace(std::forward<P>(value));
   }
 
-  void insert(std::initializer_list<value_type> ilist) { m_map.insert(ilist); }
-
-  template <typename... Args>
-  std::pair<iterator, bool> emplace(Args&&... args)
+  template <typename P, typename = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+  iterator insert(const_iterator, P&& value)
   {
-    return m_map.emplace(std::forward<Args>(args)...);
+    return this->emplace(std::forward<P>(value)).first;
   }
 
+  // 键不存在时才构造值，键已存在时参数不会被移动
   template <typename... Args>
-  iterator emplace_hint(const_iterator hint, Args&&... args)
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
   {
-    return m_map.emplace_hint(hint, std::forward<Args>(args)...);
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(key),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
-  iterator erase(const_iterator pos) { return m_map.erase(pos); }
-
-  iterator erase(const_iterator first, const_iterator last) { return m_map.erase(first, last); }
-
-  size_type erase(const key_type& key) { return m_map.erase(key); }
-
-  void swap(unordered_map& other) noexcept(std::is_nothrow_swappable_v<Hash>
-                                           && std::is_nothrow_swappable_v<KeyEqual>)
-  {
-    m_map.swap(other.m_map);
-  }
-
-  // 查找
-  size_type count(const Key& key) const { return m_map.count(key); }
-
-  template <typename K>
-  size_type count(const K& x) const
-  {
-    return m_map.count(x);
-  }
-
-  iterator find(const Key& key) { return m_map.find(key); }
-
-  const_iterator find(const Key& key) const { return m_map.find(key); }
-
-  template <typename K>
-  iterator find(const K& x)
-  {
-    return m_map.find(x);
-  }
-
-  template <typename K>
-  const_iterator find(const K& x) const
-  {
-    return m_map.find(x);
-  }
-
-  bool contains(const Key& key) const { return m_map.find(key) != m_map.end(); }
-
-  template <typename K>
-  bool contains(const K& x) const
-  {
-    return m_map.find(x) != m_map.end();
-  }
-
-  std::pair<iterator, iterator> equal_range(const Key& key) { return m_map.equal_range(key); }
-
-  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const
-  {
-    return m_map.equal_range(key);
-  }
-
-  template <typename K>
-  std::pair<iterator, iterator> equal_range(const K& x)
-  {
-    return m_map.equal_range(x);
-  }
-
-  template <typename K>
-  std::pair<const_iterator, const_iterator> equal_range(const K& x) const
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
   {
-    return m_map.equal_range(x);
+    return this->insert_unique(key,
+                               std::piecewise_construct,
+                               std::forward_as_tuple(std::move(key)),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
-  // 桶接口
-  size_type bucket_count() const noexcept { return m_map.bucket_count(); }
-
-  size_type max_bucket_count() const noexcept { return m_map.max_bucket_count(); }
-
-  size_type bucket_size(size_type n) const { return m_map.bucket_size(n); }
-
-  size_type bucket(const Key& key) const { return m_map.bucket(key); }
-
-  local_iterator begin(size_type n) { return m_map.begin(n); }
-
-  const_local_iterator begin(size_type n) const { return m_map.begin(n); }
-
-  const_local_iterator cbegin(size_type n) const { return m_map.cbegin(n); }
-
-  local_iterator end(size_type n) { return m_map.end(n); }
-
-  const_local_iterator end(size_type n) const { return m_map.end(n); }
-
-  const_local_iterator cend(size_type n) const { return m_map.cend(n); }
-
-  // 哈希策略
-  float load_factor() const noexcept { return m_map.load_factor(); }
-
-  float max_load_factor() const noexcept { return m_map.max_load_factor(); }
-
-  void max_load_factor(float ml) { m_map.max_load_factor(ml); }
-
-  void rehash(size_type count) { m_map.rehash(count); }
-
-  void reserve(size_type count) { m_map.reserve(count); }
-
-  // 观察器
-  hasher hash_function() const { return m_map.hash_function(); }
-
-  key_equal key_eq() const { return m_map.key_eq(); }
-
-  // 比较运算符
-  friend bool operator==(const unordered_map& lhs, const unordered_map& rhs)
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
   {
-    return lhs.m_map == rhs.m_map;
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
   }
 
-  friend bool operator!=(const unordered_map& lhs, const unordered_map& rhs)
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
   {
-    return lhs.m_map != rhs.m_map;
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
   }
 };
 
-// 特化的swap函数
-template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
-void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
-          unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+// 非成员函数
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc, typename BucketPolicy>
+void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
 
+// 节点都在内存池的slab中，容器本身只保存指针、函数对象和分配器，可以按字节搬迁
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc, typename BucketPolicy>
+struct is_trivially_relocatable<unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<Hash>::value
+                                 && is_trivially_relocatable<KeyEqual>::value
+                                 && is_trivially_relocatable<Alloc>::value
+                                 && is_trivially_relocatable<BucketPolicy>::value> {
+};
+
 }  // namespace sjkxq_stl
 
-#endif  // SJKXQ_STL_UNORDERED_MAP_HPP
\ No newline at end of file
+#endif  // SJKXQ_STL_UNORDERED_MAP_HPP
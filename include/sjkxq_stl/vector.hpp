@@ -2,16 +2,83 @@
 #define SJKXQ_STL_VECTOR_HPP
 
 #include "common.hpp"
+#include "execution.hpp"
+#include "growth_policy.hpp"
+#include "memory_compare.hpp"
 #include <algorithm>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <iterator> // 为移动迭代器支持
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 namespace sjkxq_stl
 {
 
-template <typename T, typename Allocator = std::allocator<T>>
-class vector
+// 分配器能否原地扩大已分配的块：提供bool expand(pointer p, size_type old_n, size_type new_n)，
+// 成功时p处的块可以容纳new_n个元素，失败时块保持不变（见mmap_allocator.hpp）
+template <typename Alloc, typename = void>
+struct allocator_has_expand : std::false_type
+{
+};
+
+template <typename Alloc>
+struct allocator_has_expand<
+    Alloc, std::void_t<decltype(std::declval<Alloc&>().expand(std::declval<typename std::allocator_traits<Alloc>::pointer>(),
+                                                              size_type(), size_type()))>>
+    : std::bool_constant<std::is_same<decltype(std::declval<Alloc&>().expand(
+                                          std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_type(),
+                                          size_type())),
+                                      bool>::value>
+{
+};
+
+// 分配器能否调整已分配块的大小：提供pointer reallocate(pointer p, size_type old_n, size_type new_n)，
+// 成功时返回的新块保留原有的字节（块可能被移动），失败时返回空指针且原有的块保持不变
+// （见malloc_allocator.hpp、mmap_allocator.hpp）
+template <typename Alloc, typename = void>
+struct allocator_has_reallocate : std::false_type
+{
+};
+
+template <typename Alloc>
+struct allocator_has_reallocate<
+    Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+               std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_type(), size_type()))>>
+    : std::bool_constant<std::is_same<decltype(std::declval<Alloc&>().reallocate(
+                                          std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_type(),
+                                          size_type())),
+                                      typename std::allocator_traits<Alloc>::pointer>::value>
+{
+};
+
+// vector的内联缓冲区。容量为0时是空类，借助空基类优化不占用任何空间
+template <typename T, size_type N>
+struct vector_inline_storage
+{
+  alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+
+  T* inline_data() noexcept { return reinterpret_cast<T*>(inline_buffer_); }
+
+  const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_buffer_); }
+};
+
+template <typename T>
+struct vector_inline_storage<T, 0>
+{
+  T* inline_data() noexcept { return nullptr; }
+
+  const T* inline_data() const noexcept { return nullptr; }
+};
+
+// InlineCapacity大于0时，不超过该数量的元素直接存放在对象内部的缓冲区中，超出后才转到堆上，
+// 见small_vector.hpp。内联缓冲区只在数据需要搬迁时使用，增长和搬迁逻辑与普通vector完全相同。
+// GrowthPolicy决定插入时容量不足的扩容幅度，见growth_policy.hpp
+template <typename T, typename Allocator = std::allocator<T>, size_type InlineCapacity = 0,
+          typename GrowthPolicy = default_growth>
+class vector : private vector_inline_storage<T, InlineCapacity>
 {
 public:
   // 类型定义
@@ -27,6 +94,7 @@ public:
   using const_iterator         = const_pointer;
   using reverse_iterator       = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using growth_policy          = GrowthPolicy;
 
 private:
   pointer        data_;      // 指向数据的指针
@@ -34,61 +102,384 @@ private:
   size_type      capacity_;  // 当前容量
   allocator_type alloc_;     // 分配器
 
-  // 重新分配内存
-  void reallocate(size_type new_capacity)
+  // 元素能否按字节整体搬迁：搬迁后的源对象无需再析构，可以用memcpy/memmove代替逐个移动构造加析构
+  static constexpr bool relocate_by_memcpy = is_trivially_relocatable<T>::value;
+
+  // 移动构造、移动赋值和交换是否不抛异常：内联缓冲区中的元素只能逐个移动
+  static constexpr bool nothrow_steal = InlineCapacity == 0 || std::is_nothrow_move_constructible<T>::value;
+
+  static_assert(InlineCapacity == 0 || std::is_same<pointer, T*>::value,
+                "vector: inline storage requires an allocator with raw pointers");
+
+  // 数据是否存放在内联缓冲区中
+  bool is_inline() const noexcept
   {
-    if (new_capacity > max_size()) {
-      throw std::length_error("vector::reallocate: capacity exceeds maximum size");
+    if constexpr (InlineCapacity > 0) {
+      return data_ == this->inline_data();
+    } else {
+      return false;
+    }
+  }
+
+  // 分配能容纳n个元素的存储，内联缓冲区放得下时直接使用它
+  pointer allocate_storage(size_type n)
+  {
+    if constexpr (InlineCapacity > 0) {
+      if (n <= InlineCapacity) {
+        return this->inline_data();
+      }
+    }
+    return alloc_.allocate(n);
+  }
+
+  // 释放allocate_storage得到的存储，内联缓冲区和空指针无需释放
+  void deallocate_storage(pointer p, size_type n) noexcept
+  {
+    if (p && p != this->inline_data()) {
+      alloc_.deallocate(p, n);
+    }
+  }
+
+  // 范围中的元素是否与T相同、连续存放且可平凡复制（提供data()和size()），可以整体memcpy
+  template <typename Range, typename = void>
+  struct is_memcpy_range : std::false_type
+  {
+  };
+
+  template <typename Range>
+  struct is_memcpy_range<Range, std::void_t<decltype(std::data(std::declval<Range&>())),
+                                            decltype(std::size(std::declval<Range&>()))>>
+      : std::bool_constant<std::is_trivially_copyable<T>::value
+                           && std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(
+                                               std::declval<Range&>()))>>,
+                                           T>::value>
+  {
+  };
+
+  // 迭代器能否多遍遍历，从而可以先求出元素个数（同时识别std和sjkxq_stl的迭代器标签）
+  template <typename It>
+  static constexpr bool is_multipass_iterator =
+      std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value
+      || std::is_base_of<forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value;
+
+  // 范围是否提供size()，可以不遍历就得到元素个数
+  template <typename Range, typename = void>
+  struct is_sized_range : std::false_type
+  {
+  };
+
+  template <typename Range>
+  struct is_sized_range<Range, std::void_t<decltype(std::size(std::declval<Range&>()))>> : std::true_type
+  {
+  };
+
+  // 多遍范围的元素个数：优先用size()；std迭代器交给std::distance，随机访问迭代器为O(1)；
+  // sjkxq_stl的迭代器标签不被std::distance识别，逐个计数
+  template <typename Range, typename It>
+  static size_type range_size(Range& r, It first, It last)
+  {
+    if constexpr (is_sized_range<Range>::value) {
+      return static_cast<size_type>(std::size(r));
+    } else if constexpr (std::is_base_of<std::input_iterator_tag,
+                                         typename std::iterator_traits<It>::iterator_category>::value) {
+      return static_cast<size_type>(std::distance(first, last));
+    } else {
+      size_type n = 0;
+      for (; first != last; ++first) {
+        ++n;
+      }
+      return n;
+    }
+  }
+
+  // 在末尾追加n个由fill(dest)构造的元素，容量不足时按增长策略只扩容一次。
+  // 扩容时先在新内存中构造新元素再释放旧内存，因此fill可以引用容器自身的元素
+  template <typename FillGap>
+  void append_n(size_type n, FillGap fill)
+  {
+    if (n > max_size() - size_) {
+      throw std::length_error("vector::append: size exceeds maximum size");
+    }
+    if (n > capacity_ - size_) {
+      reallocate_with_gap(calculate_growth(size_ + n), size_, n, fill);
+    } else {
+      fill(data_ + size_);
+    }
+    size_ += n;
+  }
+
+  // 恢复到刚构造时的空状态，调用前元素和存储都应已处理完毕
+  void reset_storage() noexcept
+  {
+    data_     = this->inline_data();
+    size_     = 0;
+    capacity_ = InlineCapacity;
+  }
+
+  // 容器为空时保证容量至少为count：直接换一块新内存，不搬迁任何元素
+  void reserve_empty(size_type count)
+  {
+    if (count > capacity_) {
+      pointer new_data = alloc_.allocate(count);
+      deallocate_storage(data_, capacity_);
+      data_     = new_data;
+      capacity_ = count;
     }
+  }
 
-    pointer new_data = alloc_.allocate(new_capacity);
+  // 接管other的全部元素，调用前本对象应为空。堆内存直接转移指针；
+  // 内联缓冲区中的元素只能逐个搬迁到本对象的内联缓冲区，失败时other保持不变
+  void steal(vector& other) noexcept(nothrow_steal)
+  {
+    if (other.is_inline()) {
+      if constexpr (relocate_by_memcpy) {
+        if (other.size_ > 0) {
+          std::memcpy(static_cast<void*>(data_), static_cast<const void*>(other.data_), other.size_ * sizeof(T));
+        }
+      } else {
+        construct_copy(data_, std::make_move_iterator(other.data_), std::make_move_iterator(other.data_ + other.size_));
+        other.destroy_range(other.data_, other.data_ + other.size_);
+      }
+      size_       = other.size_;
+      other.size_ = 0;
+    } else {
+      data_     = other.data_;
+      size_     = other.size_;
+      capacity_ = other.capacity_;
+      other.reset_storage();
+    }
+  }
+
+  // 销毁[first, last)中的元素，平凡析构的类型直接跳过
+  void destroy_range(pointer first, pointer last) noexcept
+  {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (; first != last; ++first) {
+        std::allocator_traits<allocator_type>::destroy(alloc_, first);
+      }
+    }
+  }
+
+  // 在未初始化内存p处构造count个value的副本，失败时销毁已构造的部分
+  void construct_fill(pointer p, size_type count, const T& value)
+  {
+    size_type i = 0;
+    try {
+      for (; i < count; ++i) {
+        std::allocator_traits<allocator_type>::construct(alloc_, p + i, value);
+      }
+    } catch (...) {
+      destroy_range(p, p + i);
+      throw;
+    }
+  }
+
+  // 在未初始化内存p处默认初始化count个元素：可平凡默认构造的类型不写入任何内容，
+  // 其他类型通过分配器逐个构造，失败时销毁已构造的部分
+  void construct_default(pointer p, size_type count)
+  {
+    if constexpr (!std::is_trivially_default_constructible<T>::value) {
+      size_type i = 0;
+      try {
+        for (; i < count; ++i) {
+          std::allocator_traits<allocator_type>::construct(alloc_, p + i);
+        }
+      } catch (...) {
+        destroy_range(p, p + i);
+        throw;
+      }
+    }
+  }
 
-    // 移动现有元素到新内存，使用异常安全的方式
+  // 在未初始化内存p处值初始化count个元素，失败时销毁已构造的部分
+  void construct_value(pointer p, size_type count)
+  {
     size_type i = 0;
     try {
-      for (; i < size_; ++i) {
-        std::allocator_traits<allocator_type>::construct(alloc_, new_data + i, std::move_if_noexcept(data_[i]));
+      for (; i < count; ++i) {
+        std::allocator_traits<allocator_type>::construct(alloc_, p + i);
       }
     } catch (...) {
-      // 如果构造过程中发生异常，清理已构造的元素
-      for (size_type j = 0; j < i; ++j) {
-        std::allocator_traits<allocator_type>::destroy(alloc_, new_data + j);
+      destroy_range(p, p + i);
+      throw;
+    }
+  }
+
+  // 按策略把未初始化内存[p, p + count)分块并行构造，construct(dest, offset, n)在dest处构造第offset起的n个元素，
+  // 失败时自行清理本块。任何一块失败都会销毁其余已构造的块并重新抛出异常
+  template <typename Construct>
+  void parallel_construct(const parallel_policy& policy, pointer p, size_type count, Construct construct)
+  {
+    parallel_for_chunks(
+        policy, count, sizeof(T), [&](size_type first, size_type last) { construct(p + first, first, last - first); },
+        [&](size_type first, size_type last) { destroy_range(p + first, p + last); });
+  }
+
+  // 在未初始化内存p处依次构造[first, last)中元素的副本，失败时销毁已构造的部分
+  template <typename ForwardIt>
+  void construct_copy(pointer p, ForwardIt first, ForwardIt last)
+  {
+    pointer cur = p;
+    try {
+      for (; first != last; ++first, ++cur) {
+        std::allocator_traits<allocator_type>::construct(alloc_, cur, *first);
       }
-      alloc_.deallocate(new_data, new_capacity);
-      throw;  // 重新抛出异常
+    } catch (...) {
+      destroy_range(p, cur);
+      throw;
     }
+  }
 
-    // 注意：移动后的对象仍然需要被销毁，但它们现在处于有效但未指定的状态
-    for (size_type j = 0; j < size_; ++j) {
-      std::allocator_traits<allocator_type>::destroy(alloc_, data_ + j);
+  // 将[pos, pos + tail)整体后移count个位置，使[pos, pos + count)成为未初始化的空位
+  void open_gap(size_type pos, size_type count, size_type tail)
+  {
+    if constexpr (relocate_by_memcpy) {
+      if (tail > 0) {
+        std::memmove(static_cast<void*>(data_ + pos + count),
+                     static_cast<const void*>(data_ + pos),
+                     tail * sizeof(T));
+      }
+    } else {
+      // 从后向前搬迁，目标位置要么在原末尾之后，要么已在前面的步骤中被搬空
+      for (size_type i = tail; i > 0; --i) {
+        std::allocator_traits<allocator_type>::construct(
+            alloc_, data_ + pos + count + i - 1, std::move_if_noexcept(data_[pos + i - 1]));
+        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + pos + i - 1);
+      }
     }
+  }
 
-    // 释放旧内存
-    if (data_) {
-      alloc_.deallocate(data_, capacity_);
+  // open_gap的逆操作：将[pos + count, pos + count + tail)前移count个位置，填补未初始化的空位
+  void close_gap(size_type pos, size_type count, size_type tail)
+  {
+    if constexpr (relocate_by_memcpy) {
+      if (tail > 0) {
+        std::memmove(static_cast<void*>(data_ + pos),
+                     static_cast<const void*>(data_ + pos + count),
+                     tail * sizeof(T));
+      }
+    } else {
+      for (size_type i = 0; i < tail; ++i) {
+        std::allocator_traits<allocator_type>::construct(
+            alloc_, data_ + pos + i, std::move_if_noexcept(data_[pos + count + i]));
+        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + pos + count + i);
+      }
+    }
+  }
+
+  // 分配容量为new_capacity的新内存，先由fill_gap在[index, index + count)处构造新元素，
+  // 再把原有元素搬迁到空位两侧。fill_gap必须自行保证失败时不留下已构造的元素。
+  // 可按字节搬迁的类型只需两次memcpy且无需析构旧元素；其他类型先全部移动构造成功后再统一销毁旧元素，
+  // 因此任何一步抛出异常时原有内容都保持不变
+  template <typename FillGap>
+  void reallocate_with_gap(size_type new_capacity, size_type index, size_type count, FillGap fill_gap)
+  {
+    if (new_capacity > max_size()) {
+      throw std::length_error("vector::reallocate: capacity exceeds maximum size");
+    }
+    // 内联缓冲区的容量是固定的，收缩到它以内时直接搬回缓冲区
+    new_capacity = std::max(new_capacity, InlineCapacity);
+
+    // 新元素都追加在末尾且分配器能原地扩大原有的块时，不需要搬迁任何元素。
+    // 插入到中间时仍走下面的路径：新元素的参数可能引用容器内即将被移动的元素
+    if constexpr (allocator_has_expand<allocator_type>::value) {
+      if (index == size_ && new_capacity > capacity_ && data_ && !is_inline()
+          && alloc_.expand(data_, capacity_, new_capacity)) {
+        capacity_ = new_capacity;
+        fill_gap(data_ + index);
+        return;
+      }
+    }
+
+    // 单纯扩容且元素可以按字节搬迁时，让分配器调整块的大小（realloc/mremap），
+    // 块能原地扩大时完全不触及数据，否则由分配器一次性搬走整个块
+    if constexpr (relocate_by_memcpy && allocator_has_reallocate<allocator_type>::value) {
+      if (count == 0 && index == size_ && new_capacity > capacity_ && data_ && !is_inline()) {
+        if (pointer p = alloc_.reallocate(data_, capacity_, new_capacity)) {
+          data_     = p;
+          capacity_ = new_capacity;
+          return;
+        }
+      }
+    }
+
+    pointer new_data = allocate_storage(new_capacity);
+
+    try {
+      fill_gap(new_data + index);
+    } catch (...) {
+      deallocate_storage(new_data, new_capacity);
+      throw;
+    }
+
+    if constexpr (relocate_by_memcpy) {
+      if (index > 0) {
+        std::memcpy(static_cast<void*>(new_data),
+                    static_cast<const void*>(data_),
+                    index * sizeof(T));
+      }
+      if (size_ > index) {
+        std::memcpy(static_cast<void*>(new_data + index + count),
+                    static_cast<const void*>(data_ + index),
+                    (size_ - index) * sizeof(T));
+      }
+    } else {
+      size_type i = 0;
+      try {
+        for (; i < index; ++i) {
+          std::allocator_traits<allocator_type>::construct(alloc_, new_data + i, std::move_if_noexcept(data_[i]));
+        }
+        for (; i < size_; ++i) {
+          std::allocator_traits<allocator_type>::construct(
+              alloc_, new_data + i + count, std::move_if_noexcept(data_[i]));
+        }
+      } catch (...) {
+        // 清理已构造的元素（包括fill_gap构造的新元素）
+        destroy_range(new_data, new_data + std::min(i, index));
+        destroy_range(new_data + index, new_data + index + count);
+        if (i > index) {
+          destroy_range(new_data + index + count, new_data + i + count);
+        }
+        deallocate_storage(new_data, new_capacity);
+        throw;
+      }
+
+      // 移动后的对象仍然需要被销毁，但它们现在处于有效但未指定的状态
+      destroy_range(data_, data_ + size_);
     }
 
+    // 释放旧内存
+    deallocate_storage(data_, capacity_);
+
     // 更新指针和容量
     data_     = new_data;
     capacity_ = new_capacity;
   }
 
+  // 重新分配内存
+  void reallocate(size_type new_capacity)
+  {
+    reallocate_with_gap(new_capacity, size_, 0, [](pointer) {});
+  }
+
 public:
   // 构造函数
-  vector() noexcept(noexcept(Allocator())) : data_(nullptr), size_(0), capacity_(0), alloc_() {}
+  vector() noexcept(noexcept(Allocator()))
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_()
+  {
+  }
 
   explicit vector(const Allocator& alloc) noexcept
-      : data_(nullptr), size_(0), capacity_(0), alloc_(alloc)
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_(alloc)
   {
   }
 
   vector(size_type count, const T& value, const Allocator& alloc = Allocator())
-      : data_(nullptr), size_(0), capacity_(0), alloc_(alloc)
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_(alloc)
   {
     if (count > 0) {
-      data_     = alloc_.allocate(count);
-      capacity_ = count;
-      size_     = count;
+      reserve_empty(count);
+      size_ = count;
 
       for (size_type i = 0; i < count; ++i) {
         std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, value);
@@ -97,12 +488,11 @@ public:
   }
 
   explicit vector(size_type count, const Allocator& alloc = Allocator())
-      : data_(nullptr), size_(0), capacity_(0), alloc_(alloc)
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_(alloc)
   {
     if (count > 0) {
-      data_     = alloc_.allocate(count);
-      capacity_ = count;
-      size_     = count;
+      reserve_empty(count);
+      size_ = count;
 
       for (size_type i = 0; i < count; ++i) {
         std::allocator_traits<allocator_type>::construct(alloc_, data_ + i);
@@ -110,13 +500,65 @@ public:
     }
   }
 
+  // 并行构造：元素很多时分块交给多个线程构造（见parallel_policy），否则与对应的顺序版本相同。
+  // 分配器的construct和destroy必须能被多个线程同时调用
+  vector(const parallel_policy& policy, size_type count, const T& value, const Allocator& alloc = Allocator())
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_(alloc)
+  {
+    if (count > 0) {
+      reserve_empty(count);
+      try {
+        parallel_construct(policy, data_, count,
+                           [&](pointer dest, size_type, size_type n) { construct_fill(dest, n, value); });
+      } catch (...) {
+        deallocate_storage(data_, capacity_);
+        throw;
+      }
+      size_ = count;
+    }
+  }
+
+  vector(const parallel_policy& policy, size_type count, const Allocator& alloc = Allocator())
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_(alloc)
+  {
+    if (count > 0) {
+      reserve_empty(count);
+      try {
+        parallel_construct(policy, data_, count,
+                           [&](pointer dest, size_type, size_type n) { construct_value(dest, n); });
+      } catch (...) {
+        deallocate_storage(data_, capacity_);
+        throw;
+      }
+      size_ = count;
+    }
+  }
+
+  vector(const parallel_policy& policy, const vector& other)
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity),
+        alloc_(std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+            other.alloc_))
+  {
+    if (other.size_ > 0) {
+      reserve_empty(other.size_);
+      try {
+        parallel_construct(policy, data_, other.size_, [&](pointer dest, size_type offset, size_type n) {
+          construct_copy(dest, other.data_ + offset, other.data_ + offset + n);
+        });
+      } catch (...) {
+        deallocate_storage(data_, capacity_);
+        throw;
+      }
+      size_ = other.size_;
+    }
+  }
+
   vector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
-      : data_(nullptr), size_(0), capacity_(0), alloc_(alloc)
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_(alloc)
   {
     if (init.size() > 0) {
-      data_     = alloc_.allocate(init.size());
-      capacity_ = init.size();
-      size_     = init.size();
+      reserve_empty(init.size());
+      size_ = init.size();
 
       size_type i = 0;
       for (const auto& item : init) {
@@ -129,15 +571,14 @@ public:
   // 从迭代器范围构造，支持移动迭代器
   template<typename InputIt, typename = typename std::enable_if_t<!std::is_integral_v<InputIt>>>
   vector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
-      : data_(nullptr), size_(0), capacity_(0), alloc_(alloc)
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity), alloc_(alloc)
   {
     // 对于随机访问迭代器，我们可以预先知道大小
     if constexpr (std::is_same_v<typename std::iterator_traits<InputIt>::iterator_category,
                                 std::random_access_iterator_tag>) {
       auto count = std::distance(first, last);
       if (count > 0) {
-        data_ = alloc_.allocate(count);
-        capacity_ = count;
+        reserve_empty(count);
         size_ = count;
 
         size_type i = 0;
@@ -150,7 +591,7 @@ public:
           for (size_type j = 0; j < i; ++j) {
             std::allocator_traits<allocator_type>::destroy(alloc_, data_ + j);
           }
-          alloc_.deallocate(data_, capacity_);
+          deallocate_storage(data_, capacity_);
           throw;
         }
       }
@@ -164,14 +605,13 @@ public:
 
   // 复制构造函数
   vector(const vector& other)
-      : data_(nullptr), size_(0), capacity_(0),
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity),
         alloc_(std::allocator_traits<allocator_type>::select_on_container_copy_construction(
             other.alloc_))
   {
     if (other.size_ > 0) {
-      data_     = alloc_.allocate(other.size_);
-      capacity_ = other.size_;
-      size_     = other.size_;
+      reserve_empty(other.size_);
+      size_ = other.size_;
 
       for (size_type i = 0; i < size_; ++i) {
         std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, other.data_[i]);
@@ -180,13 +620,11 @@ public:
   }
 
   // 移动构造函数
-  vector(vector&& other) noexcept
-      : data_(other.data_), size_(other.size_), capacity_(other.capacity_),
+  vector(vector&& other) noexcept(nothrow_steal)
+      : data_(this->inline_data()), size_(0), capacity_(InlineCapacity),
         alloc_(std::move(other.alloc_))
   {
-    other.data_     = nullptr;
-    other.size_     = 0;
-    other.capacity_ = 0;
+    steal(other);
   }
 
   // 析构函数
@@ -199,7 +637,7 @@ public:
       }
 
       // 释放内存
-      alloc_.deallocate(data_, capacity_);
+      deallocate_storage(data_, capacity_);
     }
   }
 
@@ -212,61 +650,48 @@ public:
         std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
       }
 
-      if (data_) {
-        alloc_.deallocate(data_, capacity_);
-      }
+      deallocate_storage(data_, capacity_);
+      reset_storage();
 
       // 复制分配器
-      if (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
-        alloc_ = other.alloc_;
-      }
+      copy_assign_allocator(alloc_, other.alloc_);
 
       // 分配新内存
       if (other.size_ > 0) {
-        data_     = alloc_.allocate(other.size_);
-        capacity_ = other.size_;
-        size_     = other.size_;
+        reserve_empty(other.size_);
+        size_ = other.size_;
 
         // 复制元素
         for (size_type i = 0; i < size_; ++i) {
           std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, other.data_[i]);
         }
-      } else {
-        data_     = nullptr;
-        size_     = 0;
-        capacity_ = 0;
       }
     }
     return *this;
   }
 
   // 移动赋值运算符
-  vector& operator=(vector&& other) noexcept
+  // 分配器不传播且与other的不相等时不能接管other的内存，只能逐个移动元素
+  vector& operator=(vector&& other) noexcept(
+      nothrow_steal && (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
+                        || std::allocator_traits<allocator_type>::is_always_equal::value))
   {
-    if (this != &other) {
+    if (this != &other && !allocator_can_steal(alloc_, other.alloc_)) {
+      assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    } else if (this != &other) {
       // 清理当前内容
       for (size_type i = 0; i < size_; ++i) {
         std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
       }
 
-      if (data_) {
-        alloc_.deallocate(data_, capacity_);
-      }
+      deallocate_storage(data_, capacity_);
+      reset_storage();
 
       // 移动分配器
-      if (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
-        alloc_ = std::move(other.alloc_);
-      }
-
-      // 移动数据
-      data_     = other.data_;
-      size_     = other.size_;
-      capacity_ = other.capacity_;
+      move_assign_allocator(alloc_, other.alloc_);
 
-      // 重置other
-      other.data_     = nullptr;
-      other.size_     = 0;
-      other.capacity_ = 0;
+      // 移动数据并重置other
+      steal(other);
     }
     return *this;
   }
@@ -375,7 +800,15 @@ public:
 
   void shrink_to_fit()
   {
-    if (size_ < capacity_) {
+    if (is_inline()) {
+      // 内联缓冲区无法收缩
+      return;
+    }
+    if (size_ == 0 && data_) {
+      // 没有元素时直接归还整块内存
+      deallocate_storage(data_, capacity_);
+      reset_storage();
+    } else if (size_ < capacity_) {
       reallocate(size_);
     }
   }
@@ -393,13 +826,7 @@ public:
   void assign(size_type count, const T& value)
   {
     clear();
-    if (count > capacity_) {
-      if (data_) {
-        alloc_.deallocate(data_, capacity_);
-      }
-      data_ = alloc_.allocate(count);
-      capacity_ = count;
-    }
+    reserve_empty(count);
 
     for (size_type i = 0; i < count; ++i) {
       std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, value);
@@ -407,6 +834,16 @@ public:
     size_ = count;
   }
 
+  // 并行版本，失败时容器为空
+  void assign(const parallel_policy& policy, size_type count, const T& value)
+  {
+    clear();
+    reserve_empty(count);
+    parallel_construct(policy, data_, count,
+                       [&](pointer dest, size_type, size_type n) { construct_fill(dest, n, value); });
+    size_ = count;
+  }
+
   // 用范围[first, last)中的元素替换内容，支持移动迭代器
   template<typename InputIt, typename = typename std::enable_if_t<!std::is_integral_v<InputIt>>>
   void assign(InputIt first, InputIt last)
@@ -418,14 +855,8 @@ public:
                                 std::random_access_iterator_tag>) {
       auto count = std::distance(first, last);
       if (count > 0) {
-        if (static_cast<size_type>(count) > capacity_) {
-          if (data_) {
-            alloc_.deallocate(data_, capacity_);
-          }
-          data_ = alloc_.allocate(count);
-          capacity_ = count;
-        }
-        
+        reserve_empty(count);
+
         size_type i = 0;
         try {
           for (auto it = first; it != last; ++it, ++i) {
@@ -455,25 +886,9 @@ public:
     assign(ilist.begin(), ilist.end());
   }
 
-  void push_back(const T& value)
-  {
-    if (size_ == capacity_) {
-      size_type new_capacity = calculate_growth(size_ + 1);
-      reallocate(new_capacity);
-    }
-    std::allocator_traits<allocator_type>::construct(alloc_, data_ + size_, value);
-    ++size_;
-  }
+  void push_back(const T& value) { emplace_back(value); }
 
-  void push_back(T&& value)
-  {
-    if (size_ == capacity_) {
-      size_type new_capacity = calculate_growth(size_ + 1);
-      reallocate(new_capacity);
-    }
-    std::allocator_traits<allocator_type>::construct(alloc_, data_ + size_, std::forward<T>(value));
-    ++size_;
-  }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
 
   void pop_back()
   {
@@ -484,16 +899,14 @@ public:
     std::allocator_traits<allocator_type>::destroy(alloc_, data_ + size_);
   }
 
-  // emplace_back：在容器末尾就地构造元素
+  // emplace_back：在容器末尾就地构造元素。
+  // 参数可能引用容器内的元素，扩容时先在新内存中构造新元素，再释放旧内存
   template<typename... Args>
   reference emplace_back(Args&&... args)
   {
-    if (size_ == capacity_) {
-      size_type new_capacity = calculate_growth(size_ + 1);
-      reallocate(new_capacity);
-    }
-    std::allocator_traits<allocator_type>::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
-    ++size_;
+    append_n(1, [&](pointer dest) {
+      std::allocator_traits<allocator_type>::construct(alloc_, dest, std::forward<Args>(args)...);
+    });
     return back();
   }
 
@@ -508,52 +921,23 @@ public:
     }
 
     if (size_ == capacity_) {
-      // 需要重新分配内存
-      size_type new_capacity = calculate_growth(size_ + 1);
-      pointer new_data = alloc_.allocate(new_capacity);
-
-      // 移动前半部分元素
-      size_type i = 0;
+      // 需要重新分配内存：先在新内存中构造新元素，再搬迁原有元素
+      reallocate_with_gap(calculate_growth(size_ + 1), index, 1, [&](pointer gap) {
+        std::allocator_traits<allocator_type>::construct(alloc_, gap, std::forward<Args>(args)...);
+      });
+    } else if (index == size_) {
+      // 在末尾构造，无需移动元素
+      std::allocator_traits<allocator_type>::construct(alloc_, data_ + index, std::forward<Args>(args)...);
+    } else {
+      // 参数可能引用容器内的元素，先构造临时对象再腾出空位
+      value_type tmp(std::forward<Args>(args)...);
+      open_gap(index, 1, size_ - index);
       try {
-        for (; i < index; ++i) {
-          std::allocator_traits<allocator_type>::construct(alloc_, new_data + i, std::move_if_noexcept(data_[i]));
-        }
-        // 在指定位置构造新元素
-        std::allocator_traits<allocator_type>::construct(alloc_, new_data + index, std::forward<Args>(args)...);
-        // 移动后半部分元素
-        for (; i < size_; ++i) {
-          std::allocator_traits<allocator_type>::construct(alloc_, new_data + i + 1, std::move_if_noexcept(data_[i]));
-        }
+        std::allocator_traits<allocator_type>::construct(alloc_, data_ + index, std::move(tmp));
       } catch (...) {
-        // 清理已构造的元素
-        for (size_type j = 0; j <= i; ++j) {
-          std::allocator_traits<allocator_type>::destroy(alloc_, new_data + j);
-        }
-        alloc_.deallocate(new_data, new_capacity);
+        close_gap(index, 1, size_ - index);
         throw;
       }
-
-      // 清理旧数据
-      for (size_type j = 0; j < size_; ++j) {
-        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + j);
-      }
-      if (data_) {
-        alloc_.deallocate(data_, capacity_);
-      }
-
-      data_ = new_data;
-      capacity_ = new_capacity;
-    } else {
-      // 有足够空间，不需要重新分配
-      if (index < size_) {
-        // 移动后面的元素，为新元素腾出空间
-        for (size_type i = size_; i > index; --i) {
-          std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, std::move_if_noexcept(data_[i - 1]));
-          std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i - 1);
-        }
-      }
-      // 在指定位置构造新元素
-      std::allocator_traits<allocator_type>::construct(alloc_, data_ + index, std::forward<Args>(args)...);
     }
     ++size_;
     return begin() + index;
@@ -586,58 +970,19 @@ public:
 
     // 检查是否需要重新分配内存
     if (size_ + count > capacity_) {
-      size_type new_capacity = calculate_growth(size_ + count);
-      pointer new_data = alloc_.allocate(new_capacity);
-
-      // 移动前半部分元素
-      size_type i = 0;
+      reallocate_with_gap(calculate_growth(size_ + count), index, count, [&](pointer gap) {
+        construct_fill(gap, count, value);
+      });
+    } else {
+      // value可能引用容器内即将被移动的元素，先复制一份
+      value_type tmp(value);
+      open_gap(index, count, size_ - index);
       try {
-        for (; i < index; ++i) {
-          std::allocator_traits<allocator_type>::construct(alloc_, new_data + i, std::move_if_noexcept(data_[i]));
-        }
-        // 在指定位置构造新元素
-        for (size_type j = 0; j < count; ++j) {
-          std::allocator_traits<allocator_type>::construct(alloc_, new_data + index + j, value);
-        }
-        // 移动后半部分元素
-        for (; i < size_; ++i) {
-          std::allocator_traits<allocator_type>::construct(alloc_, new_data + i + count, std::move_if_noexcept(data_[i]));
-        }
+        construct_fill(data_ + index, count, tmp);
       } catch (...) {
-        // 清理已构造的元素
-        for (size_type j = 0; j < i + count; ++j) {
-          std::allocator_traits<allocator_type>::destroy(alloc_, new_data + j);
-        }
-        alloc_.deallocate(new_data, new_capacity);
+        close_gap(index, count, size_ - index);
         throw;
       }
-
-      // 清理旧数据
-      for (size_type j = 0; j < size_; ++j) {
-        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + j);
-      }
-      if (data_) {
-        alloc_.deallocate(data_, capacity_);
-      }
-
-      data_ = new_data;
-      capacity_ = new_capacity;
-    } else {
-      // 有足够空间，不需要重新分配
-      // 从后向前移动元素，为新元素腾出空间
-      for (size_type i = size_ + count - 1; i >= index + count; --i) {
-        std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, std::move_if_noexcept(data_[i - count]));
-      }
-
-      // 销毁将被覆盖的元素
-      for (size_type i = size_ - 1; i >= index && i < size_; --i) {
-        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
-      }
-
-      // 在指定位置构造新元素
-      for (size_type i = 0; i < count; ++i) {
-        std::allocator_traits<allocator_type>::construct(alloc_, data_ + index + i, value);
-      }
     }
 
     size_ += count;
@@ -664,60 +1009,18 @@ public:
 
       // 检查是否需要重新分配内存
       if (size_ + count > capacity_) {
-        size_type new_capacity = calculate_growth(size_ + count);
-        pointer new_data = alloc_.allocate(new_capacity);
-
-        // 移动前半部分元素
-        size_type i = 0;
+        reallocate_with_gap(calculate_growth(size_ + count), index, count, [&](pointer gap) {
+          construct_copy(gap, first, last);
+        });
+      } else {
+        // 有足够空间，不需要重新分配
+        open_gap(index, count, size_ - index);
         try {
-          for (; i < index; ++i) {
-            std::allocator_traits<allocator_type>::construct(alloc_, new_data + i, std::move_if_noexcept(data_[i]));
-          }
-          // 在指定位置构造新元素
-          size_type j = 0;
-          for (auto it = first; it != last; ++it, ++j) {
-            std::allocator_traits<allocator_type>::construct(alloc_, new_data + index + j, *it);
-          }
-          // 移动后半部分元素
-          for (; i < size_; ++i) {
-            std::allocator_traits<allocator_type>::construct(alloc_, new_data + i + count, std::move_if_noexcept(data_[i]));
-          }
+          construct_copy(data_ + index, first, last);
         } catch (...) {
-          // 清理已构造的元素
-          for (size_type j = 0; j < i + count; ++j) {
-            std::allocator_traits<allocator_type>::destroy(alloc_, new_data + j);
-          }
-          alloc_.deallocate(new_data, new_capacity);
+          close_gap(index, count, size_ - index);
           throw;
         }
-
-        // 清理旧数据
-        for (size_type j = 0; j < size_; ++j) {
-          std::allocator_traits<allocator_type>::destroy(alloc_, data_ + j);
-        }
-        if (data_) {
-          alloc_.deallocate(data_, capacity_);
-        }
-
-        data_ = new_data;
-        capacity_ = new_capacity;
-      } else {
-        // 有足够空间，不需要重新分配
-        // 从后向前移动元素，为新元素腾出空间
-        for (size_type i = size_ + count - 1; i >= index + count; --i) {
-          std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, std::move_if_noexcept(data_[i - count]));
-        }
-
-        // 销毁将被覆盖的元素
-        for (size_type i = size_ - 1; i >= index && i < size_; --i) {
-          std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
-        }
-
-        // 在指定位置构造新元素
-        size_type j = 0;
-        for (auto it = first; it != last; ++it, ++j) {
-          std::allocator_traits<allocator_type>::construct(alloc_, data_ + index + j, *it);
-        }
       }
 
       size_ += count;
@@ -756,10 +1059,7 @@ public:
       }
       size_ = count;
     } else if (count < size_) {
-      // 从后向前销毁元素，这样可以保证在部分销毁时的一致性
-      for (size_type i = size_ - 1; i >= count; --i) {
-        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
-      }
+      destroy_range(data_ + count, data_ + size_);
       size_ = count;
     }
   }
@@ -784,68 +1084,162 @@ public:
       }
       size_ = count;
     } else if (count < size_) {
-      // 从后向前销毁元素，这样可以保证在部分销毁时的一致性
-      for (size_type i = size_ - 1; i >= count; --i) {
-        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
+      destroy_range(data_ + count, data_ + size_);
+      size_ = count;
+    }
+  }
+
+  // 并行版本：新增的元素分块并行构造，失败时容器保持不变（容量可能已增大）
+  void resize(const parallel_policy& policy, size_type count)
+  {
+    if (count > size_) {
+      reserve(count);
+      parallel_construct(policy, data_ + size_, count - size_,
+                         [&](pointer dest, size_type, size_type n) { construct_value(dest, n); });
+      size_ = count;
+    } else if (count < size_) {
+      destroy_range(data_ + count, data_ + size_);
+      size_ = count;
+    }
+  }
+
+  void resize(const parallel_policy& policy, size_type count, const value_type& value)
+  {
+    if (count > size_) {
+      reserve(count);
+      parallel_construct(policy, data_ + size_, count - size_,
+                         [&](pointer dest, size_type, size_type n) { construct_fill(dest, n, value); });
+      size_ = count;
+    } else if (count < size_) {
+      destroy_range(data_ + count, data_ + size_);
+      size_ = count;
+    }
+  }
+
+  // 在末尾追加范围r中的全部元素，r可以是本容器自身。
+  // 能预先求出元素个数的范围（前向迭代器）只扩容一次，有size()或随机访问迭代器时不必为计数多遍历一次；元素与T相同、连续存放且可平凡复制时整体memcpy；
+  // 单遍的输入范围逐个追加
+  template <typename Range>
+  void append_range(Range&& r)
+  {
+    if constexpr (is_memcpy_range<Range>::value) {
+      const size_type n = static_cast<size_type>(std::size(r));
+      append_n(n, [&](pointer dest) {
+        if (n > 0) {
+          std::memcpy(static_cast<void*>(dest), static_cast<const void*>(std::data(r)), n * sizeof(T));
+        }
+      });
+    } else {
+      auto first = std::begin(r);
+      auto last  = std::end(r);
+      if constexpr (is_multipass_iterator<decltype(first)>) {
+        const size_type n = range_size(r, first, last);
+        append_n(n, [&](pointer dest) { construct_copy(dest, first, last); });
+      } else {
+        for (; first != last; ++first) {
+          emplace_back(*first);
+        }
       }
+    }
+  }
+
+  // 在末尾追加n个元素，第i个元素由gen()的第i次调用结果直接构造，只扩容一次
+  template <typename Generator>
+  void append(size_type n, Generator gen)
+  {
+    append_n(n, [&](pointer dest) {
+      size_type i = 0;
+      try {
+        for (; i < n; ++i) {
+          std::allocator_traits<allocator_type>::construct(alloc_, dest + i, gen());
+        }
+      } catch (...) {
+        destroy_range(dest, dest + i);
+        throw;
+      }
+    });
+  }
+
+  // 与resize(count)相同，但新元素只做默认初始化：对int、char等可平凡默认构造的类型不清零，
+  // 适合随后立即被整体覆盖的缓冲区（如读取socket或解码的目标）。新元素在写入前的值是不确定的
+  void resize_default_init(size_type count)
+  {
+    if (count > size_) {
+      reserve(count);
+      construct_default(data_ + size_, count - size_);
+      size_ = count;
+    } else if (count < size_) {
+      destroy_range(data_ + count, data_ + size_);
       size_ = count;
     }
   }
 
+  // 在末尾追加至多n个元素：按增长策略保证容量后默认初始化n个元素，再调用writer(first, n)直接写入，
+  // writer返回实际写入的元素个数m（不超过n），size()随之增加m，其余n - m个元素被丢弃。
+  // writer抛出异常时size()保持不变。返回m
+  template <typename Writer>
+  size_type reserve_and_append(size_type n, Writer writer)
+  {
+    if (n > max_size() - size_) {
+      throw std::length_error("vector::reserve_and_append: size exceeds maximum size");
+    }
+    if (n > capacity_ - size_) {
+      reallocate(calculate_growth(size_ + n));
+    }
+
+    pointer first = data_ + size_;
+    construct_default(first, n);
+    size_type written = 0;
+    try {
+      written = std::min(static_cast<size_type>(writer(first, n)), n);
+    } catch (...) {
+      destroy_range(first, first + n);
+      throw;
+    }
+    destroy_range(first + written, first + n);
+    size_ += written;
+    return written;
+  }
+
 private:
-  // 计算增长后的容量
-  // 使用更高效的增长策略：
-  // 1. 对于小容量，使用更激进的增长因子(2倍)以减少重新分配次数
-  // 2. 对于大容量，使用更保守的增长因子(1.5倍)以减少内存浪费
-  // 3. 确保增长后的容量至少能容纳请求的大小
+  // 计算增长后的容量，具体幅度由增长策略决定
   size_type calculate_growth(size_type new_size) const {
     const size_type ms = max_size();
     if (new_size > ms) {
       throw std::length_error("vector::calculate_growth: size exceeds maximum size");
     }
-    
-    const size_type cap = capacity();
-    if (cap >= ms / 2) {
-      return ms;  // 已经达到最大容量的一半，直接返回最大容量
-    }
-
-    // 小容量时使用2倍增长，大容量时使用1.5倍增长
-    size_type growth;
-    if (cap < 4096) {
-      growth = cap * 2;  // 小容量时翻倍增长
-    } else {
-      growth = cap + cap / 2;  // 大容量时增加50%
-    }
-
-    // 确保至少能容纳请求的大小，并且不超过最大容量
-    return std::min(
-      std::max(
-        std::max(growth, new_size),  // 至少是增长后的容量或满足新大小
-        size_type(16)                // 最小初始容量为16
-      ),
-      ms
-    );
+    return GrowthPolicy::next_capacity(capacity(), new_size, ms, sizeof(T));
   }
 
+public:
   // 比较运算符
+  // 整数和指针按字节比较相等，交给memcmp；算术类型的字典序比较先用SIMD跳过相同的前缀
   friend bool operator==(const vector& lhs, const vector& rhs)
   {
     if (lhs.size_ != rhs.size_) {
       return false;
     }
-    for (size_type i = 0; i < lhs.size_; ++i) {
-      if (!(lhs.data_[i] == rhs.data_[i])) {
-        return false;
+    if constexpr (is_bytewise_equality_comparable_v<T> && std::is_same<pointer, T*>::value) {
+      return lhs.size_ == 0 || std::memcmp(lhs.data_, rhs.data_, lhs.size_ * sizeof(T)) == 0;
+    } else {
+      for (size_type i = 0; i < lhs.size_; ++i) {
+        if (!(lhs.data_[i] == rhs.data_[i])) {
+          return false;
+        }
       }
+      return true;
     }
-    return true;
   }
 
   friend bool operator!=(const vector& lhs, const vector& rhs) { return !(lhs == rhs); }
 
   friend bool operator<(const vector& lhs, const vector& rhs)
   {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    if constexpr (std::is_arithmetic<T>::value && std::is_same<pointer, T*>::value) {
+      return arithmetic_lexicographical_less(lhs.data_, lhs.size_, rhs.data_, rhs.size_);
+    } else {
+      return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
   }
 
   friend bool operator<=(const vector& lhs, const vector& rhs) { return !(rhs < lhs); }
@@ -855,15 +1249,26 @@ private:
   friend bool operator>=(const vector& lhs, const vector& rhs) { return !(lhs < rhs); }
 
   // 交换两个vector的内容
-  void swap(vector& other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_swap::value ||
-                                   std::allocator_traits<allocator_type>::is_always_equal::value)
+  void swap(vector& other) noexcept(nothrow_steal &&
+                                   (std::allocator_traits<allocator_type>::propagate_on_container_swap::value ||
+                                    std::allocator_traits<allocator_type>::is_always_equal::value))
   {
     if (this != &other) {
       using std::swap;
+
+      if constexpr (InlineCapacity > 0) {
+        // 内联缓冲区中的元素不能通过交换指针转移，借助移动完成交换
+        if (is_inline() || other.is_inline()) {
+          vector tmp(std::move(other));
+          other = std::move(*this);
+          *this = std::move(tmp);
+          return;
+        }
+      }
       
       if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
         swap(alloc_, other.alloc_);
-      } else {
+      } else if constexpr (!std::allocator_traits<allocator_type>::is_always_equal::value) {
         // 如果分配器不可交换，则要求它们必须相等
         if (alloc_ != other.alloc_) {
           throw std::runtime_error("vector::swap: allocators must be equal for containers with allocators that do not propagate on swap");
@@ -884,17 +1289,12 @@ private:
     }
 
     size_type index = pos - cbegin();
-    
-    // 移动后面的元素
-    for (size_type i = index; i < size_ - 1; ++i) {
-      std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
-      std::allocator_traits<allocator_type>::construct(alloc_, data_ + i, std::move_if_noexcept(data_[i + 1]));
-    }
-    
-    // 销毁最后一个元素
-    std::allocator_traits<allocator_type>::destroy(alloc_, data_ + size_ - 1);
+
+    // 销毁目标元素，再把后面的元素前移填补空位
+    std::allocator_traits<allocator_type>::destroy(alloc_, data_ + index);
+    close_gap(index, 1, size_ - index - 1);
     --size_;
-    
+
     return begin() + index;
   }
 
@@ -911,30 +1311,44 @@ private:
 
     size_type start_index = first - cbegin();
     size_type count = last - first;
-    
+
     // 如果删除范围为空或起始位置已经是末尾，直接返回
     if (count == 0 || start_index >= size_) {
       return begin() + start_index;
     }
 
-    // 移动元素
-    size_type elements_after = size_ - (start_index + count);
-    for (size_type i = 0; i < elements_after; ++i) {
-      size_type from_index = start_index + count + i;
-      size_type to_index = start_index + i;
-      
-      std::allocator_traits<allocator_type>::destroy(alloc_, data_ + to_index);
-      std::allocator_traits<allocator_type>::construct(alloc_, data_ + to_index, 
-                                                      std::move_if_noexcept(data_[from_index]));
+    // 销毁被删除的元素，再把后面的元素整体前移
+    destroy_range(data_ + start_index, data_ + start_index + count);
+    close_gap(start_index, count, size_ - (start_index + count));
+
+    size_ -= count;
+    return begin() + start_index;
+  }
+
+  // 删除指定位置的元素并用最后一个元素填补空位，O(1)但不保持元素的相对顺序。
+  // 返回指向该位置的迭代器（删除的是最后一个元素时为end()）
+  iterator unordered_erase(const_iterator pos)
+  {
+    if (pos < cbegin() || pos >= cend()) {
+      throw std::out_of_range("vector::unordered_erase: iterator out of range");
     }
 
-    // 销毁多余的元素
-    for (size_type i = size_ - count; i < size_; ++i) {
-      std::allocator_traits<allocator_type>::destroy(alloc_, data_ + i);
+    size_type index = pos - cbegin();
+    pointer   last  = data_ + size_ - 1;
+    if (data_ + index != last) {
+      if constexpr (relocate_by_memcpy) {
+        std::allocator_traits<allocator_type>::destroy(alloc_, data_ + index);
+        std::memcpy(static_cast<void*>(data_ + index), static_cast<const void*>(last), sizeof(T));
+      } else {
+        data_[index] = std::move(*last);
+        std::allocator_traits<allocator_type>::destroy(alloc_, last);
+      }
+    } else {
+      std::allocator_traits<allocator_type>::destroy(alloc_, last);
     }
+    --size_;
 
-    size_ -= count;
-    return begin() + start_index;
+    return begin() + index;
   }
 
   // 非成员函数swap
@@ -947,31 +1361,54 @@ private:
   allocator_type get_allocator() const noexcept { return alloc_; }
 };
 
+// 没有内联缓冲区的vector只保存指向堆内存的指针、大小和分配器，可以按字节搬迁；
+// 有内联缓冲区时数据指针可能指向对象自身，不能按字节搬迁
+template <typename T, typename Alloc, typename Growth>
+struct is_trivially_relocatable<vector<T, Alloc, 0, Growth>> : is_trivially_relocatable<Alloc> {
+};
+
 // C++17 非成员函数
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::pointer data(vector<T, Alloc>& v) noexcept
+template <typename T, typename Alloc, size_type N, typename Growth>
+typename vector<T, Alloc, N, Growth>::pointer data(vector<T, Alloc, N, Growth>& v) noexcept
 {
   return v.data();
 }
 
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::const_pointer data(const vector<T, Alloc>& v) noexcept
+template <typename T, typename Alloc, size_type N, typename Growth>
+typename vector<T, Alloc, N, Growth>::const_pointer data(const vector<T, Alloc, N, Growth>& v) noexcept
 {
   return v.data();
 }
 
-template <typename T, typename Alloc>
-bool empty(const vector<T, Alloc>& v) noexcept
+template <typename T, typename Alloc, size_type N, typename Growth>
+bool empty(const vector<T, Alloc, N, Growth>& v) noexcept
 {
   return v.empty();
 }
 
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::size_type size(const vector<T, Alloc>& v) noexcept
+template <typename T, typename Alloc, size_type N, typename Growth>
+typename vector<T, Alloc, N, Growth>::size_type size(const vector<T, Alloc, N, Growth>& v) noexcept
 {
   return v.size();
 }
 
+// 删除所有满足pred的元素：一遍压缩保留的元素，再一次性销毁尾部，返回删除的元素个数
+template <typename T, typename Alloc, size_type N, typename Growth, typename Pred>
+typename vector<T, Alloc, N, Growth>::size_type erase_if(vector<T, Alloc, N, Growth>& v, Pred pred)
+{
+  auto new_end = std::remove_if(v.begin(), v.end(), pred);
+  auto removed = static_cast<typename vector<T, Alloc, N, Growth>::size_type>(v.end() - new_end);
+  v.erase(new_end, v.end());
+  return removed;
+}
+
+// 删除所有等于value的元素，返回删除的元素个数
+template <typename T, typename Alloc, size_type N, typename Growth, typename U>
+typename vector<T, Alloc, N, Growth>::size_type erase(vector<T, Alloc, N, Growth>& v, const U& value)
+{
+  return erase_if(v, [&value](const T& x) { return x == value; });
+}
+
 }  // namespace sjkxq_stl
 
 #endif  // SJKXQ_STL_VECTOR_HPP
\ No newline at end of file
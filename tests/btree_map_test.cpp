@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <sjkxq_stl/btree_map.hpp>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+// 复制时计数、可以按需抛出异常的键，移动不抛出
+struct CopyCountingKey {
+  static int  copies;
+  static bool throw_on_copy;
+
+  int value;
+
+  explicit CopyCountingKey(int v) : value(v) {}
+
+  CopyCountingKey(const CopyCountingKey& other) : value(other.value)
+  {
+    if (throw_on_copy) {
+      throw std::runtime_error("copy");
+    }
+    ++copies;
+  }
+
+  CopyCountingKey(CopyCountingKey&& other) noexcept : value(other.value) {}
+
+  CopyCountingKey& operator=(const CopyCountingKey&) = default;
+  CopyCountingKey& operator=(CopyCountingKey&&)      = default;
+
+  bool operator<(const CopyCountingKey& other) const { return value < other.value; }
+};
+
+int  CopyCountingKey::copies        = 0;
+bool CopyCountingKey::throw_on_copy = false;
+
+}  // namespace
+
+// 接口与map相同，这里集中测试B树特有的节点分裂、借用和合并
+
+// 测试大量随机插入删除：节点反复分裂、合并和借用元素后仍与std::map一致
+TEST(BTreeMapTest, RandomizedAgainstStdMap)
+{
+  sjkxq_stl::btree_map<int, std::string> m;
+  std::map<int, std::string>             expected;
+  std::mt19937                           rng(2024);
+
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(rng() % 5000);
+    if (rng() % 5 < 2) {
+      ASSERT_EQ(m.erase(key), expected.erase(key));
+    } else {
+      std::string value = std::to_string(key * 7);
+      ASSERT_EQ(m.emplace(key, value).second, expected.emplace(key, value).second);
+    }
+  }
+
+  ASSERT_EQ(m.size(), expected.size());
+  EXPECT_TRUE(std::equal(m.begin(), m.end(), expected.begin()));
+  EXPECT_TRUE(std::equal(m.rbegin(), m.rend(), expected.rbegin()));
+
+  for (int key = -1; key <= 5001; key += 13) {
+    auto lower = m.lower_bound(key);
+    auto ref   = expected.lower_bound(key);
+    ASSERT_EQ(lower == m.end(), ref == expected.end());
+    if (ref != expected.end()) {
+      EXPECT_EQ(lower->first, ref->first);
+    }
+    auto upper     = m.upper_bound(key);
+    auto ref_upper = expected.upper_bound(key);
+    ASSERT_EQ(upper == m.end(), ref_upper == expected.end());
+    if (ref_upper != expected.end()) {
+      EXPECT_EQ(upper->first, ref_upper->first);
+    }
+  }
+
+  // erase返回原下一个元素，边遍历边删除所有奇数键
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->first % 2 != 0) {
+      it = m.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = expected.begin(); it != expected.end();) {
+    it = it->first % 2 != 0 ? expected.erase(it) : std::next(it);
+  }
+  ASSERT_EQ(m.size(), expected.size());
+  EXPECT_TRUE(std::equal(m.begin(), m.end(), expected.begin()));
+}
+
+// 测试顺序插入和从两端依次删除
+TEST(BTreeMapTest, SequentialInsertAndErase)
+{
+  sjkxq_stl::btree_map<int, int> ascending;
+  sjkxq_stl::btree_map<int, int> descending;
+  for (int i = 0; i < 10000; ++i) {
+    ascending.insert(ascending.end(), {i, i});
+    descending.emplace(9999 - i, i);
+  }
+  EXPECT_EQ(ascending.size(), 10000);
+  EXPECT_EQ(descending.begin()->first, 0);
+  EXPECT_EQ(std::prev(descending.end())->first, 9999);
+
+  sjkxq_stl::btree_map<int, int> copy(ascending);
+  EXPECT_EQ(copy, ascending);
+
+  for (int i = 0; i < 5000; ++i) {
+    ascending.erase(ascending.begin());
+    copy.erase(std::prev(copy.end()));
+  }
+  EXPECT_EQ(ascending.begin()->first, 5000);
+  EXPECT_EQ(std::prev(copy.end())->first, 4999);
+
+  ascending.erase(ascending.begin(), ascending.end());
+  EXPECT_TRUE(ascending.empty());
+  EXPECT_EQ(ascending.begin(), ascending.end());
+
+  auto it = copy.erase(copy.find(100), copy.find(4000));
+  EXPECT_EQ(it->first, 4000);
+  EXPECT_EQ(copy.size(), 1100);
+}
+
+// 测试节点分裂、合并和借用元素时移动键而不复制，键的复制异常能传到调用者
+TEST(BTreeMapTest, RelocationMovesKeys)
+{
+  CopyCountingKey::copies        = 0;
+  CopyCountingKey::throw_on_copy = false;
+
+  sjkxq_stl::btree_map<CopyCountingKey, int> m;
+  for (int i = 1000; i > 0; --i) {
+    m.try_emplace(CopyCountingKey(i), i);
+    m.emplace(CopyCountingKey(-i), -i);
+  }
+  for (int i = 1; i <= 1000; i += 2) {
+    m.erase(CopyCountingKey(i));
+  }
+  EXPECT_EQ(CopyCountingKey::copies, 0);
+  EXPECT_EQ(m.size(), 1500);
+
+  CopyCountingKey::throw_on_copy = true;
+  const std::pair<const CopyCountingKey, int> value(CopyCountingKey(1), 1);
+  EXPECT_THROW(m.insert(value), std::runtime_error);
+  EXPECT_THROW(m.emplace(value), std::runtime_error);
+  CopyCountingKey::throw_on_copy = false;
+
+  EXPECT_EQ(m.size(), 1500);
+  EXPECT_FALSE(m.contains(CopyCountingKey(1)));
+  int expected = -1000;
+  for (const auto& entry : m) {
+    ASSERT_EQ(entry.first.value, expected);
+    expected += expected < 0 ? 1 : 2;
+    if (expected == 0) {
+      expected = 2;
+    }
+  }
+}
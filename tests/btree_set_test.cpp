@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <sjkxq_stl/btree_set.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+// 接口与set相同，这里集中测试B树特有的节点分裂、借用和合并
+
+// 测试随机插入删除后与std::set逐个比较，并检查拷贝、交换后的结构
+TEST(BTreeSetTest, RandomizedAgainstStdSet)
+{
+  sjkxq_stl::btree_set<int> s;
+  std::set<int>             expected;
+  std::mt19937              rng(12345);
+
+  for (int i = 0; i < 20000; ++i) {
+    int value = static_cast<int>(rng() % 2000);
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(s.erase(value), expected.erase(value));
+    } else {
+      EXPECT_EQ(s.insert(value).second, expected.insert(value).second);
+    }
+  }
+
+  ASSERT_EQ(s.size(), expected.size());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin()));
+  EXPECT_TRUE(std::equal(s.rbegin(), s.rend(), expected.rbegin()));
+
+  sjkxq_stl::btree_set<int> copy(s);
+  EXPECT_EQ(copy, s);
+  copy.erase(copy.begin(), copy.find(*std::next(expected.begin(), 100)));
+  EXPECT_EQ(copy.size(), expected.size() - 100);
+
+  sjkxq_stl::btree_set<int> other{-1};
+  other.swap(copy);
+  EXPECT_EQ(*other.begin(), *std::next(expected.begin(), 100));
+  EXPECT_EQ(*copy.begin(), -1);
+  copy.insert(-2);
+  EXPECT_EQ(*copy.begin(), -2);
+
+  // 带提示的有序插入
+  sjkxq_stl::btree_set<int> hinted;
+  for (int value : expected) {
+    hinted.insert(hinted.end(), value);
+  }
+  EXPECT_EQ(hinted, s);
+
+  // 只有一个元素时，begin()前进一步应到达end()
+  sjkxq_stl::btree_set<int> single{7};
+  EXPECT_EQ(std::next(single.begin()), single.end());
+  EXPECT_EQ(std::prev(single.end()), single.begin());
+}
+
+// 元素很大时每个节点只能放3个元素，少量元素就能形成多层树，
+// 反复触发各层节点的分裂、借用和合并
+struct WideKey {
+  int  value;
+  char padding[124];
+
+  WideKey(int v = 0) : value(v), padding{} {}  // NOLINT - 允许从int隐式构造
+  bool operator<(const WideKey& other) const { return value < other.value; }
+  bool operator==(const WideKey& other) const { return value == other.value; }
+};
+
+TEST(BTreeSetTest, SplitAndMergeAcrossLevels)
+{
+  sjkxq_stl::btree_set<WideKey> s;
+  std::set<int>                 expected;
+  std::mt19937                  rng(7);
+
+  auto check = [&]() {
+    ASSERT_EQ(s.size(), expected.size());
+    auto it = s.begin();
+    for (int value : expected) {
+      ASSERT_EQ(it->value, value);
+      ++it;
+    }
+    EXPECT_EQ(it, s.end());
+    auto rit = s.rbegin();
+    for (auto ref = expected.rbegin(); ref != expected.rend(); ++ref, ++rit) {
+      ASSERT_EQ(rit->value, *ref);
+    }
+  };
+
+  // 交替地成批插入和删除，树的高度反复增长和降低
+  std::vector<int> values(3000);
+  for (int i = 0; i < 3000; ++i) {
+    values[i] = i;
+  }
+  for (int round = 0; round < 4; ++round) {
+    std::shuffle(values.begin(), values.end(), rng);
+    for (int value : values) {
+      EXPECT_EQ(s.insert(value).second, expected.insert(value).second);
+    }
+    check();
+
+    std::shuffle(values.begin(), values.end(), rng);
+    const size_t keep = round % 2 == 0 ? 10 : 1500;
+    for (size_t i = keep; i < values.size(); ++i) {
+      EXPECT_EQ(s.erase(values[i]), expected.erase(values[i]));
+    }
+    check();
+  }
+
+  // 区间删除跨越多个叶子和内部节点
+  for (int i = 0; i < 3000; ++i) {
+    s.insert(i);
+    expected.insert(i);
+  }
+  s.erase(s.find(100), s.find(2900));
+  expected.erase(expected.find(100), expected.find(2900));
+  check();
+
+  while (!s.empty()) {
+    s.erase(s.begin());
+  }
+  EXPECT_EQ(s.begin(), s.end());
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <sjkxq_stl/flat_hash_map.hpp>
+#include <string>
+
+// 测试默认构造函数和基本操作
+TEST(FlatHashMapTest, DefaultConstructor)
+{
+  sjkxq_stl::flat_hash_map<int, std::string> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.size(), 0);
+  EXPECT_EQ(m.find(1), m.end());
+}
+
+// 测试初始化列表构造函数
+TEST(FlatHashMapTest, InitializerListConstructor)
+{
+  sjkxq_stl::flat_hash_map<int, std::string> m{{1, "one"}, {2, "two"}, {1, "uno"}};
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_EQ(m.at(1), "one");
+  EXPECT_EQ(m.at(2), "two");
+}
+
+// 测试元素访问
+TEST(FlatHashMapTest, ElementAccess)
+{
+  sjkxq_stl::flat_hash_map<std::string, int> m;
+  m["a"] = 1;
+  m["b"] = 2;
+  ++m["a"];
+  EXPECT_EQ(m["a"], 2);
+  EXPECT_EQ(m.at("b"), 2);
+  EXPECT_THROW(m.at("c"), sjkxq_stl::out_of_range);
+
+  const auto& cm = m;
+  EXPECT_EQ(cm.at("a"), 2);
+}
+
+// 测试插入操作
+TEST(FlatHashMapTest, Insertion)
+{
+  sjkxq_stl::flat_hash_map<int, std::string> m;
+
+  auto [it1, inserted1] = m.insert({1, "one"});
+  EXPECT_TRUE(inserted1);
+  EXPECT_EQ(it1->second, "one");
+
+  auto [it2, inserted2] = m.insert(std::make_pair(1, std::string("uno")));
+  EXPECT_FALSE(inserted2);
+  EXPECT_EQ(it2->second, "one");
+
+  auto [it3, inserted3] = m.emplace(2, "two");
+  EXPECT_TRUE(inserted3);
+
+  std::string value = "three";
+  m.try_emplace(3, std::move(value));
+  EXPECT_EQ(m.at(3), "three");
+
+  std::string kept = "ignored";
+  auto [it4, inserted4] = m.try_emplace(3, std::move(kept));
+  EXPECT_FALSE(inserted4);
+  EXPECT_EQ(kept, "ignored");  // NOLINT - 键已存在时参数不会被移动
+
+  m.insert_or_assign(3, "drei");
+  EXPECT_EQ(m.at(3), "drei");
+  EXPECT_TRUE(m.insert_or_assign(4, "vier").second);
+  EXPECT_EQ(m.size(), 4);
+}
+
+// 测试大量元素的插入、删除和遍历
+TEST(FlatHashMapTest, ManyElements)
+{
+  sjkxq_stl::flat_hash_map<int, int> m;
+  for (int i = 0; i < 5000; ++i) {
+    m[i] = i * i;
+  }
+  EXPECT_EQ(m.size(), 5000);
+
+  for (int i = 0; i < 5000; i += 2) {
+    m.erase(i);
+  }
+  EXPECT_EQ(m.size(), 2500);
+
+  long long sum = 0;
+  for (auto& [key, value] : m) {
+    EXPECT_EQ(key % 2, 1);
+    EXPECT_EQ(value, key * key);
+    value = 0;
+    ++sum;
+  }
+  EXPECT_EQ(sum, 2500);
+  EXPECT_EQ(m.at(4999), 0);
+}
+
+// 测试复制、移动、比较和交换
+TEST(FlatHashMapTest, CopyMoveCompareSwap)
+{
+  sjkxq_stl::flat_hash_map<std::string, int> m1{{"a", 1}, {"b", 2}};
+
+  sjkxq_stl::flat_hash_map<std::string, int> m2(m1);
+  EXPECT_EQ(m1, m2);
+  m2["a"] = 10;
+  EXPECT_NE(m1, m2);
+
+  sjkxq_stl::flat_hash_map<std::string, int> m3(std::move(m2));
+  EXPECT_EQ(m3.at("a"), 10);
+  EXPECT_TRUE(m2.empty());  // NOLINT - 访问移动后的对象是安全的
+
+  swap(m1, m3);
+  EXPECT_EQ(m1.at("a"), 10);
+  EXPECT_EQ(m3.at("a"), 1);
+}
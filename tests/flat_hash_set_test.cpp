@@ -0,0 +1,319 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <sjkxq_stl/flat_hash_set.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 测试默认构造函数和基本操作
+TEST(FlatHashSetTest, DefaultConstructor)
+{
+  sjkxq_stl::flat_hash_set<int> s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.size(), 0);
+  EXPECT_EQ(s.begin(), s.end());
+  EXPECT_FALSE(s.contains(1));
+  EXPECT_EQ(s.erase(1), 0);
+}
+
+// 测试带桶数的构造函数和初始化列表构造函数
+TEST(FlatHashSetTest, Constructors)
+{
+  sjkxq_stl::flat_hash_set<int> s1(100);
+  EXPECT_GE(s1.bucket_count(), 100);
+  EXPECT_TRUE(s1.empty());
+
+  sjkxq_stl::flat_hash_set<int> s2{1, 2, 3, 2};
+  EXPECT_EQ(s2.size(), 3);
+  EXPECT_TRUE(s2.contains(1));
+  EXPECT_TRUE(s2.contains(3));
+
+  std::vector<std::string>              words{"a", "b", "a", "c"};
+  sjkxq_stl::flat_hash_set<std::string> s3(words.begin(), words.end());
+  EXPECT_EQ(s3.size(), 3);
+}
+
+// 测试插入、查找和删除
+TEST(FlatHashSetTest, InsertFindErase)
+{
+  sjkxq_stl::flat_hash_set<int> s;
+
+  auto [it1, inserted1] = s.insert(42);
+  EXPECT_TRUE(inserted1);
+  EXPECT_EQ(*it1, 42);
+
+  auto [it2, inserted2] = s.insert(42);
+  EXPECT_FALSE(inserted2);
+  EXPECT_EQ(it1, it2);
+
+  EXPECT_NE(s.find(42), s.end());
+  EXPECT_EQ(s.find(7), s.end());
+  EXPECT_EQ(s.count(42), 1);
+
+  EXPECT_EQ(s.erase(42), 1);
+  EXPECT_EQ(s.erase(42), 0);
+  EXPECT_TRUE(s.empty());
+}
+
+// 测试大量插入删除后的扩容与墓碑回收
+TEST(FlatHashSetTest, GrowthAndTombstones)
+{
+  sjkxq_stl::flat_hash_set<int> s;
+  for (int i = 0; i < 10000; ++i) {
+    s.insert(i);
+  }
+  EXPECT_EQ(s.size(), 10000);
+  EXPECT_LE(s.load_factor(), s.max_load_factor());
+
+  for (int i = 0; i < 10000; i += 2) {
+    EXPECT_EQ(s.erase(i), 1);
+  }
+  EXPECT_EQ(s.size(), 5000);
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_EQ(s.contains(i), i % 2 == 1);
+  }
+
+  // 反复插入删除，墓碑不应导致容量无限增长
+  size_t capacity = s.bucket_count();
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      s.insert(-1 - i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+      s.erase(-1 - i);
+    }
+  }
+  EXPECT_EQ(s.size(), 5000);
+  EXPECT_EQ(s.bucket_count(), capacity);
+}
+
+// 测试迭代器遍历和按迭代器删除
+TEST(FlatHashSetTest, Iterators)
+{
+  sjkxq_stl::flat_hash_set<int> s;
+  for (int i = 0; i < 100; ++i) {
+    s.insert(i);
+  }
+
+  std::vector<int> values(s.begin(), s.end());
+  std::sort(values.begin(), values.end());
+  ASSERT_EQ(values.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+
+  // 删除所有偶数
+  for (auto it = s.begin(); it != s.end();) {
+    if (*it % 2 == 0) {
+      it = s.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(s.size(), 50);
+
+  const auto& cs = s;
+  size_t      n  = 0;
+  for (auto it = cs.cbegin(); it != cs.cend(); ++it) {
+    EXPECT_EQ(*it % 2, 1);
+    ++n;
+  }
+  EXPECT_EQ(n, 50);
+
+  s.erase(s.begin(), s.end());
+  EXPECT_TRUE(s.empty());
+}
+
+// 测试复制、移动和比较
+TEST(FlatHashSetTest, CopyMoveCompare)
+{
+  sjkxq_stl::flat_hash_set<std::string> s1{"apple", "banana", "cherry"};
+
+  sjkxq_stl::flat_hash_set<std::string> s2(s1);
+  EXPECT_EQ(s1, s2);
+
+  sjkxq_stl::flat_hash_set<std::string> s3(std::move(s2));
+  EXPECT_EQ(s1, s3);
+  EXPECT_TRUE(s2.empty());  // NOLINT - 访问移动后的对象是安全的
+
+  sjkxq_stl::flat_hash_set<std::string> s4;
+  s4 = s1;
+  EXPECT_EQ(s1, s4);
+  s4.insert("date");
+  EXPECT_NE(s1, s4);
+
+  s4 = {"x", "y"};
+  EXPECT_EQ(s4.size(), 2);
+
+  swap(s1, s4);
+  EXPECT_TRUE(s1.contains("x"));
+  EXPECT_TRUE(s4.contains("apple"));
+}
+
+// 测试emplace、clear、rehash和merge
+TEST(FlatHashSetTest, EmplaceClearRehashMerge)
+{
+  sjkxq_stl::flat_hash_set<std::string> s;
+  auto [it, inserted] = s.emplace(3, 'a');
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, "aaa");
+  EXPECT_EQ(*s.emplace_hint(s.end(), "b"), "b");
+
+  s.rehash(1000);
+  EXPECT_GE(s.bucket_count(), 1000);
+  EXPECT_TRUE(s.contains("aaa"));
+
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  EXPECT_GE(s.bucket_count(), 1000);
+
+  sjkxq_stl::flat_hash_set<std::string> a{"one", "two"};
+  sjkxq_stl::flat_hash_set<std::string> b{"two", "three"};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 3);
+  EXPECT_EQ(b.size(), 1);
+  EXPECT_TRUE(b.contains("two"));
+}
+
+// 测试所有哈希值都落在同一组时的探测
+TEST(FlatHashSetTest, CollidingHash)
+{
+  struct ConstantHash {
+    size_t operator()(int) const { return 0; }
+  };
+
+  sjkxq_stl::flat_hash_set<int, ConstantHash> s;
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_TRUE(s.insert(i).second);
+  }
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_TRUE(s.contains(i));
+  }
+  for (int i = 0; i < 200; i += 3) {
+    EXPECT_EQ(s.erase(i), 1);
+  }
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(s.contains(i), i % 3 != 0);
+  }
+}
+
+// 测试rehash过程中哈希函数抛出异常：原表保持不变，新表被释放
+template <typename Key>
+void check_rehash_rollback()
+{
+  struct FlakyHash {
+    int* remaining;
+    size_t operator()(const Key& key) const
+    {
+      if (*remaining == 0) {
+        throw std::runtime_error("hash failed");
+      }
+      --*remaining;
+      return std::hash<Key>()(key);
+    }
+  };
+
+  int remaining = -1;  // 负数表示不限次数
+  sjkxq_stl::flat_hash_set<Key, FlakyHash> s(0, FlakyHash{&remaining});
+  std::vector<Key> keys;
+  for (int i = 0; i < 40; ++i) {
+    if constexpr (std::is_same<Key, std::string>::value) {
+      keys.push_back("key number " + std::to_string(i));
+    } else {
+      keys.push_back(i);
+    }
+    s.insert(keys.back());
+  }
+  const size_t buckets = s.bucket_count();
+
+  remaining = 10;
+  EXPECT_THROW(s.rehash(buckets * 4), std::runtime_error);
+  remaining = -1;
+
+  EXPECT_EQ(s.size(), keys.size());
+  EXPECT_EQ(s.bucket_count(), buckets);
+  for (const Key& key : keys) {
+    EXPECT_TRUE(s.contains(key));
+  }
+  EXPECT_EQ(static_cast<size_t>(std::distance(s.begin(), s.end())), keys.size());
+}
+
+TEST(FlatHashSetTest, RehashRollback)
+{
+  check_rehash_rollback<int>();
+  check_rehash_rollback<std::string>();
+}
+
+// 测试请求的元素数超过max_size()时抛出length_error，容器保持不变
+TEST(FlatHashSetTest, CapacityOverflow)
+{
+  sjkxq_stl::flat_hash_set<int> s{1, 2, 3};
+  const size_t buckets = s.bucket_count();
+
+  EXPECT_THROW(s.reserve(SIZE_MAX / 2), std::length_error);
+  EXPECT_THROW(s.reserve(s.max_size() + 1), std::length_error);
+  EXPECT_THROW(s.rehash(SIZE_MAX), std::length_error);
+
+  sjkxq_stl::flat_hash_set<char> chars;
+  EXPECT_THROW(chars.reserve(chars.max_size()), std::length_error);
+
+  EXPECT_EQ(s.size(), 3);
+  EXPECT_EQ(s.bucket_count(), buckets);
+  EXPECT_TRUE(s.contains(2));
+}
+
+// 测试各个组匹配实现（可移植实现总是参与测试，SIMD实现取决于编译目标）
+template <typename Group>
+class FlatHashGroupTest : public ::testing::Test
+{
+};
+
+using FlatHashGroupTypes = ::testing::Types<sjkxq_stl::flat_hash_group_portable
+#if defined(SJKXQ_STL_HAVE_SSE2)
+                                            ,
+                                            sjkxq_stl::flat_hash_group_sse2
+#endif
+#if defined(SJKXQ_STL_HAVE_AVX2)
+                                            ,
+                                            sjkxq_stl::flat_hash_group_avx2
+#endif
+                                            >;
+TYPED_TEST_SUITE(FlatHashGroupTest, FlatHashGroupTypes);
+
+TYPED_TEST(FlatHashGroupTest, Match)
+{
+  constexpr size_t width = TypeParam::width;
+
+  sjkxq_stl::flat_hash_ctrl_t ctrl[width];
+  for (size_t i = 0; i < width; ++i) {
+    ctrl[i] = static_cast<sjkxq_stl::flat_hash_ctrl_t>(i % 8);
+  }
+  ctrl[1]         = sjkxq_stl::flat_hash_ctrl_empty;
+  ctrl[2]         = sjkxq_stl::flat_hash_ctrl_deleted;
+  ctrl[width - 1] = sjkxq_stl::flat_hash_ctrl_empty;
+
+  TypeParam group(ctrl);
+
+  std::vector<unsigned> matched;
+  for (unsigned i : group.match(5)) {
+    matched.push_back(i);
+  }
+  std::vector<unsigned> expected;
+  for (unsigned i = 0; i < width; ++i) {
+    if (ctrl[i] == 5) {
+      expected.push_back(i);
+    }
+  }
+  EXPECT_EQ(matched, expected);
+  EXPECT_FALSE(group.match(100));
+
+  EXPECT_EQ(group.match_empty().lowest(), 1u);
+  EXPECT_EQ(group.match_empty_or_deleted().lowest(), 1u);
+
+  std::vector<unsigned> available;
+  for (unsigned i : group.match_empty_or_deleted()) {
+    available.push_back(i);
+  }
+  EXPECT_EQ(available, (std::vector<unsigned>{1, 2, static_cast<unsigned>(width - 1)}));
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <sjkxq_stl/flat_map.hpp>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 测试默认构造函数和基本操作
+TEST(FlatMapTest, DefaultConstructor)
+{
+  sjkxq_stl::flat_map<int, std::string> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.size(), 0);
+  EXPECT_EQ(m.begin(), m.end());
+}
+
+// 测试从无序输入批量构造：键和值分别存放，按键排序并去重
+TEST(FlatMapTest, BulkConstruction)
+{
+  sjkxq_stl::flat_map<int, std::string> m{{3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+  EXPECT_EQ(m.size(), 3);
+  EXPECT_EQ(m.at(1), "one");  // 重复的键保留最先出现的一个
+
+  EXPECT_EQ(m.keys().size(), 3);
+  EXPECT_EQ(m.keys()[0], 1);
+  EXPECT_EQ(m.values()[2], "three");
+
+  sjkxq_stl::vector<int>                keys{9, 7, 8};
+  sjkxq_stl::vector<std::string>        values{"nine", "seven", "eight"};
+  sjkxq_stl::flat_map<int, std::string> from_containers(std::move(keys), std::move(values));
+  EXPECT_EQ(from_containers.begin()->first, 7);
+  EXPECT_EQ(from_containers.begin()->second, "seven");
+  EXPECT_EQ(from_containers.at(9), "nine");
+
+  sjkxq_stl::flat_map<int, int> sorted(sjkxq_stl::sorted_unique, {{1, 10}, {2, 20}});
+  EXPECT_EQ(sorted[2], 20);
+}
+
+// 测试元素访问
+TEST(FlatMapTest, ElementAccess)
+{
+  sjkxq_stl::flat_map<std::string, int> m;
+  m["b"] = 2;
+  m["a"] = 1;
+  EXPECT_EQ(m.at("a"), 1);
+  EXPECT_THROW(m.at("c"), std::out_of_range);
+  EXPECT_EQ(m["c"], 0);
+  EXPECT_EQ(m.size(), 3);
+
+  // 迭代器解引用得到键和值的引用对
+  for (auto [key, value] : m) {
+    value *= 10;
+  }
+  EXPECT_EQ(m["b"], 20);
+
+  int expected = 10;
+  for (auto it = m.cbegin(); it != m.cend(); ++it) {
+    EXPECT_EQ(it->second, expected == 30 ? 0 : expected);
+    expected += 10;
+  }
+}
+
+// 测试插入、try_emplace和insert_or_assign
+TEST(FlatMapTest, Insertion)
+{
+  sjkxq_stl::flat_map<int, std::string> m;
+  auto [it1, inserted1] = m.insert({2, "two"});
+  EXPECT_TRUE(inserted1);
+  EXPECT_EQ(it1->second, "two");
+  EXPECT_FALSE(m.insert({2, "dos"}).second);
+  EXPECT_TRUE(m.emplace(1, "one").second);
+
+  std::string value = "three";
+  EXPECT_TRUE(m.try_emplace(3, std::move(value)).second);
+  std::string other = "tres";
+  EXPECT_FALSE(m.try_emplace(3, std::move(other)).second);
+  EXPECT_EQ(other, "tres");  // 键已存在时参数不会被移动
+
+  EXPECT_FALSE(m.insert_or_assign(3, "drei").second);
+  EXPECT_EQ(m[3], "drei");
+
+  auto it = m.try_emplace(m.end(), 4, "four");
+  EXPECT_EQ(it->first, 4);
+  it = m.insert(m.begin(), {0, "zero"});
+  EXPECT_EQ(m.begin()->first, 0);
+  EXPECT_EQ(m.size(), 5);
+}
+
+// 测试删除和范围查找
+TEST(FlatMapTest, EraseAndLookup)
+{
+  sjkxq_stl::flat_map<int, int> m{{10, 1}, {20, 2}, {30, 3}, {40, 4}};
+
+  EXPECT_EQ(m.lower_bound(15)->first, 20);
+  EXPECT_EQ(m.upper_bound(20)->first, 30);
+  EXPECT_EQ(m.find(25), m.end());
+  EXPECT_TRUE(m.contains(40));
+
+  auto it = m.erase(m.find(20));
+  EXPECT_EQ(it->first, 30);
+  EXPECT_EQ(m.erase(40), 1);
+  EXPECT_EQ(m.erase(40), 0);
+  it = m.erase(m.begin(), m.end());
+  EXPECT_EQ(it, m.end());
+  EXPECT_TRUE(m.empty());
+}
+
+// 测试批量插入：新元素排序后与原有元素合并，键已存在时保留原值
+TEST(FlatMapTest, BatchedInsert)
+{
+  sjkxq_stl::flat_map<int, int>    m{{1, 1}, {5, 5}, {9, 9}};
+  std::vector<std::pair<int, int>> more{{8, 80}, {5, 50}, {2, 20}, {2, 21}, {0, 0}};
+  m.insert(more.begin(), more.end());
+
+  EXPECT_EQ(m.size(), 6);
+  EXPECT_EQ(m[5], 5);
+  EXPECT_EQ(m[2], 20);
+  EXPECT_TRUE(std::is_sorted(m.keys().begin(), m.keys().end()));
+
+  // 与std::map对比随机批量插入的结果
+  std::mt19937                  rng(11);
+  sjkxq_stl::flat_map<int, int> big;
+  std::map<int, int>            reference;
+  for (int round = 0; round < 20; ++round) {
+    std::vector<std::pair<int, int>> batch;
+    for (int i = 0; i < 500; ++i) {
+      batch.emplace_back(static_cast<int>(rng() % 5000), round);
+    }
+    big.insert(batch.begin(), batch.end());
+    reference.insert(batch.begin(), batch.end());
+  }
+  ASSERT_EQ(big.size(), reference.size());
+  auto ref = reference.begin();
+  for (auto [key, value] : big) {
+    EXPECT_EQ(key, ref->first);
+    EXPECT_EQ(value, ref->second);
+    ++ref;
+  }
+}
+
+// 测试取出和替换底层容器、比较运算符
+TEST(FlatMapTest, ExtractAndCompare)
+{
+  sjkxq_stl::flat_map<int, int> m1{{2, 20}, {1, 10}};
+  sjkxq_stl::flat_map<int, int> m2{{1, 10}, {2, 20}};
+  EXPECT_EQ(m1, m2);
+  m2[3] = 30;
+  EXPECT_LT(m1, m2);
+
+  auto containers = std::move(m2).extract();
+  EXPECT_TRUE(m2.empty());  // NOLINT - extract之后容器为空
+  EXPECT_EQ(containers.keys.size(), 3);
+  EXPECT_EQ(containers.values[2], 30);
+
+  m1.replace(std::move(containers.keys), std::move(containers.values));
+  EXPECT_EQ(m1.size(), 3);
+  EXPECT_EQ(m1.at(3), 30);
+}
+
+// 复制到第limit次时抛出异常的值类型，limit为负数时不限次数
+struct FlakyValue {
+  static int limit;
+  int        value;
+
+  FlakyValue(int v) : value(v) {}  // NOLINT - 允许从int隐式构造
+  FlakyValue(const FlakyValue& other) : value(other.value)
+  {
+    if (limit == 0) {
+      throw std::runtime_error("copy failed");
+    }
+    --limit;
+  }
+  FlakyValue(FlakyValue&&) noexcept            = default;
+  FlakyValue& operator=(const FlakyValue&)     = default;
+  FlakyValue& operator=(FlakyValue&&) noexcept = default;
+};
+int FlakyValue::limit = -1;
+
+// 测试批量插入时复制元素抛出异常：容器保持原样
+TEST(FlatMapTest, BatchedInsertExceptionSafety)
+{
+  sjkxq_stl::flat_map<int, FlakyValue> m;
+  m.emplace(5, 50);
+  m.emplace(10, 100);
+
+  std::vector<std::pair<int, FlakyValue>> input = {{9, 90}, {1, 10}, {7, 70}};
+  FlakyValue::limit = 2;
+  EXPECT_THROW(m.insert(input.begin(), input.end()), std::runtime_error);
+  FlakyValue::limit = 2;
+  EXPECT_THROW(m.insert(sjkxq_stl::sorted_unique, input.begin(), input.end()), std::runtime_error);
+  FlakyValue::limit = -1;
+
+  ASSERT_EQ(m.size(), 2);
+  EXPECT_EQ(m.begin()->first, 5);
+  EXPECT_EQ(std::next(m.begin())->first, 10);
+  EXPECT_EQ(m.find(1), m.end());
+  EXPECT_EQ(m.at(10).value, 100);
+
+  m.insert(input.begin(), input.end());
+  EXPECT_EQ(m.size(), 5);
+  EXPECT_EQ(m.begin()->first, 1);
+}
+
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <sjkxq_stl/flat_set.hpp>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 测试默认构造函数和基本操作
+TEST(FlatSetTest, DefaultConstructor)
+{
+  sjkxq_stl::flat_set<int> s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.size(), 0);
+  EXPECT_EQ(s.begin(), s.end());
+}
+
+// 测试从无序输入批量构造：排序并去重，重复元素保留最先出现的一个
+TEST(FlatSetTest, BulkConstruction)
+{
+  sjkxq_stl::flat_set<int> s{5, 3, 9, 3, 1, 5, 7};
+  EXPECT_EQ(s.size(), 5);
+  EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+  EXPECT_EQ(*s.begin(), 1);
+  EXPECT_EQ(*s.rbegin(), 9);
+
+  sjkxq_stl::vector<int>   raw{4, 2, 4, 8, 6, 2};
+  sjkxq_stl::flat_set<int> from_container(std::move(raw));
+  EXPECT_EQ(from_container.size(), 4);
+  EXPECT_EQ(*from_container.begin(), 2);
+
+  // 已经有序的输入可以跳过排序
+  sjkxq_stl::flat_set<int> sorted(sjkxq_stl::sorted_unique, {1, 2, 3, 4});
+  EXPECT_EQ(sorted.size(), 4);
+  EXPECT_TRUE(sorted.contains(3));
+}
+
+// 测试插入和删除
+TEST(FlatSetTest, InsertAndErase)
+{
+  sjkxq_stl::flat_set<std::string> s;
+  EXPECT_TRUE(s.insert("banana").second);
+  EXPECT_TRUE(s.insert("apple").second);
+  EXPECT_FALSE(s.insert("banana").second);
+  EXPECT_TRUE(s.emplace(3, 'c').second);
+  EXPECT_EQ(*s.begin(), "apple");
+
+  // 正确的提示直接插入，错误的提示退化为普通插入
+  auto it = s.insert(s.end(), "date");
+  EXPECT_EQ(*it, "date");
+  it = s.insert(s.begin(), "zebra");
+  EXPECT_EQ(*it, "zebra");
+  EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+
+  EXPECT_EQ(s.erase("banana"), 1);
+  EXPECT_EQ(s.erase("banana"), 0);
+  it = s.erase(s.find("ccc"));
+  EXPECT_EQ(*it, "date");
+  EXPECT_EQ(s.size(), 3);
+}
+
+// 测试查找和范围操作
+TEST(FlatSetTest, Lookup)
+{
+  sjkxq_stl::flat_set<int> s{10, 20, 30, 40};
+
+  EXPECT_NE(s.find(20), s.end());
+  EXPECT_EQ(s.find(25), s.end());
+  EXPECT_EQ(s.count(30), 1);
+  EXPECT_EQ(*s.lower_bound(25), 30);
+  EXPECT_EQ(*s.upper_bound(30), 40);
+  EXPECT_EQ(s.lower_bound(50), s.end());
+
+  auto [first, last] = s.equal_range(20);
+  EXPECT_EQ(*first, 20);
+  EXPECT_EQ(*last, 30);
+
+  // 透明比较器支持异构查找
+  sjkxq_stl::flat_set<std::string, std::less<>> names{"alice", "bob"};
+  EXPECT_TRUE(names.contains("bob"));
+  EXPECT_EQ(*names.lower_bound("b"), "bob");
+}
+
+// 测试批量插入：与原有元素合并，重复的新元素被丢弃
+TEST(FlatSetTest, BatchedInsert)
+{
+  sjkxq_stl::flat_set<int> s{1, 5, 9};
+  std::vector<int>         more{8, 2, 5, 2, 12, 0};
+  s.insert(more.begin(), more.end());
+
+  sjkxq_stl::vector<int> expected{0, 1, 2, 5, 8, 9, 12};
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+
+  // 全部排在末尾的有序输入只需追加
+  s.insert(sjkxq_stl::sorted_unique, {20, 30});
+  EXPECT_EQ(*s.rbegin(), 30);
+  EXPECT_EQ(s.size(), 9);
+
+  // 与std::set对比随机批量插入的结果
+  std::mt19937             rng(7);
+  sjkxq_stl::flat_set<int> big;
+  std::set<int>            reference;
+  for (int round = 0; round < 20; ++round) {
+    std::vector<int> batch;
+    for (int i = 0; i < 500; ++i) {
+      batch.push_back(static_cast<int>(rng() % 5000));
+    }
+    big.insert(batch.begin(), batch.end());
+    reference.insert(batch.begin(), batch.end());
+  }
+  EXPECT_TRUE(std::equal(big.begin(), big.end(), reference.begin(), reference.end()));
+}
+
+// 测试取出和替换底层容器
+TEST(FlatSetTest, ExtractAndReplace)
+{
+  sjkxq_stl::flat_set<int> s{3, 1, 2};
+  sjkxq_stl::vector<int>   keys = std::move(s).extract();
+  EXPECT_TRUE(s.empty());  // NOLINT - extract之后容器为空
+  EXPECT_EQ(keys.size(), 3);
+  EXPECT_EQ(keys[0], 1);
+
+  keys.push_back(4);
+  s.replace(std::move(keys));
+  EXPECT_EQ(s.size(), 4);
+  EXPECT_TRUE(s.contains(4));
+}
+
+// 测试比较运算符和swap
+TEST(FlatSetTest, ComparisonAndSwap)
+{
+  sjkxq_stl::flat_set<int> s1{1, 2, 3};
+  sjkxq_stl::flat_set<int> s2{3, 2, 1};
+  sjkxq_stl::flat_set<int> s3{1, 2, 4};
+
+  EXPECT_EQ(s1, s2);
+  EXPECT_NE(s1, s3);
+  EXPECT_LT(s1, s3);
+
+  swap(s1, s3);
+  EXPECT_TRUE(s1.contains(4));
+  EXPECT_FALSE(s3.contains(4));
+}
+
+// 复制到第limit次时抛出异常的元素类型，limit为负数时不限次数
+struct FlakyKey {
+  static int limit;
+  int        value;
+
+  FlakyKey(int v) : value(v) {}  // NOLINT - 允许从int隐式构造
+  FlakyKey(const FlakyKey& other) : value(other.value)
+  {
+    if (limit == 0) {
+      throw std::runtime_error("copy failed");
+    }
+    --limit;
+  }
+  FlakyKey(FlakyKey&&) noexcept            = default;
+  FlakyKey& operator=(const FlakyKey&)     = default;
+  FlakyKey& operator=(FlakyKey&&) noexcept = default;
+  bool operator<(const FlakyKey& other) const { return value < other.value; }
+};
+int FlakyKey::limit = -1;
+
+// 测试批量插入时复制或比较元素抛出异常
+TEST(FlatSetTest, BatchedInsertExceptionSafety)
+{
+  sjkxq_stl::flat_set<FlakyKey> s;
+  s.insert(5);
+  s.insert(10);
+
+  // 复制新元素失败：容器保持原样
+  std::vector<FlakyKey> input = {9, 1, 7};
+  FlakyKey::limit             = 2;
+  EXPECT_THROW(s.insert(input.begin(), input.end()), std::runtime_error);
+  FlakyKey::limit = -1;
+  ASSERT_EQ(s.size(), 2);
+  EXPECT_EQ(s.begin()->value, 5);
+  EXPECT_EQ(std::next(s.begin())->value, 10);
+
+  // 合并时比较失败：容器被清空，仍然可用
+  int  compares = 0;
+  auto flaky    = [&compares](int lhs, int rhs) {
+    if (++compares == 8) {
+      throw std::runtime_error("compare failed");
+    }
+    return lhs < rhs;
+  };
+  sjkxq_stl::flat_set<int, std::function<bool(int, int)>> t(flaky);
+  for (int v : {2, 4, 6, 8, 10}) {
+    t.insert(v);
+  }
+  compares              = 0;
+  std::vector<int> more = {1, 3, 5, 7, 9};
+  EXPECT_THROW(t.insert(sjkxq_stl::sorted_unique, more.begin(), more.end()), std::runtime_error);
+  EXPECT_TRUE(t.empty());
+  compares = -1000;
+  t.insert(more.begin(), more.end());
+  EXPECT_EQ(t.size(), 5);
+  EXPECT_TRUE(std::is_sorted(t.begin(), t.end()));
+}
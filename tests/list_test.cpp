@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 #include <sjkxq_stl/list.hpp>
+#include <sjkxq_stl/numa_allocator.hpp>
+#include <sjkxq_stl/thread_cache_allocator.hpp>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 // 测试默认构造函数和基本操作
 TEST(ListTest, DefaultConstructor)
@@ -202,4 +208,241 @@ TEST(ListTest, Emplace)
   lst.emplace_front("world");
   EXPECT_EQ(lst.size(), 2);
   EXPECT_EQ(lst.front(), "world");
-}
\ No newline at end of file
+}
+
+// 测试splice、merge和sort
+TEST(ListTest, SpliceMergeSort)
+{
+  sjkxq_stl::list<int> lst1{5, 1, 4};
+  sjkxq_stl::list<int> lst2{3, 2};
+
+  lst1.splice(lst1.end(), lst2);
+  EXPECT_TRUE(lst2.empty());
+  EXPECT_EQ(lst1, (sjkxq_stl::list<int>{5, 1, 4, 3, 2}));
+
+  lst1.sort();
+  EXPECT_EQ(lst1, (sjkxq_stl::list<int>{1, 2, 3, 4, 5}));
+
+  sjkxq_stl::list<int> lst3{0, 3, 6};
+  lst1.merge(lst3);
+  EXPECT_TRUE(lst3.empty());
+  EXPECT_EQ(lst1.size(), 8);
+  EXPECT_EQ(lst1, (sjkxq_stl::list<int>{0, 1, 2, 3, 3, 4, 5, 6}));
+}
+
+// 测试池化模式：节点来自list自己的内存池，跨list的splice/merge后原list析构也不影响结果
+TEST(ListTest, PooledList)
+{
+  sjkxq_stl::pooled_list<std::string> lst;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      lst.push_back(std::to_string(i));
+    }
+    for (auto it = lst.begin(); it != lst.end();) {
+      it = lst.erase(it);
+      if (it != lst.end()) {
+        ++it;
+      }
+    }
+    EXPECT_EQ(lst.size(), 500u);
+    lst.clear();
+  }
+
+  lst = {"d", "a", "c"};
+  {
+    sjkxq_stl::pooled_list<std::string> other{"b", "e"};
+    lst.splice(lst.begin(), other, other.begin());
+    lst.sort();  // merge要求两个list都已排序
+    lst.merge(other);
+    EXPECT_TRUE(other.empty());
+  }
+  EXPECT_EQ(lst, (sjkxq_stl::pooled_list<std::string>{"a", "b", "c", "d", "e"}));
+
+  sjkxq_stl::pooled_list<std::string> moved(std::move(lst));
+  EXPECT_TRUE(lst.empty());
+  lst.push_back("x");
+  moved.swap(lst);
+  EXPECT_EQ(moved.size(), 1u);
+  EXPECT_EQ(lst.size(), 5u);
+  EXPECT_EQ(lst.back(), "e");
+}
+
+// 带编号的有状态分配器，复制赋值和移动赋值时随容器传播，交换时不传播，按编号记录未归还的字节数
+template <typename T>
+struct TaggedAllocator {
+  using value_type                             = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  static size_t live_bytes[2];
+
+  int id = 0;
+
+  explicit TaggedAllocator(int i = 0) : id(i) {}
+  template <typename U>
+  TaggedAllocator(const TaggedAllocator<U>& other) : id(other.id)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    TaggedAllocator<char>::live_bytes[id] += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n)
+  {
+    TaggedAllocator<char>::live_bytes[id] -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const TaggedAllocator<U>& other) const
+  {
+    return id == other.id;
+  }
+  template <typename U>
+  bool operator!=(const TaggedAllocator<U>& other) const
+  {
+    return id != other.id;
+  }
+};
+template <typename T>
+size_t TaggedAllocator<T>::live_bytes[2] = {0, 0};
+
+// 复制赋值后target改用source的分配器，移动赋值后节点连同分配器一起转移，内存都由分配它的分配器归还
+template <typename List>
+void check_assign_propagates_allocator()
+{
+  using tagged = TaggedAllocator<char>;
+  {
+    List source({"a", "b", "c"}, TaggedAllocator<std::string>(1));
+    List target{TaggedAllocator<std::string>(0)};
+    for (int i = 0; i < 100; ++i) {
+      target.push_back("target" + std::to_string(i));
+    }
+
+    target = source;
+    EXPECT_EQ(target.get_allocator().id, 1);
+    EXPECT_EQ(tagged::live_bytes[0], 0u);
+    EXPECT_EQ(target, source);
+
+    List moved{TaggedAllocator<std::string>(0)};
+    moved.push_back("moved");
+    moved = std::move(target);
+    EXPECT_EQ(moved.get_allocator().id, 1);
+    EXPECT_EQ(tagged::live_bytes[0], 0u);
+    EXPECT_EQ(moved, source);
+    moved.push_back("d");
+    EXPECT_EQ(moved.back(), "d");
+  }
+  EXPECT_EQ(tagged::live_bytes[0], 0u);
+  EXPECT_EQ(tagged::live_bytes[1], 0u);
+}
+
+// 测试赋值时按propagate_on_container_*传播分配器（普通模式和池化模式）
+TEST(ListTest, AssignPropagatesAllocator)
+{
+  check_assign_propagates_allocator<sjkxq_stl::list<std::string, TaggedAllocator<std::string>>>();
+  check_assign_propagates_allocator<sjkxq_stl::pooled_list<std::string, TaggedAllocator<std::string>>>();
+}
+
+// 测试使用NUMA分配器的节点池链表
+TEST(ListTest, NumaAllocator)
+{
+  using numa_list = sjkxq_stl::pooled_list<int, sjkxq_stl::numa_allocator<int>>;
+  numa_list lst{sjkxq_stl::numa_allocator<int>(sjkxq_stl::numa_policy::bind(0))};
+  for (int i = 0; i < 10000; ++i) {
+    lst.push_back(10000 - i);
+  }
+  lst.sort();
+  EXPECT_EQ(lst.front(), 1);
+  EXPECT_EQ(lst.back(), 10000);
+  EXPECT_EQ(lst.size(), 10000u);
+}
+
+// 测试线程缓存分配器：一个线程构造的节点在另一个线程释放
+TEST(ListTest, ThreadCacheAllocator)
+{
+  using cached_list = sjkxq_stl::list<std::string, sjkxq_stl::thread_cache_allocator<std::string>>;
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<sjkxq_stl::thread_cache_allocator<std::string>>);
+
+  std::mutex               mutex;
+  std::vector<cached_list> handoff;
+  std::atomic<bool>        done{false};
+  std::atomic<size_t>      consumed{0};
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < 4; ++t) {
+    producers.emplace_back([&]() {
+      for (int round = 0; round < 50; ++round) {
+        cached_list lst;
+        for (int i = 0; i < 200; ++i) {
+          lst.push_back(std::to_string(i));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        handoff.push_back(std::move(lst));
+      }
+    });
+  }
+  std::vector<std::thread> consumers;
+  for (int t = 0; t < 2; ++t) {
+    consumers.emplace_back([&]() {
+      for (;;) {
+        cached_list lst;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!handoff.empty()) {
+            lst = std::move(handoff.back());
+            handoff.pop_back();
+          } else if (done) {
+            return;
+          }
+        }
+        consumed += lst.size();
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  done = true;
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+  EXPECT_EQ(consumed, 4u * 50u * 200u);
+
+  // 同一线程中反复分配释放会复用相同的块
+  sjkxq_stl::thread_cache_allocator<long> alloc;
+  long* p = alloc.allocate(1);
+  alloc.deallocate(p, 1);
+  EXPECT_EQ(alloc.allocate(1), p);
+  alloc.deallocate(p, 1);
+  long* array = alloc.allocate(100);
+  array[99] = 1;
+  alloc.deallocate(array, 100);
+}
+
+// 测试线程缓存分配器：小于指针的类型按指针大小分块，只做释放的线程也能把块交还给分配方
+TEST(ListTest, ThreadCacheAllocatorSmallBlocks)
+{
+  sjkxq_stl::thread_cache_allocator<char> alloc;
+  std::vector<char*>                      blocks;
+  for (int i = 0; i < 1000; ++i) {
+    blocks.push_back(alloc.allocate(1));
+    *blocks.back() = static_cast<char>(i);
+  }
+  for (size_t i = 1; i < blocks.size(); ++i) {
+    EXPECT_NE(blocks[i], blocks[i - 1]);
+  }
+  std::thread([&]() {
+    for (char* p : blocks) {
+      alloc.deallocate(p, 1);
+    }
+  }).join();
+  for (int i = 0; i < 1000; ++i) {
+    char* p = alloc.allocate(1);
+    *p      = 'x';
+    alloc.deallocate(p, 1);
+  }
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <sjkxq_stl/map.hpp>
+#include <cstring>
+#include <new>
 #include <string>
+#include <utility>
 
 // 测试默认构造函数和基本操作
 TEST(MapTest, DefaultConstructor)
@@ -195,6 +198,29 @@ TEST(MapTest, MoveSemantics)
   EXPECT_TRUE(m2.empty());  // NOLINT - 访问移动后的对象是安全的
 }
 
+// 测试移动构造后头节点仍可识别：--end()和rbegin()指向最大元素，与目标内存原有的内容无关
+TEST(MapTest, MoveConstructIntoDirtyStorage)
+{
+  using map_type = sjkxq_stl::map<int, std::string>;
+  map_type source{{1, "one"}, {2, "two"}, {3, "three"}};
+
+  alignas(map_type) unsigned char storage[sizeof(map_type)];
+  std::memset(storage, 0xFF, sizeof(storage));
+  map_type* moved = ::new (static_cast<void*>(storage)) map_type(std::move(source));
+
+  EXPECT_EQ(moved->size(), 3);
+  EXPECT_EQ((--moved->end())->first, 3);
+  EXPECT_EQ(moved->rbegin()->first, 3);
+  EXPECT_EQ(moved->begin()->first, 1);
+
+  // 移动后的源对象为空树，同样要能正确插入和逆序遍历
+  source.insert({5, "five"});
+  source.insert({4, "four"});
+  EXPECT_EQ((--source.end())->first, 5);
+
+  moved->~map_type();
+}
+
 // 测试异常安全性
 TEST(MapTest, ExceptionSafety)
 {
@@ -207,4 +233,67 @@ TEST(MapTest, ExceptionSafety)
   EXPECT_EQ(m.size(), 2);
   EXPECT_EQ(m[1], "one");
   EXPECT_EQ(m[2], "two");
-}
\ No newline at end of file
+}
+
+// 测试try_emplace与insert_or_assign
+TEST(MapTest, TryEmplaceAndInsertOrAssign)
+{
+  sjkxq_stl::map<std::string, std::string> m;
+
+  std::string value = "first";
+  auto        r1    = m.try_emplace("a", std::move(value));
+  EXPECT_TRUE(r1.second);
+  EXPECT_EQ(r1.first->second, "first");
+
+  // 键已存在时参数不会被移动
+  std::string other = "second";
+  auto        r2    = m.try_emplace("a", std::move(other));
+  EXPECT_FALSE(r2.second);
+  EXPECT_EQ(other, "second");
+
+  auto it = m.try_emplace(m.end(), "b", "hinted");
+  EXPECT_EQ(it->second, "hinted");
+
+  auto r3 = m.insert_or_assign("a", "assigned");
+  EXPECT_FALSE(r3.second);
+  EXPECT_EQ(m["a"], "assigned");
+  EXPECT_EQ(m.size(), 2);
+}
+
+// 测试透明比较器的异构查找
+TEST(MapTest, TransparentLookup)
+{
+  sjkxq_stl::map<std::string, int, std::less<>> m{{"apple", 1}, {"banana", 2}};
+
+  EXPECT_TRUE(m.contains("apple"));
+  EXPECT_EQ(m.find("banana")->second, 2);
+  EXPECT_EQ(m.count("cherry"), 0);
+  EXPECT_EQ(m.lower_bound("b")->first, "banana");
+}
+
+// 可能抛出异常的比较器交换
+struct ThrowingSwapLess {
+  bool operator()(int a, int b) const { return a < b; }
+};
+
+void swap(ThrowingSwapLess&, ThrowingSwapLess&) noexcept(false) {}
+
+// 测试swap的异常规格跟随比较器
+TEST(MapTest, SwapNoexcept)
+{
+  static_assert(noexcept(std::declval<sjkxq_stl::map<int, int>&>().swap(
+                    std::declval<sjkxq_stl::map<int, int>&>())),
+                "swap with std::less must be noexcept");
+  using throwing_map = sjkxq_stl::map<int, int, ThrowingSwapLess>;
+  static_assert(!noexcept(std::declval<throwing_map&>().swap(std::declval<throwing_map&>())),
+                "swap must propagate a potentially throwing comparator swap");
+  static_assert(!noexcept(swap(std::declval<throwing_map&>(), std::declval<throwing_map&>())),
+                "free swap must follow the member swap");
+
+  throwing_map a{{1, 10}, {2, 20}};
+  throwing_map b{{3, 30}};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_EQ(a.begin()->first, 3);
+  EXPECT_EQ(b.size(), 2);
+}
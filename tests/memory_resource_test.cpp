@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include <sjkxq_stl/memory_resource.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pmr = sjkxq_stl::pmr;
+
+namespace
+{
+
+// 记录上游分配情况的内存资源
+class counting_resource : public pmr::memory_resource
+{
+public:
+  std::size_t allocations   = 0;
+  std::size_t deallocations = 0;
+  std::size_t live_bytes    = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocations;
+    live_bytes += bytes;
+    return pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+  {
+    ++deallocations;
+    live_bytes -= bytes;
+    pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+}  // namespace
+
+// 测试单调区域：容器从区域分配，区域析构时整体归还
+TEST(MemoryResourceTest, MonotonicArena)
+{
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<pmr::polymorphic_allocator<int>>);
+
+  counting_resource upstream;
+  {
+    pmr::monotonic_buffer_resource arena(4096, &upstream);
+    pmr::vector<int> vec(&arena);
+    pmr::list<std::string> lst(&arena);
+    pmr::unordered_set<int> set(16, std::hash<int>(), std::equal_to<int>(), &arena);
+    for (int i = 0; i < 1000; ++i) {
+      vec.push_back(i);
+      lst.push_back(std::to_string(i));
+      set.insert(i);
+    }
+    EXPECT_EQ(vec.get_allocator().resource(), &arena);
+    EXPECT_EQ(lst.size(), 1000u);
+    EXPECT_EQ(set.count(999), 1u);
+    EXPECT_GT(upstream.allocations, 0u);
+    EXPECT_EQ(upstream.deallocations, 0u);  // 容器释放内存是空操作
+  }
+  EXPECT_EQ(upstream.deallocations, upstream.allocations);
+  EXPECT_EQ(upstream.live_bytes, 0u);
+}
+
+// 测试元素本身是pmr容器时使用外层容器的资源
+TEST(MemoryResourceTest, NestedAllocator)
+{
+  pmr::monotonic_buffer_resource arena;
+  pmr::vector<std::pmr::string> strings(&arena);
+  strings.emplace_back("a fairly long string that does not fit in the small buffer");
+  strings.push_back(std::pmr::string("another long string that needs heap storage too"));
+  EXPECT_EQ(strings[0].get_allocator().resource(), &arena);
+  EXPECT_EQ(strings[1].get_allocator().resource(), &arena);
+
+  pmr::vector<pmr::vector<int>> nested(&arena);
+  nested.emplace_back();
+  nested[0].push_back(1);
+  EXPECT_EQ(nested[0].get_allocator().resource(), &arena);
+}
+
+// 测试不同资源的容器之间赋值和交换：分配器不传播，元素逐个移动或复制
+template <typename Container, typename Fill>
+void check_assignment(Fill fill)
+{
+  pmr::unsynchronized_pool_resource a;
+  pmr::unsynchronized_pool_resource b;
+  using allocator = typename Container::allocator_type;
+
+  Container source{allocator(&a)};
+  fill(source);
+  const Container expected(source);
+  EXPECT_EQ(expected.get_allocator().resource(), pmr::get_default_resource());
+
+  Container copy{allocator(&b)};
+  copy = source;
+  EXPECT_EQ(copy, expected);
+  EXPECT_EQ(copy.get_allocator().resource(), &b);
+
+  Container moved{allocator(&b)};
+  moved = std::move(source);
+  EXPECT_EQ(moved, expected);
+  EXPECT_EQ(moved.get_allocator().resource(), &b);
+
+  Container same{allocator(&b)};
+  same.swap(moved);
+  EXPECT_EQ(same, expected);
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ(moved.get_allocator().resource(), &b);
+
+  Container stolen{allocator(&b)};
+  stolen = std::move(same);
+  EXPECT_EQ(stolen, expected);
+}
+
+TEST(MemoryResourceTest, CrossResourceAssignment)
+{
+  check_assignment<pmr::vector<std::string>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.push_back(std::to_string(i));
+    }
+  });
+  check_assignment<pmr::small_vector<int, 4>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.push_back(i);
+    }
+  });
+  check_assignment<pmr::list<std::string>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.push_back(std::to_string(i));
+    }
+  });
+  check_assignment<pmr::pooled_list<int>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.push_back(i);
+    }
+  });
+  check_assignment<pmr::map<int, std::string>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c[i] = std::to_string(i);
+    }
+  });
+  check_assignment<pmr::set<int>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.insert(i);
+    }
+  });
+  check_assignment<pmr::unordered_map<int, std::string>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c[i] = std::to_string(i);
+    }
+  });
+  check_assignment<pmr::unordered_set<int>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.insert(i);
+    }
+  });
+  check_assignment<pmr::flat_hash_map<int, std::string>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c[i] = std::to_string(i);
+    }
+  });
+  check_assignment<pmr::flat_hash_set<int>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.insert(i);
+    }
+  });
+  check_assignment<pmr::btree_map<int, std::string>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c[i] = std::to_string(i);
+    }
+  });
+  check_assignment<pmr::btree_set<int>>([](auto& c) {
+    for (int i = 0; i < 100; ++i) {
+      c.insert(i);
+    }
+  });
+}
+
+// 测试同步池资源被多个线程上的容器同时使用
+TEST(MemoryResourceTest, SynchronizedPool)
+{
+  pmr::synchronized_pool_resource pool;
+  std::vector<std::thread> threads;
+  std::vector<std::size_t> sizes(4);
+  for (std::size_t t = 0; t < sizes.size(); ++t) {
+    threads.emplace_back([&pool, &sizes, t]() {
+      pmr::list<int> lst(&pool);
+      pmr::unordered_map<int, int> map(16, std::hash<int>(), std::equal_to<int>(), &pool);
+      for (int i = 0; i < 5000; ++i) {
+        lst.push_back(i);
+        map[i] = i;
+        if (i % 3 == 0) {
+          lst.pop_front();
+          map.erase(i / 2);
+        }
+      }
+      sizes[t] = lst.size();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (std::size_t size : sizes) {
+    EXPECT_EQ(size, 5000u - 1667u);
+  }
+}
+
+// 测试哈希容器的节点句柄随自己的分配器转移
+TEST(MemoryResourceTest, NodeHandle)
+{
+  pmr::unsynchronized_pool_resource pool;
+  pmr::unordered_set<std::string> set(16, std::hash<std::string>(), std::equal_to<std::string>(), &pool);
+  set.insert("alpha");
+  set.insert("beta");
+
+  auto node = set.extract("alpha");
+  ASSERT_FALSE(node.empty());
+  decltype(node) other;
+  other = std::move(node);
+  EXPECT_TRUE(node.empty());
+  EXPECT_EQ(other.value(), "alpha");
+  EXPECT_EQ(set.size(), 1u);
+}
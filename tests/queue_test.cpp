@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <sjkxq_stl/mpmc_queue.hpp>
 #include <sjkxq_stl/queue.hpp>
+#include <atomic>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 // 测试默认构造函数和基本操作
@@ -200,4 +205,158 @@ TEST(QueueTest, Comparison)
   EXPECT_FALSE(q1 <= q4);
   EXPECT_TRUE(q1 > q4);
   EXPECT_TRUE(q1 >= q4);
-}
\ No newline at end of file
+}
+
+// 测试无锁MPMC队列的单线程行为：容量取整、先进先出、满和空
+TEST(QueueTest, MpmcQueueBasic)
+{
+  EXPECT_THROW(sjkxq_stl::mpmc_queue<int>(0), std::invalid_argument);
+
+  sjkxq_stl::mpmc_queue<std::string> q(3);
+  EXPECT_EQ(q.capacity(), 4);
+  EXPECT_TRUE(q.empty());
+
+  std::string value;
+  EXPECT_FALSE(q.try_pop(value));
+
+  // 反复绕环，每个槽位都经过多轮写入和读出
+  for (int round = 0; round < 10; ++round) {
+    std::string a = "a" + std::to_string(round);
+    EXPECT_TRUE(q.try_push(a));
+    EXPECT_TRUE(q.try_push(std::string("b")));
+    EXPECT_TRUE(q.try_emplace(3, 'c'));
+    q.push("d");
+    EXPECT_EQ(q.size(), 4);
+
+    // 队列已满时失败，右值参数保持不变
+    std::string extra = "extra";
+    EXPECT_FALSE(q.try_push(std::move(extra)));
+    EXPECT_EQ(extra, "extra");
+
+    EXPECT_TRUE(q.try_pop(value));
+    EXPECT_EQ(value, a);
+    q.pop(value);
+    EXPECT_EQ(value, "b");
+    EXPECT_TRUE(q.try_pop(value));
+    EXPECT_EQ(value, "ccc");
+    EXPECT_TRUE(q.try_pop(value));
+    EXPECT_EQ(value, "d");
+    EXPECT_FALSE(q.try_pop(value));
+    EXPECT_TRUE(q.empty());
+  }
+
+  // 析构时销毁队列中剩余的元素
+  auto tracked = std::make_shared<int>(1);
+  {
+    sjkxq_stl::mpmc_queue<std::shared_ptr<int>> owners(8);
+    owners.push(tracked);
+    owners.push(tracked);
+    EXPECT_EQ(tracked.use_count(), 3);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+// 测试批量写入和读出
+TEST(QueueTest, MpmcQueueBatch)
+{
+  sjkxq_stl::mpmc_queue<int> q(8);
+  std::vector<int>           input = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+  // 只写入容量允许的部分
+  EXPECT_EQ(q.try_push_n(input.begin(), input.size()), 8);
+  EXPECT_EQ(q.try_push_n(input.begin(), input.size()), 0);
+
+  std::vector<int> output;
+  EXPECT_EQ(q.try_pop_n(std::back_inserter(output), 3), 3);
+  EXPECT_EQ(output, std::vector<int>({1, 2, 3}));
+
+  // 认领的连续槽位跨越环的末尾
+  EXPECT_EQ(q.try_push_n(input.begin() + 8, 2), 2);
+  EXPECT_EQ(q.try_pop_n(std::back_inserter(output), 100), 7);
+  EXPECT_EQ(output, input);
+  EXPECT_EQ(q.try_pop_n(std::back_inserter(output), 100), 0);
+
+  // 构造可能抛异常的元素逐个写入，移动迭代器仍批量写入
+  sjkxq_stl::mpmc_queue<std::string> strings(4);
+  std::vector<std::string>           words = {"one", "two", "three", "four", "five"};
+  EXPECT_EQ(strings.try_push_n(words.begin(), 2), 2);
+  EXPECT_EQ(strings.try_push_n(std::make_move_iterator(words.begin() + 2), 3), 2);
+  EXPECT_EQ(words[4], "five");
+
+  std::string read[4];
+  EXPECT_EQ(strings.try_pop_n(read, 4), 4);
+  EXPECT_EQ(read[0], "one");
+  EXPECT_EQ(read[3], "four");
+}
+
+// 测试多个生产者和多个消费者并发使用：每个元素恰好被取出一次
+TEST(QueueTest, MpmcQueueConcurrent)
+{
+  constexpr int producers    = 4;
+  constexpr int consumers    = 4;
+  constexpr int per_producer = 20000;
+  constexpr int batch        = 16;
+
+  sjkxq_stl::mpmc_queue<long> q(64);
+  std::atomic<long>           sum{0};
+  std::atomic<int>            popped{0};
+  std::vector<std::atomic<int>> seen(producers * per_producer);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&q, p]() {
+      const long base = static_cast<long>(p) * per_producer;
+      if (p % 2 == 0) {
+        for (long i = 0; i < per_producer; ++i) {
+          q.push(base + i);
+        }
+      } else {
+        std::vector<long> values(batch);
+        for (long i = 0; i < per_producer;) {
+          for (int k = 0; k < batch; ++k) {
+            values[k] = base + i + k;
+          }
+          const auto limit = static_cast<std::size_t>(std::min<long>(batch, per_producer - i));
+          const auto count = q.try_push_n(values.begin(), limit);
+          if (count == 0) {
+            std::this_thread::yield();
+          }
+          i += static_cast<long>(count);
+        }
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c]() {
+      long values[batch];
+      while (popped.load() < producers * per_producer) {
+        std::size_t count = 0;
+        if (c % 2 == 0) {
+          count = q.try_pop(values[0]) ? 1 : 0;
+        } else {
+          count = q.try_pop_n(values, batch);
+        }
+        if (count == 0) {
+          std::this_thread::yield();
+          continue;
+        }
+        for (std::size_t k = 0; k < count; ++k) {
+          sum += values[k];
+          seen[values[k]].fetch_add(1);
+        }
+        popped += static_cast<int>(count);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  const long total = static_cast<long>(producers) * per_producer;
+  EXPECT_EQ(popped.load(), total);
+  EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+  for (const auto& count : seen) {
+    ASSERT_EQ(count.load(), 1);
+  }
+  EXPECT_TRUE(q.empty());
+}
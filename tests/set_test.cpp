@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <sjkxq_stl/set.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
 #include <string>
 
 // 测试默认构造函数和基本操作
@@ -202,6 +205,14 @@ TEST(SetTest, MoveSemantics)
   s3 = std::move(s2);
   EXPECT_EQ(s3.size(), 3);
   EXPECT_TRUE(s2.empty());  // NOLINT - 访问移动后的对象是安全的
+
+  // 移动构造和移动赋值后逆序访问仍指向最大元素
+  sjkxq_stl::set<int> s4(std::move(s3));
+  EXPECT_EQ(*--s4.end(), 30);
+  EXPECT_EQ(*s4.rbegin(), 30);
+  s3 = std::move(s4);
+  EXPECT_EQ(*--s3.end(), 30);
+  EXPECT_EQ(*s3.rbegin(), 30);
 }
 
 // 测试复杂类型
@@ -260,4 +271,49 @@ TEST(SetTest, Swap)
   EXPECT_EQ(s2.size(), 4);
   EXPECT_TRUE(s2.contains(4));
   EXPECT_TRUE(s2.contains(7));
-}
\ No newline at end of file
+}
+
+// 测试红黑树：随机插入删除后与std::set逐个比较，并检查拷贝、交换后的树结构
+TEST(SetTest, RandomizedAgainstStdSet)
+{
+  sjkxq_stl::set<int> s;
+  std::set<int>       expected;
+  std::mt19937        rng(12345);
+
+  for (int i = 0; i < 20000; ++i) {
+    int value = static_cast<int>(rng() % 2000);
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(s.erase(value), expected.erase(value));
+    } else {
+      EXPECT_EQ(s.insert(value).second, expected.insert(value).second);
+    }
+  }
+
+  ASSERT_EQ(s.size(), expected.size());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin()));
+  EXPECT_TRUE(std::equal(s.rbegin(), s.rend(), expected.rbegin()));
+
+  sjkxq_stl::set<int> copy(s);
+  EXPECT_EQ(copy, s);
+  copy.erase(copy.begin(), copy.find(*std::next(expected.begin(), 100)));
+  EXPECT_EQ(copy.size(), expected.size() - 100);
+
+  sjkxq_stl::set<int> other{-1};
+  other.swap(copy);
+  EXPECT_EQ(*other.begin(), *std::next(expected.begin(), 100));
+  EXPECT_EQ(*copy.begin(), -1);
+  copy.insert(-2);
+  EXPECT_EQ(*copy.begin(), -2);
+
+  // 带提示的有序插入
+  sjkxq_stl::set<int> hinted;
+  for (int value : expected) {
+    hinted.insert(hinted.end(), value);
+  }
+  EXPECT_EQ(hinted, s);
+
+  // 只有一个元素时，begin()前进一步应到达end()
+  sjkxq_stl::set<int> single{7};
+  EXPECT_EQ(std::next(single.begin()), single.end());
+  EXPECT_EQ(std::prev(single.end()), single.begin());
+}
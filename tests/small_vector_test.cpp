@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <sjkxq_stl/small_vector.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+// 测试内联存储：不超过N个元素时容量固定为N
+TEST(SmallVectorTest, InlineStorage)
+{
+  sjkxq_stl::small_vector<int, 8> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.capacity(), 8);
+
+  const int* inline_data = vec.data();
+  for (int i = 0; i < 8; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(vec.size(), 8);
+  EXPECT_EQ(vec.capacity(), 8);
+  EXPECT_EQ(vec.data(), inline_data);
+
+  // 内联缓冲区的数据位于对象内部
+  const char* self = reinterpret_cast<const char*>(&vec);
+  const char* data = reinterpret_cast<const char*>(vec.data());
+  EXPECT_TRUE(data >= self && data < self + sizeof(vec));
+}
+
+// 测试超出内联容量后转到堆上，shrink_to_fit后搬回内联缓冲区
+TEST(SmallVectorTest, SpillAndShrink)
+{
+  sjkxq_stl::small_vector<std::string, 4> vec{"a", "b", "c", "d"};
+  const std::string* inline_data = vec.data();
+
+  vec.push_back("e");
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_GT(vec.capacity(), 4);
+  EXPECT_NE(vec.data(), inline_data);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec[4], "e");
+
+  vec.insert(vec.begin(), "z");
+  EXPECT_EQ(vec.front(), "z");
+  vec.erase(vec.begin(), vec.begin() + 3);
+  EXPECT_EQ(vec.size(), 3);
+
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 4);
+  EXPECT_EQ(vec.data(), inline_data);
+  EXPECT_EQ(vec, (sjkxq_stl::small_vector<std::string, 4>{"c", "d", "e"}));
+}
+
+// 测试复制、移动和交换：内联状态下逐个移动元素，堆状态下直接转移内存
+TEST(SmallVectorTest, CopyMoveAndSwap)
+{
+  sjkxq_stl::small_vector<std::string, 2> small{"x"};
+  sjkxq_stl::small_vector<std::string, 2> large{"1", "2", "3"};
+
+  sjkxq_stl::small_vector<std::string, 2> copy(small);
+  EXPECT_EQ(copy, small);
+
+  const std::string* heap_data = large.data();
+  sjkxq_stl::small_vector<std::string, 2> moved(std::move(large));
+  EXPECT_EQ(moved.data(), heap_data);
+  EXPECT_TRUE(large.empty());
+  EXPECT_EQ(large.capacity(), 2);
+
+  sjkxq_stl::small_vector<std::string, 2> moved_small(std::move(small));
+  EXPECT_EQ(moved_small.size(), 1);
+  EXPECT_EQ(moved_small[0], "x");
+  EXPECT_TRUE(small.empty());
+
+  moved_small.swap(moved);
+  EXPECT_EQ(moved_small.size(), 3);
+  EXPECT_EQ(moved_small[2], "3");
+  EXPECT_EQ(moved.size(), 1);
+  EXPECT_EQ(moved[0], "x");
+
+  moved = moved_small;
+  EXPECT_EQ(moved, moved_small);
+  moved_small = std::move(copy);
+  EXPECT_EQ(moved_small.size(), 1);
+  EXPECT_EQ(moved_small[0], "x");
+}
+
+// 测试不可按字节搬迁的元素在内联缓冲区与堆之间的搬迁
+TEST(SmallVectorTest, NonTrivialElements)
+{
+  sjkxq_stl::small_vector<std::unique_ptr<int>, 3> vec;
+  for (int i = 0; i < 10; ++i) {
+    vec.emplace_back(new int(i));
+  }
+  vec.resize(2);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 3);
+  EXPECT_EQ(*vec[1], 1);
+
+  sjkxq_stl::small_vector<std::unique_ptr<int>, 3> other(std::move(vec));
+  EXPECT_EQ(*other[0], 0);
+  EXPECT_TRUE(vec.empty());
+}
@@ -2,6 +2,30 @@
 #include <sjkxq_stl/unordered_map.hpp>
 #include <string>
 
+namespace
+{
+
+// 记录复制次数的键
+struct CopyCountingKey {
+  static int copies;
+
+  int value;
+
+  explicit CopyCountingKey(int v) : value(v) {}
+  CopyCountingKey(const CopyCountingKey& other) : value(other.value) { ++copies; }
+  CopyCountingKey(CopyCountingKey&& other) noexcept : value(other.value) {}
+
+  bool operator==(const CopyCountingKey& other) const { return value == other.value; }
+};
+
+int CopyCountingKey::copies = 0;
+
+struct CopyCountingKeyHash {
+  size_t operator()(const CopyCountingKey& key) const { return std::hash<int>()(key.value); }
+};
+
+}  // namespace
+
 // 测试默认构造函数和基本操作
 TEST(UnorderedMapTest, DefaultConstructor)
 {
@@ -269,4 +293,89 @@ TEST(UnorderedMapTest, Swap)
   EXPECT_EQ(m2.size(), size2);
   EXPECT_TRUE(m1.contains(1));
   EXPECT_TRUE(m2.contains(3));
-}
\ No newline at end of file
+}
+
+// 测试try_emplace和insert_or_assign
+TEST(UnorderedMapTest, TryEmplaceAndInsertOrAssign)
+{
+  sjkxq_stl::unordered_map<std::string, std::string> m;
+
+  auto [it1, inserted1] = m.try_emplace("a", 3, 'x');
+  EXPECT_TRUE(inserted1);
+  EXPECT_EQ(it1->second, "xxx");
+
+  // 键已存在时不会移动参数
+  std::string value = "keep";
+  auto [it2, inserted2] = m.try_emplace("a", std::move(value));
+  EXPECT_FALSE(inserted2);
+  EXPECT_EQ(value, "keep");
+  EXPECT_EQ(it2->second, "xxx");
+
+  EXPECT_TRUE(m.insert_or_assign("a", "new").second == false);
+  EXPECT_EQ(m.at("a"), "new");
+  EXPECT_TRUE(m.insert_or_assign("b", "bee").second);
+  EXPECT_EQ(m.size(), 2);
+
+  // 值不同的map不相等
+  sjkxq_stl::unordered_map<std::string, std::string> other{{"a", "new"}, {"b", "other"}};
+  EXPECT_NE(m, other);
+  other["b"] = "bee";
+  EXPECT_EQ(m, other);
+}
+
+// 测试与unordered_set共用的哈希表核心：节点提取、合并和大规模rehash
+TEST(UnorderedMapTest, NativeHashtable)
+{
+  sjkxq_stl::unordered_map<int, std::string> m;
+  for (int i = 0; i < 10000; ++i) {
+    m.emplace(i * 4096, std::to_string(i));
+  }
+  EXPECT_EQ(m.size(), 10000);
+  EXPECT_LE(m.load_factor(), m.max_load_factor());
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(m.at(i * 4096), std::to_string(i));
+  }
+
+  auto node = m.extract(0);
+  EXPECT_FALSE(node.empty());
+  EXPECT_EQ(node.value().second, "0");
+  EXPECT_FALSE(m.contains(0));
+
+  sjkxq_stl::unordered_map<int, std::string> src{{1, "one"}, {4096, "dup"}};
+  m.merge(src);
+  EXPECT_EQ(m.at(1), "one");
+  EXPECT_EQ(m.at(4096), "1");
+  EXPECT_EQ(src.size(), 1);
+  EXPECT_EQ(src.at(4096), "dup");
+
+  // 通过迭代器修改值
+  for (auto& kv : m) {
+    kv.second += "!";
+  }
+  EXPECT_EQ(m.at(1), "one!");
+}
+
+// 测试合并和提取不复制键，指向元素的引用保持有效
+TEST(UnorderedMapTest, MergeAndExtractKeepElements)
+{
+  using counting_map = sjkxq_stl::unordered_map<CopyCountingKey, int, CopyCountingKeyHash>;
+  counting_map target;
+  counting_map source;
+  for (int i = 0; i < 100; ++i) {
+    target.try_emplace(CopyCountingKey(i), i);
+    source.try_emplace(CopyCountingKey(i + 50), -i);
+  }
+  int* value = &source.find(CopyCountingKey(120))->second;
+  CopyCountingKey::copies = 0;
+
+  target.merge(source);
+  EXPECT_EQ(CopyCountingKey::copies, 0);
+  EXPECT_EQ(target.size(), 150);
+  EXPECT_EQ(source.size(), 50);
+  EXPECT_EQ(&target.find(CopyCountingKey(120))->second, value);
+
+  auto node = target.extract(CopyCountingKey(120));
+  EXPECT_EQ(CopyCountingKey::copies, 0);
+  EXPECT_EQ(&node.value().second, value);
+  EXPECT_EQ(*value, -70);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include <sjkxq_stl/numa_allocator.hpp>
 #include <sjkxq_stl/unordered_set.hpp>
+#include <algorithm>
 #include <string>
 
 // 测试默认构造函数和基本操作
@@ -304,4 +306,413 @@ TEST(UnorderedSetTest, Emplace)
   auto it2 = s.emplace_hint(hint, "world");
   EXPECT_EQ(*it2, "world");
   EXPECT_EQ(s.size(), 2);
-}
\ No newline at end of file
+}
+
+// 测试merge操作
+TEST(UnorderedSetTest, Merge)
+{
+  sjkxq_stl::unordered_set<std::string> s1{"apple", "banana"};
+  sjkxq_stl::unordered_set<std::string> s2{"banana", "cherry", "date"};
+
+  s1.merge(s2);
+  EXPECT_EQ(s1.size(), 4);
+  EXPECT_TRUE(s1.contains("cherry"));
+  EXPECT_TRUE(s1.contains("date"));
+
+  // 重复的键保留在源容器中
+  EXPECT_EQ(s2.size(), 1);
+  EXPECT_TRUE(s2.contains("banana"));
+}
+
+// 带种子的哈希函数：不同种子对同一个键给出不同的哈希值
+struct SeededStringHash {
+  size_t seed = 0;
+
+  size_t operator()(const std::string& key) const
+  {
+    return std::hash<std::string>()(key) ^ (seed * 0x9e3779b97f4a7c15ull);
+  }
+};
+
+// 测试哈希函数有状态时的合并：节点要按本容器的哈希函数放入桶中
+TEST(UnorderedSetTest, MergeWithSeededHash)
+{
+  using seeded_set = sjkxq_stl::unordered_set<std::string, SeededStringHash>;
+  seeded_set target(16, SeededStringHash{1});
+  seeded_set source(16, SeededStringHash{2});
+  for (int i = 0; i < 100; ++i) {
+    source.insert(std::to_string(i));
+  }
+  target.insert("7");
+
+  target.merge(source);
+  EXPECT_EQ(target.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(target.contains(std::to_string(i)));
+  }
+  EXPECT_EQ(source.size(), 1);
+  EXPECT_TRUE(source.contains("7"));
+}
+
+// 测试桶下标策略
+TEST(UnorderedSetTest, BucketPolicy)
+{
+  // 默认策略：桶数为2的幂，步长为1024的整数键经过混合后不会挤在同一个桶里
+  sjkxq_stl::unordered_set<int> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i * 1024);
+  }
+  EXPECT_EQ(s.size(), 1000);
+  EXPECT_EQ(s.bucket_count() & (s.bucket_count() - 1), 0);
+  size_t longest = 0;
+  for (size_t b = 0; b < s.bucket_count(); ++b) {
+    longest = std::max(longest, s.bucket_size(b));
+  }
+  EXPECT_LT(longest, 16);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(s.contains(i * 1024));
+    EXPECT_LT(s.bucket(i * 1024), s.bucket_count());
+  }
+
+  // 素数策略：桶数取素数，rehash后元素仍然可以找到
+  sjkxq_stl::unordered_set<int,
+                           std::hash<int>,
+                           std::equal_to<int>,
+                           std::allocator<int>,
+                           sjkxq_stl::prime_bucket_policy>
+      p(16);
+  EXPECT_EQ(p.bucket_count(), 17);
+  for (int i = 0; i < 1000; ++i) {
+    p.insert(i);
+  }
+  p.rehash(5000);
+  EXPECT_EQ(p.bucket_count(), 8209);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(p.contains(i));
+    EXPECT_EQ(p.bucket(i), static_cast<size_t>(i) % p.bucket_count());
+  }
+  EXPECT_FALSE(p.contains(1000));
+}
+
+// 统计调用次数的哈希函数，用于验证节点缓存了哈希值
+struct CountingStringHash {
+  static size_t calls;
+  size_t operator()(const std::string& s) const
+  {
+    ++calls;
+    return std::hash<std::string>{}(s);
+  }
+};
+size_t CountingStringHash::calls = 0;
+
+// 同样计数，但通过特化关闭缓存
+struct UncachedStringHash : CountingStringHash {
+};
+
+namespace sjkxq_stl
+{
+template <>
+struct cache_hash_code<std::string, UncachedStringHash> : std::false_type {
+};
+}  // namespace sjkxq_stl
+
+// 测试节点缓存哈希值
+TEST(UnorderedSetTest, CachedHashCode)
+{
+  static_assert(!sjkxq_stl::cache_hash_code_v<int, std::hash<int>>, "");
+  static_assert(sjkxq_stl::cache_hash_code_v<std::string, std::hash<std::string>>, "");
+
+  // 每个键只在插入时计算一次哈希，多次扩容和rehash都不再调用哈希函数
+  sjkxq_stl::unordered_set<std::string, CountingStringHash> s;
+  CountingStringHash::calls = 0;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(std::to_string(i));
+  }
+  EXPECT_EQ(CountingStringHash::calls, 1000);
+  s.rehash(s.bucket_count() * 4);
+  EXPECT_EQ(CountingStringHash::calls, 1000);
+  // 通过迭代器删除和提取都不需要计算哈希（find本身计算一次）
+  s.erase(s.find("500"));
+  auto node = s.extract(s.find("501"));
+  EXPECT_EQ(CountingStringHash::calls, 1002);
+  EXPECT_EQ(node.value(), "501");
+  EXPECT_EQ(s.size(), 998);
+  EXPECT_FALSE(s.contains("500"));
+  EXPECT_FALSE(s.contains("501"));
+  EXPECT_TRUE(s.contains("502"));
+
+  // 特化为不缓存后，rehash需要重新计算每个键的哈希
+  sjkxq_stl::unordered_set<std::string, UncachedStringHash> u;
+  for (int i = 0; i < 100; ++i) {
+    u.insert(std::to_string(i));
+  }
+  CountingStringHash::calls = 0;
+  u.rehash(u.bucket_count() * 4);
+  EXPECT_EQ(CountingStringHash::calls, 100);
+  EXPECT_TRUE(u.contains("42"));
+  EXPECT_FALSE(u.contains("100"));
+}
+
+// 记录分配次数和未归还字节数的分配器
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  static size_t allocations;
+  static size_t live_bytes;
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    ++CountingAllocator<char>::allocations;
+    CountingAllocator<char>::live_bytes += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n)
+  {
+    CountingAllocator<char>::live_bytes -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>&) const
+  {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>&) const
+  {
+    return false;
+  }
+};
+template <typename T>
+size_t CountingAllocator<T>::allocations = 0;
+template <typename T>
+size_t CountingAllocator<T>::live_bytes = 0;
+
+// 测试节点内存池
+TEST(UnorderedSetTest, PooledNodes)
+{
+  using counter = CountingAllocator<char>;
+  using pooled_set =
+      sjkxq_stl::unordered_set<std::string, std::hash<std::string>, std::equal_to<std::string>,
+                               CountingAllocator<std::string>>;
+  {
+    pooled_set s(4096);
+    counter::allocations = 0;
+
+    // 节点从slab中切出，分配次数远少于元素个数
+    for (int i = 0; i < 1000; ++i) {
+      s.insert(std::to_string(i));
+    }
+    size_t after_insert = counter::allocations;
+    EXPECT_LT(after_insert, 20);
+
+    // 删除后再插入复用空闲链表中的节点，不再向分配器申请内存
+    for (int i = 0; i < 1000; i += 2) {
+      s.erase(std::to_string(i));
+    }
+    for (int i = 0; i < 500; ++i) {
+      s.insert("x" + std::to_string(i));
+    }
+    EXPECT_EQ(counter::allocations, after_insert);
+    EXPECT_EQ(s.size(), 1000);
+
+    // 提取出的节点单独持有所在的slab，可以在容器销毁后继续使用
+    pooled_set::node_type node;
+    {
+      pooled_set t{"kept", "other"};
+      node = t.extract("kept");
+      EXPECT_EQ(t.size(), 1);
+    }
+    EXPECT_EQ(node.value(), "kept");
+
+    // clear把slab整体归还，只留下桶数组
+    size_t node_bytes = counter::live_bytes;
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_LT(counter::live_bytes, node_bytes);
+    s.insert("again");
+    EXPECT_TRUE(s.contains("again"));
+  }
+  EXPECT_EQ(counter::live_bytes, 0);
+}
+
+// 带编号的有状态分配器，复制赋值时随容器传播，按编号记录未归还的字节数
+template <typename T>
+struct TaggedAllocator {
+  using value_type                             = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+
+  static size_t live_bytes[2];
+
+  int id = 0;
+
+  explicit TaggedAllocator(int i = 0) : id(i) {}
+  template <typename U>
+  TaggedAllocator(const TaggedAllocator<U>& other) : id(other.id)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    TaggedAllocator<char>::live_bytes[id] += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n)
+  {
+    TaggedAllocator<char>::live_bytes[id] -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const TaggedAllocator<U>& other) const
+  {
+    return id == other.id;
+  }
+  template <typename U>
+  bool operator!=(const TaggedAllocator<U>& other) const
+  {
+    return id != other.id;
+  }
+};
+template <typename T>
+size_t TaggedAllocator<T>::live_bytes[2] = {0, 0};
+
+// 测试复制赋值时传播分配器：原有内存全部用原来的分配器归还，新元素来自对方的分配器
+TEST(UnorderedSetTest, CopyAssignPropagatesAllocator)
+{
+  using tagged     = TaggedAllocator<char>;
+  using tagged_set = sjkxq_stl::unordered_set<std::string, std::hash<std::string>,
+                                              std::equal_to<std::string>, TaggedAllocator<std::string>>;
+  {
+    tagged_set source(8, std::hash<std::string>(), std::equal_to<std::string>(),
+                      TaggedAllocator<std::string>(1));
+    tagged_set target(8, std::hash<std::string>(), std::equal_to<std::string>(),
+                      TaggedAllocator<std::string>(0));
+    for (int i = 0; i < 100; ++i) {
+      source.insert("source" + std::to_string(i));
+      target.insert("target" + std::to_string(i));
+    }
+    const size_t source_bytes = tagged::live_bytes[1];
+
+    target = source;
+    EXPECT_EQ(target.get_allocator().id, 1);
+    EXPECT_EQ(tagged::live_bytes[0], 0);
+    EXPECT_GT(tagged::live_bytes[1], source_bytes);
+    EXPECT_EQ(target.size(), 100);
+    EXPECT_TRUE(target == source);
+
+    // 分配器相同时再次赋值，桶数组保留
+    target.insert("extra");
+    target = source;
+    EXPECT_EQ(target.size(), 100);
+    EXPECT_FALSE(target.contains("extra"));
+  }
+  EXPECT_EQ(TaggedAllocator<char>::live_bytes[0], 0);
+  EXPECT_EQ(TaggedAllocator<char>::live_bytes[1], 0);
+}
+
+// 测试带分配器的移动构造：分配器相等时接管节点，元素地址不变；不相等时逐个移动元素
+TEST(UnorderedSetTest, MoveConstructWithAllocator)
+{
+  using tagged     = TaggedAllocator<char>;
+  using tagged_set = sjkxq_stl::unordered_set<std::string, std::hash<std::string>,
+                                              std::equal_to<std::string>, TaggedAllocator<std::string>>;
+  {
+    tagged_set source(8, std::hash<std::string>(), std::equal_to<std::string>(),
+                      TaggedAllocator<std::string>(0));
+    for (int i = 0; i < 100; ++i) {
+      source.insert("source" + std::to_string(i));
+    }
+    const std::string* element = &*source.find("source42");
+    const size_t       bytes   = tagged::live_bytes[0];
+
+    tagged_set same(std::move(source), TaggedAllocator<std::string>(0));
+    EXPECT_EQ(same.size(), 100);
+    EXPECT_EQ(&*same.find("source42"), element);
+    EXPECT_EQ(tagged::live_bytes[0], bytes);
+    EXPECT_TRUE(source.empty());
+    source.insert("reused");
+    EXPECT_TRUE(source.contains("reused"));
+
+    tagged_set other(std::move(same), TaggedAllocator<std::string>(1));
+    EXPECT_EQ(other.get_allocator().id, 1);
+    EXPECT_EQ(other.size(), 100);
+    EXPECT_TRUE(other.contains("source42"));
+    EXPECT_NE(&*other.find("source42"), element);
+    EXPECT_TRUE(same.empty());
+  }
+  EXPECT_EQ(TaggedAllocator<char>::live_bytes[0], 0);
+  EXPECT_EQ(TaggedAllocator<char>::live_bytes[1], 0);
+}
+
+// 测试合并和提取转移节点：分配器相等时元素地址不变，源容器先销毁也不影响；分配器不相等时移动元素
+TEST(UnorderedSetTest, MergeTransfersNodes)
+{
+  using tagged_set = sjkxq_stl::unordered_set<std::string, std::hash<std::string>,
+                                              std::equal_to<std::string>, TaggedAllocator<std::string>>;
+  {
+    tagged_set target(8, std::hash<std::string>(), std::equal_to<std::string>(),
+                      TaggedAllocator<std::string>(0));
+    target.insert("shared");
+    const std::string* moved;
+    {
+      tagged_set source(8, std::hash<std::string>(), std::equal_to<std::string>(),
+                        TaggedAllocator<std::string>(0));
+      for (int i = 0; i < 100; ++i) {
+        source.insert("source" + std::to_string(i));
+      }
+      source.insert("shared");
+      moved = &*source.find("source42");
+
+      target.merge(source);
+      EXPECT_EQ(target.size(), 101);
+      EXPECT_EQ(source.size(), 1);
+      EXPECT_EQ(&*target.find("source42"), moved);
+    }
+    EXPECT_EQ(*moved, "source42");
+
+    // 转入的节点删除后进入本容器的空闲链表，提取出的节点保持原地址
+    target.erase("source1");
+    target.insert("reused");
+    const std::string* extracted = &*target.find("source7");
+    auto node = target.extract("source7");
+    target.clear();
+    EXPECT_EQ(&node.value(), extracted);
+    EXPECT_EQ(node.value(), "source7");
+
+    tagged_set other(8, std::hash<std::string>(), std::equal_to<std::string>(),
+                     TaggedAllocator<std::string>(1));
+    other.insert("other");
+    target.insert("target");
+    target.merge(other);
+    EXPECT_TRUE(target.contains("other"));
+    EXPECT_TRUE(other.empty());
+  }
+  EXPECT_EQ(TaggedAllocator<char>::live_bytes[0], 0);
+  EXPECT_EQ(TaggedAllocator<char>::live_bytes[1], 0);
+}
+
+// 测试使用NUMA分配器的哈希集合
+TEST(UnorderedSetTest, NumaAllocator)
+{
+  using numa_set = sjkxq_stl::unordered_set<int, std::hash<int>, std::equal_to<int>,
+                                            sjkxq_stl::numa_allocator<int>>;
+  numa_set set(16, std::hash<int>(), std::equal_to<int>(),
+               sjkxq_stl::numa_allocator<int>(sjkxq_stl::numa_policy::interleave(1)));
+  for (int i = 0; i < 10000; ++i) {
+    set.insert(i);
+  }
+  EXPECT_EQ(set.size(), 10000u);
+  EXPECT_EQ(set.count(1234), 1u);
+  set.erase(1234);
+  EXPECT_EQ(set.count(1234), 0u);
+}
@@ -1,6 +1,22 @@
 #include <gtest/gtest.h>
+#include <sjkxq_stl/malloc_allocator.hpp>
+#include <sjkxq_stl/mmap_allocator.hpp>
+#include <sjkxq_stl/numa_allocator.hpp>
 #include <sjkxq_stl/vector.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 // 测试默认构造函数和基本操作
 TEST(VectorTest, DefaultConstructor)
@@ -170,4 +186,540 @@ TEST(VectorTest, ExceptionSafety)
   for (int i = 0; i < 5; ++i) {
     EXPECT_EQ(vec[i], i);
   }
-}
\ No newline at end of file
+}
+
+// 测试可平凡复制类型的批量搬迁路径
+TEST(VectorTest, TrivialRelocation)
+{
+  struct Record {
+    int    id;
+    double weight;
+  };
+
+  sjkxq_stl::vector<Record> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back({i, i * 0.5});
+  }
+
+  // 中间插入（有足够容量）与触发扩容的插入
+  vec.reserve(vec.size() + 1);
+  vec.insert(vec.begin() + 10, Record{-1, 0.0});
+  vec.insert(vec.begin() + 20, 50, Record{-2, 0.0});
+  vec.emplace(vec.begin(), Record{-3, 0.0});
+  EXPECT_EQ(vec.size(), 152);
+  EXPECT_EQ(vec[0].id, -3);
+  EXPECT_EQ(vec[11].id, -1);
+  EXPECT_EQ(vec[21].id, -2);
+  EXPECT_EQ(vec[70].id, -2);
+  EXPECT_EQ(vec[71].id, 19);
+
+  // 删除后元素应当前移
+  vec.erase(vec.begin() + 21, vec.begin() + 71);
+  vec.erase(vec.begin() + 11);
+  vec.erase(vec.begin());
+  ASSERT_EQ(vec.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(vec[i].id, i);
+  }
+
+  vec.resize(10);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 10);
+  EXPECT_EQ(vec[9].id, 9);
+}
+
+// 测试非平凡类型在插入、删除中的元素搬迁
+TEST(VectorTest, NonTrivialRelocation)
+{
+  sjkxq_stl::vector<std::string> vec{"a", "b", "c", "d"};
+  vec.shrink_to_fit();
+
+  vec.insert(vec.begin() + 1, "x");  // 触发扩容
+  vec.insert(vec.begin() + 3, 2, "y");
+  vec.emplace(vec.end(), 3, 'z');
+  EXPECT_EQ(vec, (sjkxq_stl::vector<std::string>{"a", "x", "b", "y", "y", "c", "d", "zzz"}));
+
+  vec.erase(vec.begin() + 3, vec.begin() + 5);
+  vec.erase(vec.begin() + 1);
+  EXPECT_EQ(vec, (sjkxq_stl::vector<std::string>{"a", "b", "c", "d", "zzz"}));
+}
+
+// 测试插入容器自身元素时的别名安全
+TEST(VectorTest, InsertSelfElement)
+{
+  sjkxq_stl::vector<int> vec{1, 2, 3};
+  vec.reserve(10);
+  vec.insert(vec.begin(), vec[2]);
+  vec.insert(vec.begin(), 2, vec[1]);
+  EXPECT_EQ(vec, (sjkxq_stl::vector<int>{1, 1, 3, 1, 2, 3}));
+
+  sjkxq_stl::vector<std::string> strs{"first", "second"};
+  strs.reserve(10);
+  strs.emplace(strs.begin(), strs[1]);
+  EXPECT_EQ(strs, (sjkxq_stl::vector<std::string>{"second", "first", "second"}));
+}
+
+// 测试容量已满时在末尾追加容器自身的元素：新元素在释放旧内存之前构造
+TEST(VectorTest, AppendSelfElementAtCapacity)
+{
+  const std::string long_text(64, 'x');  // 超出短字符串优化，元素内容在堆上
+  sjkxq_stl::vector<std::string> strs{long_text, "b"};
+  strs.shrink_to_fit();
+  ASSERT_EQ(strs.size(), strs.capacity());
+  strs.push_back(strs[0]);
+  strs.shrink_to_fit();
+  strs.emplace_back(strs.front());
+  strs.shrink_to_fit();
+  strs.push_back(std::move(strs[1]));
+  EXPECT_EQ(strs.size(), 5);
+  EXPECT_EQ(strs[2], long_text);
+  EXPECT_EQ(strs[3], long_text);
+  EXPECT_EQ(strs[4], "b");
+
+  sjkxq_stl::vector<int> ints{7};
+  for (int i = 0; i < 10; ++i) {
+    ints.shrink_to_fit();
+    ints.push_back(ints.back());
+  }
+  EXPECT_EQ(ints, sjkxq_stl::vector<int>(11, 7));
+}
+
+// 测试可平凡搬迁特性及其在扩容、插入、删除中的使用
+TEST(VectorTest, TriviallyRelocatable)
+{
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<int>);
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<std::unique_ptr<int>>);
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<sjkxq_stl::vector<std::string>>);
+  // 只保存配置的分配器可平凡复制，不需要特化即可按字节搬迁
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<sjkxq_stl::malloc_allocator<int>>);
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<sjkxq_stl::mmap_allocator<int>>);
+  static_assert(sjkxq_stl::is_trivially_relocatable_v<sjkxq_stl::numa_allocator<int>>);
+
+  sjkxq_stl::vector<std::unique_ptr<int>> ptrs;
+  for (int i = 0; i < 40; ++i) {
+    ptrs.push_back(std::make_unique<int>(i));
+  }
+  ptrs.insert(ptrs.begin() + 5, std::make_unique<int>(-1));
+  ptrs.erase(ptrs.begin(), ptrs.begin() + 5);
+  ptrs.erase(ptrs.begin());
+  ASSERT_EQ(ptrs.size(), 35);
+  for (int i = 0; i < 35; ++i) {
+    EXPECT_EQ(*ptrs[i], i + 5);
+  }
+
+  sjkxq_stl::vector<sjkxq_stl::vector<int>> nested;
+  for (int i = 0; i < 40; ++i) {
+    nested.push_back(sjkxq_stl::vector<int>(3, i));
+  }
+  nested.emplace(nested.begin(), 2, -1);
+  EXPECT_EQ(nested.size(), 41);
+  EXPECT_EQ(nested[0], (sjkxq_stl::vector<int>{-1, -1}));
+  EXPECT_EQ(nested[40], (sjkxq_stl::vector<int>{39, 39, 39}));
+}
+
+// 测试增长策略：默认策略保持原有行为，其余策略按各自规则扩容
+TEST(VectorTest, GrowthPolicy)
+{
+  sjkxq_stl::vector<int> def;
+  def.push_back(1);
+  EXPECT_EQ(def.capacity(), 16);
+  def.resize(16);
+  def.push_back(2);
+  EXPECT_EQ(def.capacity(), 32);
+
+  sjkxq_stl::vector<int, std::allocator<int>, 0, sjkxq_stl::half_growth> half;
+  half.reserve(10);
+  half.resize(10);
+  half.push_back(1);
+  EXPECT_EQ(half.capacity(), 15);
+
+  sjkxq_stl::vector<int, std::allocator<int>, 0, sjkxq_stl::exact_growth> exact;
+  for (int i = 0; i < 5; ++i) {
+    exact.push_back(i);
+    EXPECT_EQ(exact.capacity(), exact.size());
+  }
+  exact.insert(exact.end(), 3, 7);
+  EXPECT_EQ(exact.capacity(), 8);
+
+  sjkxq_stl::vector<double, std::allocator<double>, 0, sjkxq_stl::page_aligned_growth> paged;
+  paged.push_back(1.0);
+  EXPECT_EQ(paged.capacity() * sizeof(double), 4096);
+  paged.resize(paged.capacity());
+  paged.push_back(2.0);
+  EXPECT_EQ(paged.capacity() * sizeof(double) % 4096, 0);
+  EXPECT_GT(paged.capacity(), 512);
+
+  sjkxq_stl::vector<char, std::allocator<char>, 0, sjkxq_stl::page_aligned_growth> huge;
+  huge.reserve(3u << 20);
+  huge.resize(huge.capacity());
+  huge.push_back('x');
+  EXPECT_EQ(huge.capacity() % (2u << 20), 0);
+  EXPECT_EQ(huge[0], '\0');
+}
+
+// 测试mmap分配器：保留区内扩容时原地提交页面，不搬迁元素
+TEST(VectorTest, MmapAllocator)
+{
+  static_assert(sjkxq_stl::allocator_has_expand<sjkxq_stl::mmap_allocator<int>>::value);
+  static_assert(!sjkxq_stl::allocator_has_expand<std::allocator<int>>::value);
+
+  using mmap_vector = sjkxq_stl::vector<int, sjkxq_stl::mmap_allocator<int>>;
+  mmap_vector vec(sjkxq_stl::mmap_allocator<int>(64u << 20));
+  vec.push_back(0);
+  const int* first = vec.data();
+  for (int i = 1; i < (1 << 20); ++i) {
+    vec.push_back(i);
+  }
+  ASSERT_EQ(vec.size(), 1u << 20);
+#if defined(SJKXQ_STL_HAS_MMAP)
+  EXPECT_EQ(vec.data(), first);
+#endif
+  EXPECT_EQ(vec[12345], 12345);
+
+  // 超出保留区后退回到分配新内存再搬迁
+  vec.reserve((64u << 20) / sizeof(int) + 1);
+  EXPECT_EQ(vec.back(), (1 << 20) - 1);
+
+  // 中间插入、复制和大页模式
+  vec.insert(vec.begin(), -1);
+  EXPECT_EQ(vec[1], 0);
+  mmap_vector copy(vec);
+  EXPECT_EQ(copy, vec);
+
+  sjkxq_stl::vector<char, sjkxq_stl::mmap_allocator<char>> huge(sjkxq_stl::mmap_allocator<char>(8u << 20, true));
+  huge.resize(5u << 20, 'x');
+  EXPECT_EQ(huge[(5u << 20) - 1], 'x');
+}
+
+// 测试reallocate扩容：元素可按字节搬迁时由分配器调整块的大小，内容保持不变
+TEST(VectorTest, ReallocateHook)
+{
+  static_assert(sjkxq_stl::allocator_has_reallocate<sjkxq_stl::malloc_allocator<int>>::value);
+  static_assert(sjkxq_stl::allocator_has_reallocate<sjkxq_stl::mmap_allocator<int>>::value);
+  static_assert(!sjkxq_stl::allocator_has_reallocate<std::allocator<int>>::value);
+
+  sjkxq_stl::vector<long, sjkxq_stl::malloc_allocator<long>> longs;
+  for (long i = 0; i < 100000; ++i) {
+    longs.push_back(i * 3);
+  }
+  for (long i = 0; i < 100000; i += 997) {
+    EXPECT_EQ(longs[i], i * 3);
+  }
+
+  sjkxq_stl::vector<std::unique_ptr<int>, sjkxq_stl::malloc_allocator<std::unique_ptr<int>>> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(std::make_unique<int>(i));
+  }
+  EXPECT_EQ(*ptrs[99], 99);
+
+  // 保留区很小，扩容超出保留区时整体移动已提交的页面
+  sjkxq_stl::vector<int, sjkxq_stl::mmap_allocator<int>> mapped(sjkxq_stl::mmap_allocator<int>(4096));
+  for (int i = 0; i < 300000; ++i) {
+    mapped.push_back(i);
+  }
+  for (int i = 0; i < 300000; i += 1009) {
+    EXPECT_EQ(mapped[i], i);
+  }
+  mapped.shrink_to_fit();
+  EXPECT_EQ(mapped.back(), 299999);
+}
+
+// 测试默认初始化的resize和reserve_and_append
+TEST(VectorTest, DefaultInitAppend)
+{
+  sjkxq_stl::vector<char> buffer;
+  buffer.resize_default_init(1000);
+  EXPECT_EQ(buffer.size(), 1000);
+  std::memset(buffer.data(), 'a', buffer.size());
+  buffer.resize_default_init(10);
+  EXPECT_EQ(buffer.size(), 10);
+  EXPECT_EQ(buffer.back(), 'a');
+
+  // writer只写入了请求数量的一部分
+  std::size_t written = buffer.reserve_and_append(100, [](char* dest, std::size_t n) {
+    EXPECT_EQ(n, 100);
+    std::memcpy(dest, "hello", 5);
+    return std::size_t(5);
+  });
+  EXPECT_EQ(written, 5);
+  EXPECT_EQ(buffer.size(), 15);
+  EXPECT_EQ(std::string(buffer.data() + 10, 5), "hello");
+
+  // writer抛出异常时内容保持不变
+  EXPECT_THROW(buffer.reserve_and_append(5, [](char*, std::size_t) -> std::size_t { throw 1; }), int);
+  EXPECT_EQ(buffer.size(), 15);
+
+  // 非平凡类型仍按默认构造
+  sjkxq_stl::vector<std::string> strings{"x"};
+  strings.resize_default_init(3);
+  EXPECT_EQ(strings[0], "x");
+  EXPECT_TRUE(strings[2].empty());
+  strings.reserve_and_append(4, [](std::string* dest, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      dest[i] = std::to_string(i);
+    }
+    return n - 1;
+  });
+  EXPECT_EQ(strings.size(), 6);
+  EXPECT_EQ(strings[5], "2");
+}
+
+// 测试批量追加：append_range和基于生成器的append
+TEST(VectorTest, AppendRange)
+{
+  sjkxq_stl::vector<int> vec{1, 2};
+  int raw[] = {3, 4, 5};
+  vec.append_range(raw);
+  std::vector<int> std_vec{6, 7};
+  vec.append_range(std_vec);
+  std::list<int> std_list{8, 9};
+  vec.append_range(std_list);
+  EXPECT_EQ(vec, (sjkxq_stl::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  // 追加自身：扩容时旧元素在新元素构造完成后才释放
+  vec.shrink_to_fit();
+  vec.append_range(vec);
+  EXPECT_EQ(vec.size(), 18);
+  EXPECT_EQ(vec[9], 1);
+  EXPECT_EQ(vec[17], 9);
+
+  // 单遍的输入范围逐个追加
+  std::istringstream input("10 20 30");
+  struct input_range
+  {
+    std::istream_iterator<int> first, last;
+    std::istream_iterator<int> begin() const { return first; }
+    std::istream_iterator<int> end() const { return last; }
+  };
+  vec.append_range(input_range{std::istream_iterator<int>(input), std::istream_iterator<int>()});
+  EXPECT_EQ(vec.size(), 21);
+  EXPECT_EQ(vec.back(), 30);
+
+  sjkxq_stl::vector<std::string> strings{"a"};
+  strings.append_range(std::vector<std::string>{"b", "c"});
+  strings.append_range(strings);
+  EXPECT_EQ(strings, (sjkxq_stl::vector<std::string>{"a", "b", "c", "a", "b", "c"}));
+  std::deque<std::string> sized{"d"};
+  strings.append_range(sized);
+  std::forward_list<std::string> unsized{"e", "f"};  // 没有size()，由std::distance计数
+  strings.append_range(unsized);
+  EXPECT_EQ(strings.size(), 9);
+  EXPECT_EQ(strings.back(), "f");
+
+  int next = 0;
+  sjkxq_stl::vector<int> generated;
+  generated.append(5, [&next] { return next++ * 10; });
+  EXPECT_EQ(generated, (sjkxq_stl::vector<int>{0, 10, 20, 30, 40}));
+  EXPECT_GE(generated.capacity(), 5);
+
+  int calls = 0;
+  EXPECT_THROW(strings.append(4, [&calls]() -> std::string {
+    if (++calls == 3) {
+      throw std::runtime_error("generator failed");
+    }
+    return "g";
+  }), std::runtime_error);
+  EXPECT_EQ(strings.size(), 9);
+}
+
+// 测试无序删除和批量条件删除
+TEST(VectorTest, UnorderedEraseAndEraseIf)
+{
+  sjkxq_stl::vector<int> vec{0, 1, 2, 3, 4};
+  auto it = vec.unordered_erase(vec.begin() + 1);
+  EXPECT_EQ(*it, 4);
+  EXPECT_EQ(vec, (sjkxq_stl::vector<int>{0, 4, 2, 3}));
+  it = vec.unordered_erase(vec.end() - 1);
+  EXPECT_EQ(it, vec.end());
+  EXPECT_EQ(vec, (sjkxq_stl::vector<int>{0, 4, 2}));
+  EXPECT_THROW(vec.unordered_erase(vec.end()), std::out_of_range);
+
+  sjkxq_stl::vector<std::string> strings{"a", "bb", "c", "dd", "e"};
+  strings.unordered_erase(strings.begin());
+  EXPECT_EQ(strings, (sjkxq_stl::vector<std::string>{"e", "bb", "c", "dd"}));
+
+  sjkxq_stl::vector<std::unique_ptr<int>> ptrs;
+  for (int i = 0; i < 10; ++i) {
+    ptrs.push_back(std::make_unique<int>(i));
+  }
+  ptrs.unordered_erase(ptrs.begin() + 2);
+  EXPECT_EQ(*ptrs[2], 9);
+  EXPECT_EQ(ptrs.size(), 9);
+
+  EXPECT_EQ(sjkxq_stl::erase_if(strings, [](const std::string& s) { return s.size() == 2; }), 2);
+  EXPECT_EQ(strings, (sjkxq_stl::vector<std::string>{"e", "c"}));
+
+  sjkxq_stl::vector<int> numbers{1, 2, 1, 3, 1};
+  EXPECT_EQ(sjkxq_stl::erase(numbers, 1), 3);
+  EXPECT_EQ(numbers, (sjkxq_stl::vector<int>{2, 3}));
+  EXPECT_EQ(sjkxq_stl::erase_if(numbers, [](int) { return false; }), 0);
+}
+
+// 测试算术类型的相等与字典序比较
+TEST(VectorTest, ArithmeticComparison)
+{
+  sjkxq_stl::vector<int> a(1000, 7);
+  sjkxq_stl::vector<int> b(1000, 7);
+  EXPECT_TRUE(a == b);
+  b[997] = -1;
+  EXPECT_FALSE(a == b);
+  EXPECT_TRUE(b < a);  // 负数在字节上较大，但按值比较更小
+  EXPECT_TRUE(a > b);
+  b[997] = 7;
+  b.push_back(0);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(sjkxq_stl::vector<int>{} < b);
+  EXPECT_TRUE(sjkxq_stl::vector<int>{} == sjkxq_stl::vector<int>{});
+
+  // +0.0与-0.0相等，NaN与自身不相等
+  sjkxq_stl::vector<double> x(100, 1.0);
+  sjkxq_stl::vector<double> y(100, 1.0);
+  x[10] = 0.0;
+  y[10] = -0.0;
+  EXPECT_TRUE(x == y);
+  EXPECT_FALSE(x < y);
+  EXPECT_FALSE(y < x);
+  y[50] = 0.5;
+  EXPECT_TRUE(y < x);
+  x[3] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(x == x);
+
+  sjkxq_stl::vector<unsigned char> u{1, 2, 200};
+  sjkxq_stl::vector<unsigned char> v{1, 2, 3, 4};
+  EXPECT_TRUE(v < u);
+  EXPECT_TRUE(u >= v);
+
+  // 与标准库的结果逐一比对
+  unsigned seed = 12345;
+  auto next = [&seed]() { return seed = seed * 1103515245u + 12345u; };
+  for (int round = 0; round < 200; ++round) {
+    sjkxq_stl::vector<short> p(next() % 80);
+    for (auto& e : p) {
+      e = static_cast<short>(next() % 5) - 2;
+    }
+    sjkxq_stl::vector<short> q(p);
+    if (!q.empty()) {
+      q[next() % q.size()] = static_cast<short>(next() % 5) - 2;
+    }
+    if (next() % 3 == 0) {
+      q.push_back(0);
+    }
+    EXPECT_EQ(p < q, std::lexicographical_compare(p.begin(), p.end(), q.begin(), q.end()));
+    EXPECT_EQ(q < p, std::lexicographical_compare(q.begin(), q.end(), p.begin(), p.end()));
+    EXPECT_EQ(p == q, std::equal(p.begin(), p.end(), q.begin(), q.end()));
+  }
+}
+
+// 测试并行构造、赋值和调整大小
+TEST(VectorTest, ParallelConstruction)
+{
+  // 每块至少1个字节，使小数据量也能分到多个线程上
+  const sjkxq_stl::parallel_policy policy{4, 1};
+  EXPECT_EQ(policy.chunk_count(1000, sizeof(int)), 4);
+  EXPECT_EQ(policy.chunk_count(3, sizeof(int)), 3);
+  EXPECT_EQ(sjkxq_stl::par.chunk_count(100, sizeof(int)), 1);
+
+  sjkxq_stl::vector<int> filled(policy, 1001, 7);
+  EXPECT_EQ(filled.size(), 1001);
+  EXPECT_EQ(std::count(filled.begin(), filled.end(), 7), 1001);
+
+  sjkxq_stl::vector<std::string> strings(policy, 999);
+  EXPECT_EQ(std::count(strings.begin(), strings.end(), ""), 999);
+
+  for (size_t i = 0; i < filled.size(); ++i) {
+    filled[i] = static_cast<int>(i);
+  }
+  sjkxq_stl::vector<int> copy(policy, filled);
+  EXPECT_EQ(copy, filled);
+
+  copy.assign(policy, 10, -1);
+  EXPECT_EQ(copy, (sjkxq_stl::vector<int>(10, -1)));
+  copy.resize(policy, 500, 3);
+  EXPECT_EQ(copy.size(), 500);
+  EXPECT_EQ(copy[9], -1);
+  EXPECT_EQ(std::count(copy.begin(), copy.end(), 3), 490);
+  copy.resize(policy, 5);
+  EXPECT_EQ(copy, (sjkxq_stl::vector<int>(5, -1)));
+  copy.resize(policy, 8);
+  EXPECT_EQ(copy[7], 0);
+
+  sjkxq_stl::vector<int> empty(sjkxq_stl::par, 0, 1);
+  EXPECT_TRUE(empty.empty());
+
+  // 某个线程构造失败时，所有已构造的元素都被销毁
+  struct Tracked
+  {
+    static std::atomic<int>& live()
+    {
+      static std::atomic<int> count{0};
+      return count;
+    }
+    static std::atomic<int>& budget()
+    {
+      static std::atomic<int> count{0};
+      return count;
+    }
+    Tracked()
+    {
+      if (--budget() < 0) {
+        throw std::runtime_error("construction failed");
+      }
+      ++live();
+    }
+    Tracked(const Tracked&) : Tracked() {}
+    ~Tracked() { --live(); }
+  };
+  Tracked::budget() = 700;
+  EXPECT_THROW(sjkxq_stl::vector<Tracked>(policy, 1000), std::runtime_error);
+  EXPECT_EQ(Tracked::live(), 0);
+
+  Tracked::budget() = 100;
+  sjkxq_stl::vector<Tracked> tracked(policy, 50);
+  EXPECT_THROW(tracked.resize(policy, 200), std::runtime_error);
+  EXPECT_EQ(tracked.size(), 50);
+  EXPECT_EQ(Tracked::live(), 50);
+}
+
+// 测试按NUMA策略放置内存的分配器
+TEST(VectorTest, NumaAllocator)
+{
+  using numa_vector = sjkxq_stl::vector<int, sjkxq_stl::numa_allocator<int>>;
+  const auto policy = sjkxq_stl::numa_policy::bind(0);
+
+  numa_vector vec{sjkxq_stl::numa_allocator<int>(policy)};
+  for (int i = 0; i < 100000; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(vec[99999], 99999);
+  EXPECT_EQ(vec.get_allocator().policy(), policy);
+
+  numa_vector copy(vec);
+  EXPECT_EQ(copy, vec);
+  EXPECT_EQ(copy.get_allocator(), vec.get_allocator());
+  copy.shrink_to_fit();
+  copy.resize(3);
+  copy.shrink_to_fit();  // 小于一页的分配来自operator new
+  EXPECT_EQ(copy, (numa_vector{0, 1, 2}));
+
+  sjkxq_stl::numa_allocator<double> interleaved(sjkxq_stl::numa_policy::interleave(1));
+  EXPECT_NE(sjkxq_stl::numa_allocator<int>(interleaved), vec.get_allocator());
+
+#if defined(SJKXQ_STL_HAS_NUMA)
+  // 内核支持NUMA策略时，页面应落在节点0上
+  int node = -1;
+  if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, static_cast<void*>(vec.data()), 3) == 0) {
+    EXPECT_EQ(node, 0);
+  }
+#endif
+}
+
+// 测试NUMA节点编号的边界：只支持[0, 64)
+TEST(VectorTest, NumaPolicyNodeRange)
+{
+  EXPECT_EQ(sjkxq_stl::numa_policy::bind(0).nodes, 1u);
+  EXPECT_EQ(sjkxq_stl::numa_policy::preferred(63).nodes, std::uint64_t(1) << 63);
+  EXPECT_THROW(sjkxq_stl::numa_policy::bind(-1), std::invalid_argument);
+  EXPECT_THROW(sjkxq_stl::numa_policy::bind(64), std::invalid_argument);
+  EXPECT_THROW(sjkxq_stl::numa_policy::preferred(-1), std::invalid_argument);
+  EXPECT_THROW(sjkxq_stl::numa_policy::preferred(64), std::invalid_argument);
+}